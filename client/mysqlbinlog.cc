@@ -1359,6 +1359,33 @@ Exit_status process_event(PRINT_EVENT_INFO *print_event_info, Log_event *ev,
         destroy_evt= FALSE;
       break;
     }
+    case TRANSACTION_COMPRESSED_EVENT:
+    {
+      /*
+        Print the events of the transaction as if they had not been
+        compressed.
+      */
+      Transaction_compressed_log_event *tce=
+        (Transaction_compressed_log_event*) ev;
+      const char *errmsg;
+      uint32 ev_pos= 0;
+      Log_event *inner;
+      if (tce->print(result_file, print_event_info))
+        goto err;
+      while ((inner= tce->next_event(&ev_pos, opt_verify_binlog_checksum,
+                                     &errmsg)))
+      {
+        if ((retval= process_event(print_event_info, inner, pos, logname)) !=
+            OK_CONTINUE)
+          goto end;
+      }
+      if (errmsg)
+      {
+        error("%s", errmsg);
+        goto err;
+      }
+      break;
+    }
     case START_ENCRYPTION_EVENT:
       glob_description_event->start_decryption((Start_encryption_log_event*)ev);
       /* fall through */
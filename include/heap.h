@@ -110,6 +110,18 @@ typedef struct st_heap_block
 
 struct st_heap_info;			/* For reference */
 
+/*
+  Description of a BLOB/TEXT column. The record keeps the usual blob
+  length (packlength bytes) followed by a pointer to the data; the data
+  itself is kept in HP_SHARE::blob_block, see hp_blob.c
+*/
+
+typedef struct st_hp_blob_desc
+{
+  uint offset;				/* Offset of the blob in record */
+  uint packlength;			/* Bytes used to store the length */
+} HP_BLOB_DESC;
+
 typedef struct st_hp_keydef		/* Key definition with open */
 {
   uint flag;				/* HA_NOSAME | HA_NULL_PART_KEY */
@@ -134,7 +146,9 @@ typedef struct st_hp_keydef		/* Key definition with open */
 typedef struct st_heap_share
 {
   HP_BLOCK block;
+  HP_BLOCK blob_block;			/* Chunks holding the blob data */
   HP_KEYDEF  *keydef;
+  HP_BLOB_DESC *blob_descs;
   ulonglong data_length,index_length,max_table_size;
   ulonglong auto_increment;
   ulong min_records,max_records;	/* Params to open */
@@ -148,9 +162,12 @@ typedef struct st_heap_share
   uint visible;                         /* Offset to the visible/deleted mark */
   uint changed;
   uint keys,max_key_length;
+  uint blobs;				/* Number of blob columns */
   uint currently_disabled_keys;    /* saved value from "keys" when disabled */
   uint open_count;
   uchar *del_link;			/* Link to next block with del. rec */
+  uchar *blob_del_link;			/* First free run of blob chunks */
+  ulong blob_chunks;			/* Chunks taken from blob_block */
   char * name;			/* Name of "memory-file" */
   time_t create_time;
   THR_LOCK lock;
@@ -174,6 +191,9 @@ typedef struct st_heap_info
   uint opt_flag,update;
   uchar *lastkey;			/* Last used key with rkey */
   uchar *recbuf;                         /* Record buffer for rb-tree keys */
+  uchar **blob_ptrs;                     /* Blob data written by write/update */
+  uchar *blob_buff;                      /* Blobs of the last read record */
+  size_t blob_buff_length;
   enum ha_rkey_function last_find_flag;
   TREE_ELEMENT *parents[MAX_TREE_HEIGHT+1];
   TREE_ELEMENT **last_pos;
@@ -189,6 +209,8 @@ typedef struct st_heap_info
 typedef struct st_heap_create_info
 {
   HP_KEYDEF *keydef;
+  HP_BLOB_DESC *blob_descs;
+  uint blobs;
   uint auto_key;                        /* keynr [1 - maxkey] for auto key */
   uint auto_key_type;
   uint keys;
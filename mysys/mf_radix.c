@@ -58,3 +58,101 @@ void radixsort_for_str_ptr(uchar **base, uint number_of_elements, size_t size_of
   next:;
   }
 }
+
+
+/*
+  MSD radixsort for pointers to fixed length strings.
+
+  The pointers are distributed by the first byte of the strings, then
+  each bucket is sorted by the next byte, and so on. Unlike the LSD sort
+  above this touches only the bytes needed to tell the strings apart,
+  and the buckets get smaller and more cache resident with every byte.
+  Buckets smaller than MSD_RADIX_MIN_BUCKET are sorted by insertion on
+  the bytes that are left. The sort is stable.
+*/
+
+#define MSD_RADIX_MIN_BUCKET 32
+
+/* Stable, like the distribution passes */
+static void msd_insertion_sort(uchar **base, size_t number_of_elements,
+                               size_t pass, size_t size_of_element)
+{
+  uchar **end= base + number_of_elements, **ptr, **pos;
+  size_t length= size_of_element - pass;
+  for (ptr= base + 1; ptr < end; ptr++)
+  {
+    uchar *key= *ptr;
+    for (pos= ptr;
+         pos > base && memcmp(pos[-1] + pass, key + pass, length) > 0;
+         pos--)
+      *pos= pos[-1];
+    *pos= key;
+  }
+}
+
+
+static void msd_radixsort(uchar **base, size_t number_of_elements,
+                          size_t pass, size_t size_of_element,
+                          uchar **buffer, uint32 *count)
+{
+  uchar **end= base + number_of_elements, **ptr, **run;
+  uint32 *count_ptr, *count_end= count + 256, sum;
+
+  /* Skip the bytes that are equal in all strings */
+  for (;; pass++)
+  {
+    if (pass == size_of_element)
+      return;
+    if (number_of_elements < MSD_RADIX_MIN_BUCKET)
+    {
+      msd_insertion_sort(base, number_of_elements, pass, size_of_element);
+      return;
+    }
+    bzero((uchar*) count, sizeof(uint32)*256);
+    for (ptr= base; ptr < end; ptr++)
+      count[ptr[0][pass]]++;
+    if (count[base[0][pass]] != number_of_elements)
+      break;
+  }
+
+  for (count_ptr= count, sum= 0; count_ptr < count_end; count_ptr++)
+  {
+    uint32 tmp= *count_ptr;
+    *count_ptr= sum;
+    sum+= tmp;
+  }
+  for (ptr= base; ptr < end; ptr++)
+    buffer[count[ptr[0][pass]]++]= *ptr;
+  memcpy(base, buffer, number_of_elements * sizeof(uchar*));
+
+  if (++pass == size_of_element)
+    return;
+  /* The buckets are runs of equal bytes now, and count[] is free again */
+  for (ptr= base; ptr < end; ptr= run)
+  {
+    uchar byte= ptr[0][pass - 1];
+    for (run= ptr + 1; run < end && run[0][pass - 1] == byte; run++) ;
+    if (run - ptr > 1)
+      msd_radixsort(ptr, (size_t) (run - ptr), pass, size_of_element,
+                    buffer, count);
+  }
+}
+
+
+/*
+  The recursion goes one level deeper for every byte, so very long
+  strings are left to quicksort
+*/
+
+my_bool msd_radixsort_is_applicable(uint n_items, size_t size_of_element)
+{
+  return size_of_element > 0 && size_of_element <= 255 &&
+         n_items >= 1000;
+}
+
+void msd_radixsort_for_str_ptr(uchar **base, uint number_of_elements,
+                               size_t size_of_element, uchar **buffer)
+{
+  uint32 count[256];
+  msd_radixsort(base, number_of_elements, 0, size_of_element, buffer, count);
+}
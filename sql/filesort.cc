@@ -35,6 +35,10 @@
 #include "sql_select.h"
 #include "debug_sync.h"
 #include "sql_queue.h"
+#include "sql_parallel.h"
+#include "mysys_err.h"
+#include <algorithm>
+#include <atomic>
 
 static uint make_sortkey(Sort_param *, uchar *, uchar *, bool);
 
@@ -312,6 +316,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
     param.accepted_rows= &not_used;
 
   param.set_all_read_bits= filesort->set_all_read_bits;
+  param.max_sort_threads= (uint) thd->variables.filesort_threads;
   param.unpack= filesort->unpack;
 
   sort->addon_fields=  param.addon_fields;
@@ -558,6 +563,7 @@ SORT_INFO *filesort(THD *thd, TABLE *table, Filesort *filesort,
       outfile->end_of_file=save_pos;
     }
   }
+  tracker->report_sort_threads(param.used_sort_threads);
   tracker->report_merge_passes_at_end(thd, thd->query_plan_fsort_passes);
   if (unlikely(error))
   {
@@ -1018,7 +1024,7 @@ static ha_rows find_all_keys(THD *thd, Sort_param *param, SQL_SELECT *select,
       error= select->quick->get_next();
     else					/* Not quick-select */
     {
-      error= file->ha_rnd_next(sort_form->record[0]);
+      error= file->ha_rnd_next_batched(sort_form->record[0]);
       if (param->unpack)
         param->unpack(sort_form);
     }
@@ -1173,7 +1179,8 @@ write_keys(Sort_param *param,  SORT_INFO *fs_info, uint count,
   Merge_chunk buffpek;
   DBUG_ENTER("write_keys");
 
-  fs_info->sort_buffer(param, count);
+  set_if_bigger(param->used_sort_threads,
+                fs_info->sort_buffer(param, count));
 
   if (!my_b_inited(tempfile) &&
       open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
@@ -1579,7 +1586,8 @@ static bool save_index(Sort_param *param, uint count, SORT_INFO *table_sort)
   DBUG_ENTER("save_index");
   DBUG_ASSERT(table_sort->record_pointers == 0);
 
-  table_sort->sort_buffer(param, count);
+  set_if_bigger(param->used_sort_threads,
+                table_sort->sort_buffer(param, count));
 
   if (param->using_addon_fields())
   {
@@ -2073,13 +2081,308 @@ bool merge_buffers(Sort_param *param, IO_CACHE *from_file,
 } /* merge_buffers */
 
 
-	/* Do a merge to output-file (save only positions) */
+/* Fewest rows worth a task of the final merge */
+static const ha_rows MIN_ROWS_PER_MERGE_THREAD= 8192;
+
+
+/**
+  Do the final merge by key ranges in parallel.
+
+  @param param        Sort parameter, for rows of fixed length
+  @param sort_buffer  Buffer to split between the tasks
+  @param buffpek      The sorted chunks in tempfile
+  @param n_chunks     Number of chunks, at most MERGEBUFF2
+  @param tempfile     File with the chunks
+  @param outfile      File to write the result rows to
+  @param threads      Number of key ranges, at most MAX_FILESORT_THREADS
+
+  The ranges are delimited by keys taken from the largest chunk at
+  regular intervals, and a binary search finds where each range starts
+  in every chunk. As the rows have a fixed length, that gives the
+  offset of every range in the output. Each task merges its range from
+  all chunks through its own part of the sort buffer and writes it to
+  its own segment of outfile. The tasks read and write with pread() and
+  pwrite() on the file descriptors, as the IO_CACHE positions and the
+  temporary space accounting belong to the caller. The tasks have no
+  THD, so they only look at the killed flag of the statement, and
+  errors are reported when all tasks are done.
+
+  @retval
+    0      OK
+  @retval
+    1      ERROR
+*/
+
+static int merge_index_parallel(Sort_param *param, Sort_buffer sort_buffer,
+                                Merge_chunk *buffpek, uint n_chunks,
+                                IO_CACHE *tempfile, IO_CACHE *outfile,
+                                uint threads)
+{
+  struct Merge_run
+  {
+    uchar *buffer;              // Space for the rows in memory
+    uchar *pos, *end;           // Rows in memory
+    my_off_t file_pos;          // Next row in tempfile
+    ha_rows rows;               // Rows left in tempfile
+  };
+  THD *const thd= current_thd;
+  const bool killable= !param->not_killable;
+  const uint rec_length= param->rec_length;
+  const uint res_length= param->res_length;
+  const uint offset= rec_length - res_length;
+  size_t sort_length= param->sort_length;
+  const qsort_cmp2 cmp= param->get_compare_function();
+  void *const cmp_arg= param->get_compare_argument(&sort_length);
+  const File from= tempfile->file;
+  const uint stride= threads + 1;
+  const size_t part_size= sort_buffer.size() / threads;
+  const size_t run_size= part_size / (n_chunks + 1);
+  /* bounds[chunk*(threads+1) + range] is the row where range starts */
+  ha_rows *bounds;
+  /* first[range] is the first output row of range */
+  ha_rows *first;
+  uchar *splits, *probes;
+  my_off_t start_pos;
+  /* The first error of a task, raised when all tasks are done */
+  std::atomic<uint> io_error{0};
+  int io_errno= 0;
+  int error= 1;
+  DBUG_ENTER("merge_index_parallel");
+  DBUG_ASSERT(n_chunks > 1 && n_chunks <= MERGEBUFF2);
+  DBUG_ASSERT(run_size >= rec_length);
+
+  auto fail= [&](uint err)
+  {
+    uint no_error= 0;
+    if (io_error.compare_exchange_strong(no_error, err))
+      io_errno= my_errno;
+  };
+  auto stop= [&]() { return io_error || (killable && thd->killed); };
+
+  if (flush_io_cache(outfile) ||
+      (outfile->file < 0 && real_open_cached_file(outfile)))
+    DBUG_RETURN(1);                             /* purecov: inspected */
+  start_pos= outfile->pos_in_file;
+
+  if (!my_multi_malloc(PSI_INSTRUMENT_ME, MYF(MY_WME | MY_THREAD_SPECIFIC),
+                       &bounds, n_chunks * stride * sizeof(ha_rows),
+                       &first, stride * sizeof(ha_rows),
+                       &splits, threads * sort_length,
+                       &probes, n_chunks * sort_length, NullS))
+    DBUG_RETURN(1);                             /* purecov: inspected */
+
+  {
+    const Merge_chunk *largest= buffpek;
+    for (uint chunk= 1; chunk < n_chunks; chunk++)
+      if (buffpek[chunk].rowcount() > largest->rowcount())
+        largest= buffpek + chunk;
+    for (uint range= 1; range < threads; range++)
+    {
+      ha_rows row= largest->rowcount() * range / threads;
+      if (mysql_file_pread(from, splits + range * sort_length, sort_length,
+                           largest->file_position() + row * rec_length,
+                           MYF(MY_NABP)))
+      {
+        fail(EE_READ);
+        goto report;
+      }
+    }
+  }
+
+  run_parallel_tasks(n_chunks, [&](uint chunk)
+  {
+    ha_rows *chunk_bounds= bounds + chunk * stride;
+    const my_off_t chunk_pos= buffpek[chunk].file_position();
+    uchar *probe= probes + chunk * sort_length;
+    chunk_bounds[0]= 0;
+    chunk_bounds[threads]= buffpek[chunk].rowcount();
+    for (uint range= 1; range < threads; range++)
+    {
+      /* Find the first row that is not less than the split key */
+      uchar *split= splits + range * sort_length;
+      ha_rows lo= chunk_bounds[range - 1], hi= chunk_bounds[threads];
+      while (lo < hi)
+      {
+        ha_rows mid= lo + (hi - lo) / 2;
+        if (stop())
+          return;
+        if (mysql_file_pread(from, probe, sort_length,
+                             chunk_pos + mid * rec_length, MYF(MY_NABP)))
+        {
+          fail(EE_READ);
+          return;
+        }
+        if (cmp(cmp_arg, &probe, &split) < 0)
+          lo= mid + 1;
+        else
+          hi= mid;
+      }
+      chunk_bounds[range]= lo;
+    }
+  });
+  if (stop())
+    goto report;
+
+  first[0]= 0;
+  for (uint range= 0; range < threads; range++)
+  {
+    ha_rows rows= 0;
+    for (uint chunk= 0; chunk < n_chunks; chunk++)
+      rows+= bounds[chunk * stride + range + 1] - bounds[chunk * stride + range];
+    first[range + 1]= first[range] +
+      MY_MIN(rows, param->limit_rows - first[range]);
+  }
+
+  /* Account for the whole output before the tasks write it */
+  if (io_cache_tmp_file_track(outfile, start_pos + first[threads] * res_length))
+    goto err;
+
+  run_parallel_tasks(threads, [&](uint range)
+  {
+    Merge_run runs[MERGEBUFF2];
+    uint n= 0;
+    ha_rows rows= first[range + 1] - first[range];
+    my_off_t to_pos= start_pos + first[range] * res_length;
+    uchar *buf= sort_buffer.array() + range * part_size;
+    uchar *to= buf + n_chunks * run_size, *to_start= to;
+    uchar *const to_end= to + run_size / res_length * res_length;
+
+    auto refill= [&](Merge_run *run)
+    {
+      ha_rows count= MY_MIN(run->rows, (ha_rows) (run_size / rec_length));
+      size_t length= (size_t) count * rec_length;
+      if (stop())
+        return true;
+      if (mysql_file_pread(from, run->buffer, length, run->file_pos,
+                           MYF(MY_NABP)))
+      {
+        fail(EE_READ);
+        return true;
+      }
+      run->pos= run->buffer;
+      run->end= run->buffer + length;
+      run->file_pos+= length;
+      run->rows-= count;
+      return false;
+    };
+    auto flush= [&]()
+    {
+      size_t length= to - to_start;
+      if (mysql_file_pwrite(outfile->file, to_start, length, to_pos,
+                            MYF(MY_NABP)))
+      {
+        fail(EE_WRITE);
+        return true;
+      }
+      to_pos+= length;
+      to= to_start;
+      return false;
+    };
+
+    if (!rows)
+      return;
+    for (uint chunk= 0; chunk < n_chunks; chunk++)
+    {
+      const ha_rows *chunk_bounds= bounds + chunk * stride;
+      Merge_run *run= runs + n;
+      run->file_pos= buffpek[chunk].file_position() +
+        chunk_bounds[range] * rec_length;
+      run->rows= chunk_bounds[range + 1] - chunk_bounds[range];
+      if (!run->rows)
+        continue;
+      run->buffer= buf + chunk * run_size;
+      if (refill(run))
+        return;
+      n++;
+    }
+
+    /* std::*_heap() keep the largest element first */
+    auto greater= [&](const Merge_run &a, const Merge_run &b)
+                  { return cmp(cmp_arg, &a.pos, &b.pos) > 0; };
+    std::make_heap(runs, runs + n, greater);
+    while (rows)
+    {
+      DBUG_ASSERT(n);
+      std::pop_heap(runs, runs + n, greater);
+      Merge_run *run= runs + n - 1;
+      memcpy(to, run->pos + offset, res_length);
+      rows--;
+      if ((to+= res_length) == to_end && flush())
+        return;
+      if ((run->pos+= rec_length) == run->end)
+      {
+        if (!run->rows)
+        {
+          n--;
+          continue;
+        }
+        if (refill(run))
+          return;
+      }
+      std::push_heap(runs, runs + n, greater);
+    }
+    if (to != to_start)
+      flush();
+  });
+
+report:
+  if (killable && thd->check_killed())
+    goto err;
+  if (uint err= io_error)
+  {
+    my_error(err, MYF(0),
+             my_filename(err == EE_READ ? from : outfile->file), io_errno);
+    goto err;
+  }
+  if (reinit_io_cache(outfile, WRITE_CACHE,
+                      start_pos + first[threads] * res_length, 0, 1))
+    goto err;                                   /* purecov: inspected */
+  buffpek->set_rowcount(first[threads]);
+  buffpek->set_file_position(start_pos);
+  thd->inc_status_sort_merge_passes();
+  thd->query_plan_fsort_passes++;
+  set_if_bigger(param->used_sort_threads, threads);
+  error= 0;
+
+err:
+  my_free(bounds);
+  DBUG_RETURN(error);
+}
+
+
+/**
+  Do a merge to output-file (save only positions)
+
+  Rows of fixed length that are merged without removing duplicates are
+  split by key range between up to param->max_sort_threads tasks, see
+  merge_index_parallel(). Encrypted temporary files are read and written
+  through their IO_CACHE only, so they are merged by one thread.
+*/
 
 int merge_index(Sort_param *param, Sort_buffer sort_buffer,
                 Merge_chunk *buffpek, uint maxbuffer,
                 IO_CACHE *tempfile, IO_CACHE *outfile)
 {
   DBUG_ENTER("merge_index");
+  if (param->max_sort_threads > 1 && maxbuffer > 0 &&
+      maxbuffer < MERGEBUFF2 && !param->unique_buff &&
+      !param->min_dupl_count && !param->is_packed_format() &&
+      !((tempfile->myflags | outfile->myflags) & MY_ENCRYPT))
+  {
+    ha_rows rows= 0;
+    for (uint i= 0; i <= maxbuffer; i++)
+      rows+= buffpek[i].rowcount();
+    /* Every task reads and writes at least IO_SIZE bytes at a time */
+    ha_rows threads= MY_MIN(param->max_sort_threads,
+                            rows / MIN_ROWS_PER_MERGE_THREAD);
+    set_if_smaller(threads, sort_buffer.size() /
+                            ((maxbuffer + 2) *
+                             (size_t) MY_MAX(param->rec_length, IO_SIZE)));
+    if (threads > 1)
+      DBUG_RETURN(merge_index_parallel(param, sort_buffer, buffpek,
+                                       maxbuffer + 1, tempfile, outfile,
+                                       (uint) threads));
+  }
   if (merge_buffers(param, tempfile, outfile, sort_buffer, buffpek, buffpek,
                     buffpek + maxbuffer, 1))
     DBUG_RETURN(1);				/* purecov: inspected */
@@ -164,8 +164,8 @@ class SORT_INFO
   ha_rows   found_rows;         /* How many rows was accepted */
 
   /** Sort filesort_buffer */
-  void sort_buffer(Sort_param *param, uint count)
-  { filesort_buffer.sort_buffer(param, count); }
+  uint sort_buffer(Sort_param *param, uint count)
+  { return filesort_buffer.sort_buffer(param, count); }
 
   uchar **get_sort_keys()
   { return filesort_buffer.get_sort_keys(); }
@@ -20,6 +20,8 @@
 #include "sql_sort.h"
 #include "table.h"
 #include "optimizer_defaults.h"
+#include "sql_parallel.h"
+#include <algorithm>
 
 PSI_memory_key key_memory_Filesort_buffer_sort_keys;
 
@@ -383,32 +385,153 @@ void Filesort_buffer::free_sort_buffer()
 }
 
 
-void Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
+/* A part of the sort buffer smaller than this is not worth a thread */
+static const uint MIN_KEYS_PER_SORT_THREAD= 8192;
+
+/*
+  Sort the record pointers with several threads
+
+  @param keys       The record pointers
+  @param count      Number of record pointers
+  @param threads    Number of parts to sort, at most MAX_FILESORT_THREADS
+  @param radix_len  Key length if radix sort can be used, 0 otherwise
+  @param buffer     Space for count pointers and for
+                    (threads+1)*(threads+1) uints
+
+  The pointers are split into one part per thread, and the parts are
+  sorted independently. Then they are merged into the buffer by key
+  range, again one range per thread: the ranges are delimited by keys
+  taken from the first part at regular intervals, and a binary search
+  finds where each range starts in every part. Finally the result is
+  copied back.
+*/
+
+static void parallel_sort(uchar **keys, uint count, uint threads,
+                          qsort_cmp2 cmp, void *cmp_arg, size_t radix_len,
+                          uchar **buffer)
+{
+  struct Sort_run
+  {
+    uchar **pos, **end;
+  };
+  /* bounds[part*(threads+1) + range] is where range starts in part */
+  uint *bounds= reinterpret_cast<uint*>(buffer + count);
+  const uint stride= threads + 1;
+
+  for (uint part= 0; part < threads; part++)
+  {
+    bounds[part*stride]= (uint) ((ulonglong) count * part / threads);
+    bounds[part*stride + threads]=
+      (uint) ((ulonglong) count * (part + 1) / threads);
+  }
+
+  run_parallel_tasks(threads, [&](uint part)
+  {
+    uint start= bounds[part*stride], n= bounds[part*stride + threads] - start;
+    if (radix_len && msd_radixsort_is_applicable(n, radix_len))
+      msd_radixsort_for_str_ptr(keys + start, n, radix_len, buffer + start);
+    else
+      my_qsort2(keys + start, n, sizeof(uchar*), cmp, cmp_arg);
+  });
+
+  for (uint range= 1; range < threads; range++)
+  {
+    uchar **split= keys + bounds[0] +
+      (ulonglong) (bounds[threads] - bounds[0]) * range / threads;
+    for (uint part= 0; part < threads; part++)
+    {
+      uchar **first= keys + bounds[part*stride + range - 1];
+      uchar **last= keys + bounds[part*stride + threads];
+      first= std::lower_bound(first, last, *split,
+                              [&](uchar *a, uchar *b)
+                              { return cmp(cmp_arg, &a, &b) < 0; });
+      bounds[part*stride + range]= (uint) (first - keys);
+    }
+  }
+
+  run_parallel_tasks(threads, [&](uint range)
+  {
+    Sort_run runs[MAX_FILESORT_THREADS];
+    uint n= 0;
+    uchar **to= buffer;
+    for (uint part= 0; part < threads; part++)
+    {
+      uint *part_bounds= bounds + part*stride;
+      to+= part_bounds[range] - part_bounds[0];
+      if (part_bounds[range] < part_bounds[range + 1])
+        runs[n++]= {keys + part_bounds[range], keys + part_bounds[range + 1]};
+    }
+    /* std::*_heap() keep the largest element first */
+    auto greater= [&](const Sort_run &a, const Sort_run &b)
+                  { return cmp(cmp_arg, a.pos, b.pos) > 0; };
+    std::make_heap(runs, runs + n, greater);
+    while (n > 1)
+    {
+      std::pop_heap(runs, runs + n, greater);
+      Sort_run *run= runs + n - 1;
+      *to++= *run->pos++;
+      if (run->pos == run->end)
+        n--;
+      else
+        std::push_heap(runs, runs + n, greater);
+    }
+    if (n)
+      memcpy(to, runs[0].pos, (runs[0].end - runs[0].pos) * sizeof(uchar*));
+  });
+
+  memcpy(keys, buffer, count * sizeof(uchar*));
+}
+
+
+uint Filesort_buffer::sort_buffer(const Sort_param *param, uint count)
 {
   size_t size= param->sort_length;
   m_sort_keys= get_sort_keys();
 
   if (count <= 1 || size == 0)
-    return;
+    return 1;
 
   // don't reverse for PQ, it is already done
   if (!param->using_pq)
     reverse_record_pointers();
 
   uchar **buffer= NULL;
+  uint threads= MY_MIN(param->max_sort_threads,
+                       count / MIN_KEYS_PER_SORT_THREAD);
+  if (threads > 1 &&
+      (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME,
+                                   count * sizeof(char*) +
+                                   (threads + 1) * (threads + 1) *
+                                   sizeof(uint),
+                                   MYF(MY_THREAD_SPECIFIC))))
+  {
+    parallel_sort(m_sort_keys, count, threads,
+                  param->get_compare_function(),
+                  param->get_compare_argument(&size),
+                  param->using_packed_sortkeys() ? 0 : param->sort_length,
+                  buffer);
+    my_free(buffer);
+    return threads;
+  }
+
+  /*
+    Keys that are not packed are compared with memcmp(), so they can be
+    sorted byte by byte from the most significant one.
+  */
   if (!param->using_packed_sortkeys() &&
-      radixsort_is_applicable(count, param->sort_length) &&
+      msd_radixsort_is_applicable(count, param->sort_length) &&
       (buffer= (uchar**) my_malloc(PSI_INSTRUMENT_ME, count*sizeof(char*),
                                    MYF(MY_THREAD_SPECIFIC))))
   {
-    radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
+    msd_radixsort_for_str_ptr(m_sort_keys, count, param->sort_length, buffer);
     my_free(buffer);
-    return;
+    return 1;
   }
 
   my_qsort2(m_sort_keys, count, sizeof(uchar*),
             param->get_compare_function(),
             param->get_compare_argument(&size));
+  return 1;
 }
 
 
@@ -148,8 +148,11 @@ class Filesort_buffer
     m_size_in_bytes(0), m_idx(0)
   {}
 
-  /** Sort me... */
-  void sort_buffer(const Sort_param *param, uint count);
+  /**
+    Sort me...
+    @returns the number of threads that did the sorting
+  */
+  uint sort_buffer(const Sort_param *param, uint count);
 
   /**
     Reverses the record pointer array, to avoid recording new results for
@@ -33,6 +33,7 @@
 #include "sql_base.h"           // TDC_element
 #include "discover.h"           // extension_based_table_discovery, etc
 #include "log_event.h"          // *_rows_log_event
+#include "log_cache.h"          // binlog_cache_data
 #include "create_options.h"
 #include <myisampack.h>
 #include "transaction.h"
@@ -3766,7 +3767,76 @@ void handler::change_table_ptr(TABLE *table_arg, TABLE_SHARE *share)
 }
 
 
-int handler::ha_rnd_next(uchar *buf)
+/*
+  Size of the buffer of ha_rnd_next_batched(). The first batch is small,
+  so that a scan that ends early, such as with LIMIT, reads few rows ahead.
+*/
+static constexpr uint RND_BATCH_MIN_ROWS= 8;
+static constexpr uint RND_BATCH_MAX_ROWS= 256;
+static constexpr size_t RND_BATCH_MAX_BYTES= 128 * 1024;
+
+/**
+  Return the next row of m_rnd_batch, and read a new batch if all
+  rows were returned. The batches double in size until
+  m_rnd_batch.max_rows. The engine call is instrumented once per batch.
+*/
+int handler::rnd_batch_next(uchar *buf)
+{
+  const size_t rec_buff_length= table_share->rec_buff_length;
+
+  if (m_rnd_batch.next == m_rnd_batch.count)
+  {
+    if (m_rnd_batch.error)
+      return m_rnd_batch.error;
+
+    m_rnd_batch.want= m_rnd_batch.want
+      ? MY_MIN(2 * m_rnd_batch.want, m_rnd_batch.max_rows)
+      : MY_MIN(RND_BATCH_MIN_ROWS, m_rnd_batch.max_rows);
+    m_rnd_batch.next= m_rnd_batch.count= 0;
+    int error;
+    TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, error,
+      { error= rnd_next_batch(m_rnd_batch.rows, m_rnd_batch.want,
+                              &m_rnd_batch.count); })
+    DBUG_ASSERT(m_rnd_batch.count <= m_rnd_batch.want);
+    /* HA_ERR_RECORD_DELETED does not end the scan */
+    if (error != HA_ERR_RECORD_DELETED)
+      m_rnd_batch.error= error;
+    if (!m_rnd_batch.count)
+      return error;
+  }
+
+  memcpy(buf, m_rnd_batch.rows + m_rnd_batch.next++ * rec_buff_length,
+         table_share->reclength);
+  return 0;
+}
+
+
+int handler::ha_rnd_next_batched(uchar *buf)
+{
+  if (!(ha_table_flags() & HA_CAN_RND_NEXT_BATCH))
+    return ha_rnd_next(buf);
+
+  if (!m_rnd_batch.max_rows)
+  {
+    const size_t rec_buff_length= table_share->rec_buff_length;
+    const uint max_rows= uint(MY_MIN(RND_BATCH_MAX_ROWS,
+                                     RND_BATCH_MAX_BYTES / rec_buff_length));
+    if (max_rows < 2 ||
+        !(m_rnd_batch.rows= (uchar*) alloc_root(&table->mem_root,
+                                                max_rows * rec_buff_length)))
+      return ha_rnd_next(buf);
+    /* Do not leave the columns that the engine does not read undefined */
+    for (uint i= 0; i < max_rows; i++)
+      memcpy(m_rnd_batch.rows + i * rec_buff_length,
+             table_share->default_values, table_share->reclength);
+    m_rnd_batch.max_rows= max_rows;
+  }
+
+  return ha_rnd_next_low(buf, true);
+}
+
+
+int handler::ha_rnd_next_low(uchar *buf, bool batched)
 {
   int result;
   DBUG_ENTER("handler::ha_rnd_next");
@@ -3785,8 +3855,11 @@ int handler::ha_rnd_next(uchar *buf)
   });
   do
   {
-    TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, result,
-      { result= rnd_next(buf); })
+    if (batched)
+      result= rnd_batch_next(buf);
+    else
+      TABLE_IO_WAIT(tracker, PSI_TABLE_FETCH_ROW, MAX_KEY, result,
+        { result= rnd_next(buf); })
     if (result != HA_ERR_RECORD_DELETED)
       break;
     status_var_increment(table->in_use->status_var.ha_read_rnd_deleted_count);
@@ -7686,6 +7759,9 @@ static int binlog_log_row_to_binlog(TABLE* table,
     error= (*log_func)(thd, table, mysql_bin_log.as_event_log(), cache,
                        has_trans, thd->variables.binlog_row_image,
                        before_record, after_record);
+  if (!error && binlog_transaction_dependency_tracking ==
+      BINLOG_DEPENDENCY_TRACKING_WRITESET)
+    cache->add_writeset(table, before_record, after_record);
   DBUG_RETURN(error ? HA_ERR_RBR_LOGGING_FAILED : 0);
 }
 
@@ -190,6 +190,11 @@ enum chf_create_flags {
 #define HA_NO_AUTO_INCREMENT   (1ULL << 23)
 /* Has automatic checksums and uses the old checksum format */
 #define HA_HAS_OLD_CHECKSUM    (1ULL << 24)
+/*
+  rnd_next_batch() can read several rows of a table scan at a time, and
+  position() works on any row that it returned
+*/
+#define HA_CAN_RND_NEXT_BATCH  (1ULL << 25)
 /* Table data are stored in separate files (for lower_case_table_names) */
 #define HA_FILE_BASED	       (1ULL << 26)
 #define HA_CAN_BIT_FIELD       (1ULL << 28) /* supports bit fields */
@@ -3488,6 +3493,34 @@ class handler :public Sql_alloc
     For non partitioned handlers this is &TABLE_SHARE::ha_share.
   */
   Handler_share **ha_share;
+  /**
+    Rows of a table scan that rnd_next_batch() has read and that
+    ha_rnd_next_batched() has not returned yet.
+  */
+  struct
+  {
+    /** buffer for max_rows rows, table_share->rec_buff_length bytes apart */
+    uchar *rows;
+    /** capacity of the buffer, or 0 if it is not allocated */
+    uint max_rows;
+    /** number of rows requested by the previous rnd_next_batch(), or 0 */
+    uint want;
+    /** number of rows that the previous rnd_next_batch() returned */
+    uint count;
+    /** next row to return */
+    uint next;
+    /** the error that rnd_next_batch() returned after the rows */
+    int error;
+  } m_rnd_batch;
+
+  /** Discard the rows of m_rnd_batch at the start or end of a scan */
+  void rnd_batch_reset()
+  {
+    m_rnd_batch.want= m_rnd_batch.count= m_rnd_batch.next= 0;
+    m_rnd_batch.error= 0;
+  }
+  int rnd_batch_next(uchar *buf);
+  int ha_rnd_next_low(uchar *buf, bool batched);
 public:
 
   double optimizer_where_cost;          // Copy of THD->...optimizer_where_cost
@@ -3521,7 +3554,8 @@ class handler :public Sql_alloc
     m_psi_numrows(0),
     m_psi_locker(NULL),
     row_logging(0), row_logging_init(0),
-    m_lock_type(F_UNLCK), ha_share(NULL), optimizer_where_cost(0),
+    m_lock_type(F_UNLCK), ha_share(NULL), m_rnd_batch(),
+    optimizer_where_cost(0),
     optimizer_scan_setup_cost(0)
   {
     DBUG_PRINT("info",
@@ -3586,6 +3620,7 @@ class handler :public Sql_alloc
     DBUG_ASSERT(inited==NONE || (inited==RND && scan));
     inited= (result= rnd_init(scan)) ? NONE: RND;
     end_range= NULL;
+    rnd_batch_reset();
     DBUG_RETURN(result);
   }
   int ha_rnd_end()
@@ -3594,6 +3629,7 @@ class handler :public Sql_alloc
     DBUG_ASSERT(inited==RND);
     inited=NONE;
     end_range= NULL;
+    rnd_batch_reset();
     DBUG_RETURN(rnd_end());
   }
   int ha_rnd_init_with_error(bool scan) __attribute__ ((warn_unused_result));
@@ -4375,6 +4411,23 @@ class handler :public Sql_alloc
 public:
   virtual int ft_read(uchar *buf) { return HA_ERR_WRONG_COMMAND; }
   virtual int rnd_next(uchar *buf)=0;
+  /**
+    Read the next rows of a table scan. Only used with HA_CAN_RND_NEXT_BATCH.
+
+    @param buf       buffer for max_rows rows, table_share->rec_buff_length
+                     bytes apart
+    @param max_rows  maximum number of rows to read, at least 1
+    @param n_rows    number of rows that were read; they are valid even
+                     if an error is returned
+
+    @return 0, or the error that rnd_next() returned after the rows
+  */
+  virtual int rnd_next_batch(uchar *buf, uint max_rows, uint *n_rows)
+  {
+    int error= rnd_next(buf);
+    *n_rows= !error;
+    return error;
+  }
   virtual int rnd_pos(uchar * buf, uchar *pos)=0;
   /**
     This function only works for handlers having
@@ -4401,7 +4454,13 @@ class handler :public Sql_alloc
   /* Same as above, but with statistics */
   inline int ha_ft_read(uchar *buf);
   inline void ha_ft_end() { ft_end(); ft_handler=NULL; }
-  int ha_rnd_next(uchar *buf);
+  int ha_rnd_next(uchar *buf) { return ha_rnd_next_low(buf, false); }
+  /*
+    Same as ha_rnd_next(), but the engine may read the following rows
+    ahead with rnd_next_batch(). The engine must return single rows when
+    they are locked or the cursor position matters for an update.
+  */
+  int ha_rnd_next_batched(uchar *buf);
   int ha_rnd_pos(uchar *buf, uchar *pos);
   inline int ha_rnd_pos_by_record(uchar *buf);
   inline int ha_read_first_row(uchar *buf, uint primary_key);
@@ -32,6 +32,7 @@
 #include "sp_head.h"
 #include "item_sum.h"
 #include "sql_type_geom.h"
+#include "sql_window.h"
 
 /**
   Calculate the affordable RAM limit for structures like TREE or Unique
@@ -754,7 +755,7 @@ bool Aggregator_distinct::setup(THD *thd)
     Setup can be called twice for ROLLUP items. This is a bug.
     Please add DBUG_ASSERT(tree == 0) here when it's fixed.
   */
-  if (tree || table || tmp_table_param)
+  if (tree || hash_set || table || tmp_table_param)
     return FALSE;
 
   if (item_sum->setup(thd))
@@ -824,8 +825,15 @@ bool Aggregator_distinct::setup(THD *thd)
       }
       if (all_binary)
       {
-        cmp_arg= (void*) &tree_key_length;
-        compare_key= simple_raw_key_cmp;
+        /*
+          Equal rows are equal byte by byte and we only need to count
+          them, so there is no need to sort the rows.
+        */
+        DBUG_ASSERT(hash_set == 0);
+        hash_set= (new (thd->mem_root)
+                   Unique_hash_set(tree_key_length,
+                                   item_sum->ram_limitation(thd)));
+        return hash_set == 0;
       }
       else
       {
@@ -937,11 +945,13 @@ void Aggregator_distinct::clear()
   item_sum->clear();
   if (tree)
     tree->reset();
+  if (hash_set)
+    hash_set->reset();
   /* tree and table can be both null only if always_null */
   if (item_sum->sum_func() == Item_sum::COUNT_FUNC || 
       item_sum->sum_func() == Item_sum::COUNT_DISTINCT_FUNC)
   {
-    if (!tree && table)
+    if (!tree && !hash_set && table)
     {
       table->file->extra(HA_EXTRA_NO_CACHE);
       table->file->ha_delete_all_rows();
@@ -998,6 +1008,8 @@ bool Aggregator_distinct::add()
       */
       return tree->unique_add(table->record[0] + table->s->null_bytes);
     }
+    if (hash_set)
+      return hash_set->unique_add(table->record[0] + table->s->null_bytes);
     if (unlikely((error= table->file->ha_write_tmp_row(table->record[0]))) &&
         table->file->is_fatal_error(error, HA_CHECK_DUP))
     {
@@ -1057,7 +1069,14 @@ void Aggregator_distinct::endup()
       sum->count= (longlong) tree->elements_in_tree();
       endup_done= TRUE;
     }
-    if (!tree)
+    if (hash_set)
+    {
+      ulonglong count;
+      /* The error, if any, is already reported */
+      sum->count= hash_set->get_count(&count) ? 0 : (longlong) count;
+      endup_done= TRUE;
+    }
+    else if (!tree)
     {
       /* there were blobs */
       table->file->info(HA_STATUS_VARIABLE | HA_STATUS_NO_LOCK);
@@ -1814,6 +1833,11 @@ Aggregator_distinct::~Aggregator_distinct()
     delete tree;
     tree= NULL;
   }
+  if (hash_set)
+  {
+    delete hash_set;
+    hash_set= NULL;
+  }
   if (table)
   {
     free_tmp_table(table->in_use, table);
@@ -1970,6 +1994,214 @@ void Item_sum_count::cleanup()
 }
 
 
+/*
+  Approximate count of distinct values
+*/
+
+/* The finalizer of MurmurHash3, spreads every input bit to all bits */
+
+static inline ulonglong hll_mix(ulonglong nr)
+{
+  nr^= nr >> 33;
+  nr*= 0xff51afd7ed558ccdULL;
+  nr^= nr >> 33;
+  nr*= 0xc4ceb9fe1a85ec53ULL;
+  nr^= nr >> 33;
+  return nr;
+}
+
+
+static inline ulonglong hll_hash_bytes(CHARSET_INFO *cs, const uchar *str,
+                                       size_t length)
+{
+  ulong nr1= 1, nr2= 4;
+  cs->coll->hash_sort(cs, str, length, &nr1, &nr2);
+  return (ulonglong) nr1;
+}
+
+
+/*
+  Hash the value of the argument so that equal values get equal hashes
+
+  Strings are hashed by their collation, decimals by their binary form
+  with the scale of the argument, and temporal values by their packed
+  form.
+*/
+
+ulonglong Item_sum_approx_count_distinct::value_hash(bool *is_null)
+{
+  Item *arg= args[0];
+  ulonglong nr;
+
+  switch (arg->cmp_type()) {
+  case STRING_RESULT:
+  {
+    String *res= arg->val_str(&value);
+    if ((*is_null= arg->null_value))
+      return 0;
+    nr= hll_hash_bytes(res->charset(), (const uchar*) res->ptr(),
+                       res->length());
+    break;
+  }
+  case INT_RESULT:
+    nr= (ulonglong) arg->val_int();
+    if ((*is_null= arg->null_value))
+      return 0;
+    /*
+      A negative signed value has the bits of a large unsigned one,
+      mix it once more so that the two values get different hashes
+    */
+    if (!arg->unsigned_flag && (longlong) nr < 0)
+      nr= hll_mix(nr);
+    break;
+  case REAL_RESULT:
+  {
+    double dbl= arg->val_real();
+    if ((*is_null= arg->null_value))
+      return 0;
+    if (dbl == 0.0)
+      dbl= 0.0;                                 /* -0.0 is equal to 0.0 */
+    memcpy(&nr, &dbl, sizeof(nr));
+    break;
+  }
+  case DECIMAL_RESULT:
+  {
+    my_decimal buff, *dec= arg->val_decimal(&buff);
+    if ((*is_null= arg->null_value))
+      return 0;
+    uint precision= arg->decimal_precision();
+    decimal_digits_t scale= MY_MIN(arg->decimals, DECIMAL_MAX_SCALE);
+    dec->to_binary(decimal_buff, precision, scale, E_DEC_OK);
+    nr= hll_hash_bytes(&my_charset_bin, decimal_buff,
+                       my_decimal_get_binary_size(precision, scale));
+    break;
+  }
+  case TIME_RESULT:
+  {
+    THD *thd= current_thd;
+    nr= (ulonglong) (arg->field_type() == MYSQL_TYPE_TIME ?
+                     arg->val_time_packed(thd) :
+                     arg->val_datetime_packed(thd));
+    if ((*is_null= arg->null_value))
+      return 0;
+    break;
+  }
+  case ROW_RESULT:
+  default:
+    DBUG_ASSERT(0);
+    *is_null= true;
+    return 0;
+  }
+  return hll_mix(nr);
+}
+
+
+void Item_sum_approx_count_distinct::clear()
+{
+  if (registers)
+    bzero(registers, HLL_REGISTERS);
+}
+
+
+bool Item_sum_approx_count_distinct::add()
+{
+  bool is_null;
+  ulonglong hash= value_hash(&is_null);
+  if (is_null)
+    return 0;
+  if (!registers &&
+      !(registers= current_thd->calloc<uchar>(HLL_REGISTERS)))
+    return 1;
+
+  /* Position of the first 1 bit after the register number */
+  ulonglong rest= hash << HLL_PRECISION;
+  uchar rank= (uchar) (rest ? 64 - my_bit_log2_uint64(rest) :
+                              64 - HLL_PRECISION + 1);
+  set_if_bigger(registers[hash >> (64 - HLL_PRECISION)], rank);
+  return 0;
+}
+
+
+/*
+  Helper functions of the estimate, see Otmar Ertl, "New cardinality
+  estimation algorithms for HyperLogLog sketches", 2017.
+*/
+
+static double hll_sigma(double x)
+{
+  double y= 1, z= x, prev;
+  do
+  {
+    x*= x;
+    prev= z;
+    z+= x * y;
+    y+= y;
+  } while (z != prev);
+  return z;
+}
+
+
+static double hll_tau(double x)
+{
+  if (x == 0 || x == 1)
+    return 0;
+  double y= 1, z= 1 - x, prev;
+  do
+  {
+    x= sqrt(x);
+    prev= z;
+    y*= 0.5;
+    z-= (1 - x) * (1 - x) * y;
+  } while (z != prev);
+  return z / 3;
+}
+
+
+/*
+  Estimate the number of distinct values from the registers
+
+  The estimator corrects for both many empty registers and for
+  saturated ones, so no switch to linear counting or bias tables are
+  needed.
+*/
+
+longlong Item_sum_approx_count_distinct::val_int()
+{
+  const uint max_rank= 64 - HLL_PRECISION + 1;
+  uint histogram[64 - HLL_PRECISION + 2];
+  DBUG_ASSERT(fixed());
+
+  if (!registers)
+    return 0;
+  bzero(histogram, sizeof(histogram));
+  for (uint i= 0; i < HLL_REGISTERS; i++)
+    histogram[registers[i]]++;
+  if (histogram[0] == HLL_REGISTERS)
+    return 0;
+
+  double m= HLL_REGISTERS;
+  double z= m * hll_tau(1 - histogram[max_rank] / m);
+  for (uint k= max_rank - 1; k >= 1; k--)
+    z= 0.5 * (z + histogram[k]);
+  z+= m * hll_sigma(histogram[0] / m);
+  return (longlong) (m * m / (2 * M_LN2) / z + 0.5);
+}
+
+
+void Item_sum_approx_count_distinct::cleanup()
+{
+  /* Allocated in the memory of the execution */
+  registers= NULL;
+  Item_sum_int::cleanup();
+}
+
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD* thd)
+{
+  return new (thd->mem_root) Item_sum_approx_count_distinct(thd, this);
+}
+
+
 /*
   Average
 */
@@ -2190,6 +2422,26 @@ void Stddev::recurrence_next(double nr)
 }
 
 
+/**
+  Inverse of recurrence_next(): remove a value that was added before.
+  This is used when a window frame moves and rows leave the frame.
+*/
+void Stddev::recurrence_prev(double nr)
+{
+  if (m_count <= 1)
+  {
+    *this= Stddev();
+    return;
+  }
+  double m_k= m_m;
+  m_m= (m_k * (double) m_count - nr) / (double) (m_count - 1);
+  m_s= m_s - (nr - m_m) * (nr - m_k);
+  if (m_s < 0)
+    m_s= 0;                                     // Rounding error
+  m_count--;
+}
+
+
 double Stddev::result(bool is_sample_variance)
 {
   if (m_count == 1)
@@ -2304,6 +2556,15 @@ bool Item_sum_variance::add()
   return 0;
 }
 
+
+void Item_sum_variance::remove()
+{
+  double nr= args[0]->val_real();
+
+  if (!args[0]->null_value && m_stddev.count())
+    m_stddev.recurrence_prev(nr);
+}
+
 double Item_sum_variance::val_real()
 {
   DBUG_ASSERT(fixed());
@@ -2396,6 +2657,8 @@ void Item_sum_min_max::clear()
     value->clear();
     null_value= 1;
   }
+  if (as_window_function)
+    clear_as_window();
   DBUG_VOID_RETURN;
 }
 
@@ -2491,6 +2754,14 @@ void Item_sum_min_max::cleanup()
   if (cmp)
     delete cmp;
   cmp= 0;
+  if (win_cmp)
+    delete win_cmp;
+  win_cmp= 0;
+  my_free(win_values);
+  win_values= 0;
+  win_capacity= win_first= win_count= 0;
+  as_window_function= FALSE;
+  win_frame_no_removal= FALSE;
   /*
     by default it is TRUE to avoid TRUE reporting by
     Item_func_not_all/Item_func_nop_all if this item was never called.
@@ -2543,6 +2814,9 @@ bool Item_sum_min::add()
   DBUG_ENTER("Item_sum_min::add");
   DBUG_PRINT("enter", ("this: %p", this));
 
+  if (as_window_function)
+    DBUG_RETURN(add_as_window());
+
   if (unlikely(direct_added))
   {
     /* Change to use direct_item */
@@ -2583,6 +2857,9 @@ bool Item_sum_max::add()
   DBUG_ENTER("Item_sum_max::add");
   DBUG_PRINT("enter", ("this: %p", this));
 
+  if (as_window_function)
+    DBUG_RETURN(add_as_window());
+
   if (unlikely(direct_added))
   {
     /* Change to use direct_item */
@@ -2609,6 +2886,144 @@ bool Item_sum_max::add()
 }
 
 
+/*
+  MIN/MAX as window functions over frames that remove rows.
+  See the comment for Item_sum_min_max::Window_value.
+*/
+
+void Item_sum_min_max::setup_window_func(THD *thd, Window_spec *window_spec)
+{
+  Window_frame *frame= window_spec->window_frame;
+  /*
+    Without a frame or with UNBOUNDED PRECEDING as the top bound no rows
+    are ever removed, and the plain add() is enough.
+  */
+  if (!frame ||
+      (frame->top_bound->precedence_type == Window_frame_bound::PRECEDING &&
+       frame->top_bound->is_unbounded()))
+  {
+    win_frame_no_removal= TRUE;
+    return;
+  }
+  if (!win_cmp)
+  {
+    if (!(win_cmp= new (thd->mem_root) Arg_comparator()))
+      return;
+    win_cmp_value= value;
+    win_cmp->set_cmp_func(thd, this,
+                          args[0]->type_handler_for_comparison(),
+                          (Item**) &arg_cache, (Item**) &win_cmp_value,
+                          FALSE);
+  }
+  as_window_function= TRUE;
+  clear_as_window();
+}
+
+
+void Item_sum_min_max::clear_as_window()
+{
+  win_first= win_count= 0;
+  win_rows_added= win_rows_removed= 0;
+}
+
+
+/* Make 'value' hold the front of the deque, the result of the function */
+
+void Item_sum_min_max::update_value_from_window()
+{
+  if (!win_count)
+  {
+    value->clear();
+    null_value= 1;
+    return;
+  }
+  value->store(win_value(0)->cache);
+  value->cache_value();
+  null_value= 0;
+}
+
+
+bool Item_sum_min_max::add_as_window()
+{
+  DBUG_ASSERT(as_window_function);
+  ulonglong row_no= win_rows_added++;
+
+  arg_cache->cache_value();
+  /* NULLs and rows that have already left the frame are never the result */
+  if (arg_cache->null_value || row_no < win_rows_removed)
+    return 0;
+
+  /* Drop the values that can not be the result as long as this one is */
+  while (win_count)
+  {
+    win_cmp_value= win_value(win_count - 1)->cache;
+    if (win_cmp->compare() * cmp_sign > 0)
+      break;
+    win_count--;
+  }
+
+  if (win_count == win_capacity)
+  {
+    size_t new_capacity= win_capacity ? win_capacity * 2 : 16;
+    Window_value *new_values= (Window_value *)
+      my_malloc(PSI_INSTRUMENT_ME, new_capacity * sizeof(Window_value),
+                MYF(MY_WME | MY_ZEROFILL | MY_THREAD_SPECIFIC));
+    if (!new_values)
+      return 1;
+    /* Keep all allocated caches, they are reused for new values */
+    for (size_t i= 0; i < win_capacity; i++)
+      new_values[i]= *win_value(i);
+    my_free(win_values);
+    win_values= new_values;
+    win_capacity= new_capacity;
+    win_first= 0;
+  }
+
+  Window_value *last= win_value(win_count);
+  if (!last->cache)
+  {
+    THD *thd= current_thd;
+    if (!(last->cache= args[0]->get_cache(thd)))
+      return 1;
+    last->cache->setup(thd, args[0]);
+  }
+  last->cache->store(arg_cache);
+  last->cache->cache_value();
+  last->row_no= row_no;
+  win_count++;
+
+  if (win_count == 1)
+    update_value_from_window();
+  return 0;
+}
+
+
+void Item_sum_min_max::remove_as_window()
+{
+  DBUG_ASSERT(as_window_function);
+  ulonglong row_no= win_rows_removed++;
+
+  if (win_count && win_value(0)->row_no == row_no)
+  {
+    win_first= (win_first + 1) & (win_capacity - 1);
+    win_count--;
+    update_value_from_window();
+  }
+}
+
+
+void Item_sum_min_max::remove()
+{
+  if (as_window_function)
+  {
+    remove_as_window();
+    return;
+  }
+  /* supports_removal() is false unless the frame never removes rows */
+  DBUG_ASSERT(0);
+}
+
+
 /* bit_or and bit_and */
 
 longlong Item_sum_bit::val_int()
@@ -354,7 +354,7 @@ class Item_sum :public Item_func_or_sum
     CUME_DIST_FUNC, NTILE_FUNC, FIRST_VALUE_FUNC, LAST_VALUE_FUNC,
     NTH_VALUE_FUNC, LEAD_FUNC, LAG_FUNC, PERCENTILE_CONT_FUNC,
     PERCENTILE_DISC_FUNC, SP_AGGREGATE_FUNC, JSON_ARRAYAGG_FUNC,
-    JSON_OBJECTAGG_FUNC, GEOMETRY_COLLECT_FUNC
+    JSON_OBJECTAGG_FUNC, GEOMETRY_COLLECT_FUNC, APPROX_COUNT_DISTINCT_FUNC
   };
 
   Item **ref_by; /* pointer to a ref to the object used to register it */
@@ -436,6 +436,7 @@ class Item_sum :public Item_func_or_sum
     case GROUP_CONCAT_FUNC:
     case JSON_ARRAYAGG_FUNC:
     case GEOMETRY_COLLECT_FUNC:
+    case APPROX_COUNT_DISTINCT_FUNC:
       return true;
     default:
       return false;
@@ -612,6 +613,7 @@ class Item_sum :public Item_func_or_sum
 
 
 class Unique;
+class Unique_hash_set;
 
 
 /**
@@ -670,6 +672,13 @@ class Aggregator_distinct : public Aggregator
   */
   Unique *tree;
 
+  /*
+    Used instead of the tree for COUNT(DISTINCT) when all of the row can
+    be binary compared: the distinct rows only need to be counted, which
+    a hash set does without sorting or merging them.
+  */
+  Unique_hash_set *hash_set;
+
   /* 
     The length of the temp table row. Must be a member of the class as it
     gets passed down to simple_raw_key_cmp () as a compare function argument
@@ -700,7 +709,7 @@ class Aggregator_distinct : public Aggregator
 public:
   Aggregator_distinct (Item_sum *sum) :
     Aggregator(sum), table(NULL), tmp_table_param(NULL), tree(NULL),
-    always_null(false), use_distinct_values(false) {}
+    hash_set(NULL), always_null(false), use_distinct_values(false) {}
   virtual ~Aggregator_distinct ();
   Aggregator_type Aggrtype() override { return DISTINCT_AGGREGATOR; }
 
@@ -952,6 +961,63 @@ class Item_sum_count :public Item_sum_int
 };
 
 
+/**
+  APPROX_COUNT_DISTINCT(expr): estimate of COUNT(DISTINCT expr) by a
+  HyperLogLog sketch.
+
+  Every value is hashed to 64 bits. The first HLL_PRECISION bits choose a
+  register, which keeps the longest run of leading zeros seen in the rest
+  of the bits. The memory used per group is fixed, and the standard error
+  of the estimate is about 1.04 / sqrt(HLL_REGISTERS), i.e. 0.8%.
+*/
+
+class Item_sum_approx_count_distinct :public Item_sum_int
+{
+  static const uint HLL_PRECISION= 14;
+  static const uint HLL_REGISTERS= 1U << HLL_PRECISION;
+
+  uchar *registers;               /* Allocated by the first add() */
+  String value;
+  uchar decimal_buff[DECIMAL_MAX_FIELD_SIZE];
+
+  void clear() override;
+  bool add() override;
+  void cleanup() override;
+  ulonglong value_hash(bool *is_null);
+
+public:
+  Item_sum_approx_count_distinct(THD *thd, Item *item_par):
+    Item_sum_int(thd, item_par), registers(NULL)
+  {
+    quick_group= false;
+  }
+  Item_sum_approx_count_distinct(THD *thd,
+                                 Item_sum_approx_count_distinct *item):
+    Item_sum_int(thd, item), registers(NULL)
+  {
+    quick_group= false;
+  }
+  enum Sumfunctype sum_func () const override
+  {
+    return APPROX_COUNT_DISTINCT_FUNC;
+  }
+  const Type_handler *type_handler() const override
+  { return &type_handler_slonglong; }
+  longlong val_int() override;
+  void reset_field() override { DBUG_ASSERT(0); }        // not used
+  void update_field() override { DBUG_ASSERT(0); }       // not used
+  void no_rows_in_result() override { clear(); }
+  LEX_CSTRING func_name_cstring() const override
+  {
+    static LEX_CSTRING name= { STRING_WITH_LEN("approx_count_distinct(") };
+    return name;
+  }
+  Item *copy_or_same(THD* thd) override;
+  Item *do_get_copy(THD *thd) const override
+  { return get_item_copy<Item_sum_approx_count_distinct>(thd, this); }
+};
+
+
 class Item_sum_avg :public Item_sum_sum
 {
 public:
@@ -1041,6 +1107,7 @@ class Stddev
   Stddev(const uchar *);
   void to_binary(uchar *) const;
   void recurrence_next(double nr);
+  void recurrence_prev(double nr);
   double result(bool is_simple_variance);
   ulonglong count() const { return m_count; }
   static uint32 binary_size()
@@ -1070,6 +1137,11 @@ class Item_sum_variance :public Item_sum_double
   void fix_length_and_dec_decimal();
   void clear() override final;
   bool add() override final;
+  void remove() override final;
+  bool supports_removal() const override final
+  {
+    return true;
+  }
   double val_real() override;
   void reset_field() override final;
   void update_field() override final;
@@ -1159,16 +1231,53 @@ class Item_sum_min_max :public Item_sum_hybrid
   bool was_values;  // Set if we have found at least one row (for max/min only)
   bool was_null_value;
 
+  /*
+    State used when the function is computed as a window function with
+    a moving frame. Rows are always added and removed in the same order,
+    so the values that can still become the result are kept in a monotonic
+    deque: every value is better than all the values following it.
+    Rows are numbered in the order they were added; a value is dropped
+    from the front of the deque when its row is removed from the frame.
+  */
+  struct Window_value
+  {
+    Item_cache *cache;
+    ulonglong row_no;
+  };
+  bool as_window_function;
+  /* Set if the window frame of the function never removes rows */
+  bool win_frame_no_removal;
+  /* Ring buffer of win_capacity (power of 2) elements */
+  Window_value *win_values;
+  size_t win_capacity, win_first, win_count;
+  ulonglong win_rows_added, win_rows_removed;
+  /* Compares arg_cache with win_cmp_value */
+  Arg_comparator *win_cmp;
+  Item_cache *win_cmp_value;
+
+  Window_value *win_value(size_t n)
+  { return win_values + ((win_first + n) & (win_capacity - 1)); }
+  bool add_as_window();
+  void remove_as_window();
+  void clear_as_window();
+  void update_value_from_window();
+
 public:
   Item_sum_min_max(THD *thd, Item *item_par,int sign):
     Item_sum_hybrid(thd, item_par),
     direct_added(FALSE), value(0), arg_cache(0), cmp(0),
-    cmp_sign(sign), was_values(TRUE)
+    cmp_sign(sign), was_values(TRUE), as_window_function(FALSE),
+    win_frame_no_removal(FALSE), win_values(0), win_capacity(0),
+    win_first(0), win_count(0), win_rows_added(0), win_rows_removed(0),
+    win_cmp(0), win_cmp_value(0)
   { collation.set(&my_charset_bin); }
   Item_sum_min_max(THD *thd, Item_sum_min_max *item)
     :Item_sum_hybrid(thd, item),
     direct_added(FALSE), value(item->value), arg_cache(0),
-    cmp_sign(item->cmp_sign), was_values(item->was_values)
+    cmp_sign(item->cmp_sign), was_values(item->was_values),
+    as_window_function(FALSE), win_frame_no_removal(FALSE),
+    win_values(0), win_capacity(0), win_first(0), win_count(0),
+    win_rows_added(0), win_rows_removed(0), win_cmp(0), win_cmp_value(0)
   { }
   bool fix_fields(THD *, Item **) override;
   bool fix_length_and_dec(THD *thd) override;
@@ -1203,6 +1312,16 @@ class Item_sum_min_max :public Item_sum_hybrid
   Field *create_tmp_field(MEM_ROOT *root, bool group, TABLE *table) override;
   void setup_caches(THD *thd) override
   { setup_hybrid(thd, arguments()[0], NULL); }
+  void setup_window_func(THD *thd, Window_spec *window_spec) override;
+  void remove() override;
+  /*
+    Removal is only possible with the deque set up by setup_window_func(),
+    otherwise the frame is scanned for every row.
+  */
+  bool supports_removal() const override
+  {
+    return as_window_function || win_frame_no_removal;
+  }
 };
 
 
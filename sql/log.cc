@@ -75,6 +75,7 @@
 #include "semisync_slave.h"
 #include <utility>     // pair
 #endif
+#include <unordered_map>
 
 /* max size of the log message */
 #define MAX_LOG_BUFFER_SIZE 1024
@@ -3747,6 +3748,7 @@ void MYSQL_BIN_LOG::cleanup()
     mysql_mutex_destroy(&LOCK_xid_list);
     mysql_mutex_destroy(&LOCK_binlog_background_thread);
     mysql_mutex_destroy(&LOCK_binlog_end_pos);
+    dump_cache.destroy();
     mysql_cond_destroy(&COND_relay_log_updated);
     mysql_cond_destroy(&COND_bin_log_updated);
     mysql_cond_destroy(&COND_queue_busy);
@@ -3786,6 +3788,119 @@ void MYSQL_BIN_LOG::init_pthread_objects()
                   &COND_binlog_background_thread_end, 0);
 
   mysql_mutex_record_order(&LOCK_log, &LOCK_global_system_variables);
+  dump_cache.init();
+}
+
+
+void Binlog_dump_cache::init()
+{
+  mysql_rwlock_init(key_rwlock_BINLOG_dump_cache, &lock);
+}
+
+
+void Binlog_dump_cache::destroy()
+{
+  my_free(buf);
+  buf= nullptr;
+  size= 0;
+  enabled= false;
+  mysql_rwlock_destroy(&lock);
+}
+
+
+void Binlog_dump_cache::reset(const char *name, my_off_t pos,
+                              enum_binlog_checksum_alg alg, bool encrypted)
+{
+  mysql_mutex_assert_owner(mysql_bin_log.get_log_lock());
+  if (!buf && binlog_dump_cache_size)
+  {
+    buf= (uchar*) my_malloc(PSI_INSTRUMENT_ME, binlog_dump_cache_size,
+                            MYF(MY_WME));
+    if (buf)
+      size= binlog_dump_cache_size;
+  }
+
+  mysql_rwlock_wrlock(&lock);
+  safe_strcpy(file_name, sizeof file_name, name);
+  start= end= pos;
+  checksum_alg= alg;
+  enabled= buf && !encrypted;
+  verified= true;
+  mysql_rwlock_unlock(&lock);
+}
+
+
+/** Copy bytes from the ring buffer, which must contain [pos, pos+len). */
+void Binlog_dump_cache::copy(my_off_t pos, uchar *dst, size_t len) const
+{
+  size_t offset= size_t(pos % size);
+  size_t n= std::min(len, size - offset);
+  memcpy(dst, buf + offset, n);
+  if (n < len)
+    memcpy(dst + n, buf, len - n);
+}
+
+
+void Binlog_dump_cache::add_event(const char *name, my_off_t pos,
+                                  const uchar *ev, size_t len, bool checked)
+{
+  mysql_rwlock_wrlock(&lock);
+  if (enabled && pos >= end && !strcmp(name, file_name))
+  {
+    if (pos > end || len > size)
+    {
+      /*
+        The cache is behind this dump thread (it was reset while no
+        dump thread was reading the file), or the event does not fit.
+        Continue caching from here.
+      */
+      start= end= pos;
+      verified= true;
+    }
+    if (len <= size)
+    {
+      if (pos + len - start > size)
+        start= pos + len - size;   /* Evict the oldest bytes */
+      size_t offset= size_t(pos % size);
+      size_t n= std::min(len, size - offset);
+      memcpy(buf + offset, ev, n);
+      if (n < len)
+        memcpy(buf, ev + n, len - n);
+      end= pos + len;
+      if (!checked)
+        verified= false;
+    }
+  }
+  mysql_rwlock_unlock(&lock);
+}
+
+
+bool Binlog_dump_cache::read_event(const char *name, my_off_t pos,
+                                   String *packet)
+{
+  mysql_rwlock_rdlock(&lock);
+  bool found= false;
+  uchar header[LOG_EVENT_MINIMAL_HEADER_LEN];
+  if (enabled && pos >= start && pos + sizeof header <= end &&
+      !strcmp(name, file_name))
+  {
+    copy(pos, header, sizeof header);
+    size_t len= uint4korr(header + EVENT_LEN_OFFSET);
+    size_t ev_offset= packet->length();
+    if (len >= sizeof header && len <= end - pos &&
+        !packet->reserve(len))
+    {
+      uchar *ev= (uchar*) packet->ptr() + ev_offset;
+      copy(pos, ev, len);
+      packet->length(uint32(ev_offset + len));
+      found= verified || !opt_master_verify_checksum ||
+        !event_checksum_test(ev, ulong(len), checksum_alg);
+      if (!found)
+        packet->length(uint32(ev_offset));
+    }
+  }
+  mysql_rwlock_unlock(&lock);
+  return found;
 }
 
 
@@ -4226,6 +4341,9 @@ bool MYSQL_BIN_LOG::open(const char *log_name,
     if (!is_relay_log)
     {
       binlog_commit_by_rotate.set_reserved_bytes((uint32)offset);
+      dump_cache.reset(log_file_name, offset,
+                       (enum_binlog_checksum_alg) binlog_checksum_options,
+                       crypto.scheme != 0);
       /* update binlog_end_pos so that it can be read by after sync hook */
       reset_binlog_end_pos(log_file_name, offset);
 
@@ -7119,6 +7237,83 @@ Event_log::prepare_pending_rows_event(THD *thd, TABLE* table,
 }
 
 
+/**
+  The writesets of the transactions in the binary log, for
+  binlog_transaction_dependency_tracking=WRITESET. Protected by LOCK_log.
+*/
+class Binlog_writeset_history
+{
+  struct domain
+  {
+    /* key hash value -> seq_no of the latest transaction that modified it */
+    std::unordered_map<uint32, uint64> keys;
+    /* Any transaction up to this seq_no may have modified any key */
+    uint64 floor_seq_no;
+    /* The seq_no of the latest transaction in the domain */
+    uint64 last_seq_no;
+  };
+  std::unordered_map<uint32, domain> domains;
+
+public:
+  /** Forget everything, because a transaction was not tracked. */
+  void clear()
+  {
+    if (!domains.empty())
+      domains.clear();
+  }
+
+  /**
+    Add a transaction to the history.
+    @param domain_id   replication domain of the transaction
+    @param seq_no      sequence number of the transaction
+    @param writeset    the transaction's key hash values, or nullptr if the
+                       transaction may conflict with any other
+    @param dependency  the seq_no of the latest conflicting transaction
+    @return whether the dependency was determined
+  */
+  bool add(uint32 domain_id, uint64 seq_no,
+           const Dynamic_array<uint32> *writeset, uint64 *dependency)
+  {
+    domain &d= domains.try_emplace(domain_id,
+                                   domain{{}, seq_no - 1, seq_no - 1}).
+      first->second;
+
+    if (!writeset || seq_no <= d.last_seq_no ||
+        writeset->elements() > binlog_transaction_dependency_history_size)
+    {
+      d.keys.clear();
+      d.floor_seq_no= d.last_seq_no= seq_no;
+      return false;
+    }
+
+    if (d.keys.size() + writeset->elements() >
+        binlog_transaction_dependency_history_size)
+    {
+      d.keys.clear();
+      d.floor_seq_no= d.last_seq_no;
+    }
+
+    uint64 dep= d.floor_seq_no;
+    for (size_t i= 0; i < writeset->elements(); i++)
+    {
+      auto k= d.keys.try_emplace(writeset->at(i), seq_no);
+      /* The same key may occur several times in the writeset. */
+      if (!k.second && k.first->second != seq_no)
+      {
+        dep= std::max(dep, k.first->second);
+        k.first->second= seq_no;
+      }
+    }
+
+    d.last_seq_no= seq_no;
+    *dependency= dep;
+    return true;
+  }
+};
+
+static Binlog_writeset_history binlog_writeset_history;
+
+
 /* Generate a new global transaction ID, and write it to the binlog */
 
 bool
@@ -7182,6 +7377,25 @@ MYSQL_BIN_LOG::write_gtid_event(THD *thd, bool standalone,
                             LOG_EVENT_SUPPRESS_USE_F, is_transactional,
                             commit_id, has_xid, is_ro_1pc);
 
+  if (binlog_transaction_dependency_tracking ==
+      BINLOG_DEPENDENCY_TRACKING_WRITESET)
+  {
+    const binlog_cache_mngr *mngr= thd->binlog_get_cache_mngr();
+    const bool tracked= mngr && is_transactional && !standalone &&
+      mngr->stmt_cache.empty() && mngr->trx_cache.writeset_valid() &&
+      (gtid_event.flags2 & Gtid_log_event::FL_TRANSACTIONAL) &&
+      !(gtid_event.flags2 & (Gtid_log_event::FL_DDL |
+                             Gtid_log_event::FL_PREPARED_XA |
+                             Gtid_log_event::FL_COMPLETED_XA));
+    if (binlog_writeset_history.add(domain_id, seq_no,
+                                    tracked
+                                    ? &mngr->trx_cache.writeset() : nullptr,
+                                    &gtid_event.dependency_seq_no))
+      gtid_event.flags_extra|= Gtid_log_event::FL_EXTRA_WRITESET_E1;
+  }
+  else
+    binlog_writeset_history.clear();
+
   /* Write the event to the binary log. */
   DBUG_ASSERT(this == &mysql_bin_log);
 
@@ -7540,6 +7754,8 @@ bool MYSQL_BIN_LOG::write(Log_event *event_info, my_bool *with_annotate)
       is_trans_cache= use_trans_cache(thd, using_trans);
       cache_data= cache_mngr->get_binlog_cache_data(is_trans_cache);
       file= &cache_data->cache_log;
+      /* Statement events are not covered by the row writeset */
+      cache_data->invalidate_writeset();
 
       if (thd->lex->stmt_accessed_non_trans_temp_table() && is_trans_cache)
         thd->transaction->stmt.mark_modified_non_trans_temp_table();
@@ -8988,9 +9204,40 @@ MYSQL_BIN_LOG::write_transaction_to_binlog_events(group_commit_entry *entry)
   return true;
 }
 
+/*
+  With binlog_transaction_compression, compress the transactional cache in
+  the committing thread, before it is queued for group commit. The group
+  commit leader then only needs to write the result.
+*/
+void MYSQL_BIN_LOG::compress_transaction(group_commit_entry *entry)
+{
+  const ulong compression= binlog_transaction_compression;
+  if (compression == BINLOG_TRANSACTION_COMPRESSION_NONE ||
+      !entry->using_trx_cache || entry->incident_event)
+    return;
+#ifdef WITH_WSREP
+  /* The writeset was already replicated from the cache */
+  if (WSREP(entry->thd))
+    return;
+#endif
+  binlog_cache_mngr *mngr= entry->cache_mngr;
+  binlog_cache_data *cache_data= mngr->get_binlog_cache_data(TRUE);
+  /*
+    The compressed events are written as they are in the cache, which is
+    only possible when write_cache() would copy them as they are.
+  */
+  if (mngr->trx_cache.empty() ||
+      binlog_checksum_options != (ulong) cache_data->checksum_opt ||
+      opt_binlog_legacy_event_pos)
+    return;
+  cache_data->compress(compression == BINLOG_TRANSACTION_COMPRESSION_LZ4
+                       ? BINLOG_COMPRESS_ALG_LZ4 : BINLOG_COMPRESS_ALG_ZLIB);
+}
+
 bool
 MYSQL_BIN_LOG::write_transaction_with_group_commit(group_commit_entry *entry)
 {
+  compress_transaction(entry);
   int is_leader= queue_for_group_commit(entry);
 
 #ifdef WITH_WSREP
@@ -9566,7 +9813,23 @@ int MYSQL_BIN_LOG::write_transaction_or_stmt(group_commit_entry *entry,
                       DBUG_SUICIDE();
                     });
 
-    if (write_cache(entry->thd, mngr->get_binlog_cache_data(TRUE)))
+    binlog_cache_data *cache_data= mngr->get_binlog_cache_data(TRUE);
+    if (cache_data->compressed() &&
+        likely(binlog_checksum_options == (ulong) cache_data->checksum_opt) &&
+        likely(!opt_binlog_legacy_event_pos))
+    {
+      Transaction_compressed_log_event ev(entry->thd,
+                                          cache_data->compressed(),
+                                          cache_data->compressed_length());
+      if (write_event(&ev))
+      {
+        entry->error_cache= NULL;
+        DBUG_RETURN(ER_ERROR_ON_WRITE);
+      }
+      status_var_add(entry->thd->status_var.binlog_bytes_written,
+                     ev.data_written);
+    }
+    else if (write_cache(entry->thd, cache_data))
     {
       entry->error_cache= &mngr->trx_cache.cache_log;
       DBUG_RETURN(ER_ERROR_ON_WRITE);
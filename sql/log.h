@@ -602,6 +602,72 @@ struct rpl_gtid;
 struct wait_for_commit;
 class Binlog_commit_by_rotate;
 
+/**
+  A copy of the most recently written part of the active binary log,
+  shared by the dump threads (binlog_dump_cache_size).
+
+  The cache is filled by the dump threads, not by the committing
+  threads: the leading dump thread, which is the first one to read an
+  event from the file, appends it to a ring buffer, evicting the oldest
+  bytes. The other dump threads that are positioned inside the cached
+  range copy the events from memory; one that lags behind the start of
+  the ring, or that is reading an older binlog file, reads the file as
+  before. Without dump threads, the cache costs nothing at commit.
+
+  When master_verify_checksum is set, the checksums are verified once
+  by the dump thread that reads the events from the file.
+  Encrypted binlog files are not cached.
+*/
+class Binlog_dump_cache
+{
+  mysql_rwlock_t lock;
+  /** the ring buffer of binlog_dump_cache_size bytes, or nullptr */
+  uchar *buf;
+  /** size of buf */
+  size_t size;
+  /** the binlog file that is being cached */
+  char file_name[FN_REFLEN];
+  /** the cached range [start, end) of file_name */
+  my_off_t start, end;
+  /** the checksum algorithm of file_name */
+  enum_binlog_checksum_alg checksum_alg;
+  /** whether file_name is being cached */
+  bool enabled;
+  /** whether all checksums in the cached range have been verified */
+  bool verified;
+
+  void copy(my_off_t pos, uchar *dst, size_t len) const;
+public:
+  Binlog_dump_cache() : buf(nullptr), size(0), start(0), end(0),
+    checksum_alg(BINLOG_CHECKSUM_ALG_OFF), enabled(false), verified(false)
+  { file_name[0]= '\0'; }
+  void init();
+  void destroy();
+
+  /** Start caching a new binlog file. Protected by LOCK_log.
+  @param name       the binlog file name
+  @param pos        the current end of the file
+  @param alg        the checksum algorithm of the file
+  @param encrypted  whether the file is encrypted */
+  void reset(const char *name, my_off_t pos, enum_binlog_checksum_alg alg,
+             bool encrypted);
+  /** Append an event that a dump thread read from the file. Events of
+  the dump threads that lag behind the end of the cache are ignored.
+  @param name      the binlog file name
+  @param pos       the position of the event in the file
+  @param ev        the event
+  @param len       length of the event
+  @param checked   whether the checksum of the event was verified */
+  void add_event(const char *name, my_off_t pos, const uchar *ev, size_t len,
+                 bool checked);
+  /** Copy an event to a dump thread packet.
+  @param name    the binlog file name
+  @param pos     the position of the event in the file
+  @param packet  the packet to append the event to
+  @return whether the event was found in the cache */
+  bool read_event(const char *name, my_off_t pos, String *packet);
+};
+
 class MYSQL_BIN_LOG: public TC_LOG, public Event_log
 {
   friend Binlog_commit_by_rotate;
@@ -766,6 +832,7 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
   int queue_for_group_commit(group_commit_entry *entry);
   bool write_transaction_to_binlog_events(group_commit_entry *entry);
   bool write_transaction_with_group_commit(group_commit_entry *entry);
+  void compress_transaction(group_commit_entry *entry);
   void write_transaction_handle_error(group_commit_entry *entry);
   void trx_group_commit_leader(group_commit_entry *leader);
   void trx_group_commit_with_engines(group_commit_entry *leader,
@@ -775,6 +842,9 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
   void update_gtid_index(uint32 offset, rpl_gtid gtid);
 
 public:
+  /** The recently written events, for the dump threads */
+  Binlog_dump_cache dump_cache;
+
   void purge(bool all);
   int new_file_without_locking(bool commit_by_rotate);
   /*
@@ -972,8 +1042,9 @@ class MYSQL_BIN_LOG: public TC_LOG, public Event_log
       signal_relay_log_update();
     else
     {
+      my_off_t pos= my_b_safe_tell(&log_file);
       lock_binlog_end_pos();
-      binlog_end_pos= my_b_safe_tell(&log_file);
+      binlog_end_pos= pos;
       signal_bin_log_update();
       unlock_binlog_end_pos();
     }
@@ -1370,6 +1441,21 @@ enum enum_binlog_format {
   BINLOG_FORMAT_UNSPEC=3  ///< thd_binlog_format() returns it when binlog is closed
 };
 
+/** Values of binlog_transaction_dependency_tracking */
+enum enum_binlog_dependency_tracking {
+  /** Only the group commit id is available to the parallel slave */
+  BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER= 0,
+  /** Gtid_log_event::dependency_seq_no is determined from writesets */
+  BINLOG_DEPENDENCY_TRACKING_WRITESET= 1
+};
+
+/** Values of binlog_transaction_compression */
+enum enum_binlog_transaction_compression {
+  BINLOG_TRANSACTION_COMPRESSION_NONE= 0,
+  BINLOG_TRANSACTION_COMPRESSION_ZLIB= 1,
+  BINLOG_TRANSACTION_COMPRESSION_LZ4= 2
+};
+
 int query_error_code(THD *thd, bool not_killed);
 uint purge_log_get_error_code(int res);
 
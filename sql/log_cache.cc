@@ -1,6 +1,8 @@
 #include "my_global.h"
 #include "log_cache.h"
 #include "handler.h"
+#include "table.h"
+#include "field.h"
 #include "my_sys.h"
 #include "mysql/psi/mysql_file.h"
 #include "mysql/service_wsrep.h"
@@ -51,6 +53,128 @@ void binlog_cache_data::detach_temp_file()
   reset();
 }
 
+void binlog_cache_data::add_writeset(TABLE *table, const uchar *before_record,
+                                     const uchar *after_record)
+{
+  if (!m_writeset_valid)
+    return;
+
+  const uint keys= table->s->keys;
+  if (table != m_writeset_table)
+  {
+    /*
+      Conflicts can only be detected on the full values of primary or
+      unique keys. Changes caused by foreign key constraints are not logged.
+    */
+    bool has_unique= false;
+    for (uint k= 0; k < keys; k++)
+    {
+      const KEY &key= table->key_info[k];
+      if (!(key.flags & HA_NOSAME))
+        continue;
+      has_unique= true;
+      for (uint p= 0; p < key.user_defined_key_parts; p++)
+        if (key.key_part[p].key_part_flag & HA_PART_KEY_SEG)
+          goto invalid;
+    }
+    if (!has_unique || table->s->long_unique_table ||
+        !table->file->has_transactions_and_rollback() ||
+        table->file->referenced_by_foreign_key() ||
+        !table->file->can_switch_engines())
+      goto invalid;
+    m_writeset_table= table;
+  }
+
+  for (const uchar *record : {before_record, after_record})
+  {
+    if (!record)
+      continue;
+    const my_ptrdiff_t diff= record - table->record[0];
+    for (uint k= 0; k < keys; k++)
+    {
+      const KEY &key= table->key_info[k];
+      if (!(key.flags & HA_NOSAME))
+        continue;
+      /*
+        A key column that was not read may hold any value, and a
+        writeset that exceeds the history would be discarded anyway.
+      */
+      for (uint p= 0; p < key.user_defined_key_parts; p++)
+        if (!bitmap_is_set(table->read_set,
+                           key.key_part[p].field->field_index))
+          goto invalid;
+      if (m_writeset.elements() >= binlog_transaction_dependency_history_size)
+        goto invalid;
+      Hasher hasher;
+      hasher.add(&my_charset_bin, table->s->table_cache_key.str,
+                 table->s->table_cache_key.length);
+      hasher.add(&my_charset_bin, reinterpret_cast<const uchar*>(&k),
+                 sizeof k);
+      for (uint p= 0; p < key.user_defined_key_parts; p++)
+      {
+        Field *field= key.key_part[p].field;
+        field->move_field_offset(diff);
+        field->hash(&hasher);
+        field->move_field_offset(-diff);
+      }
+      if (m_writeset.append_val(hasher.finalize()))
+        goto invalid;
+    }
+  }
+  return;
+
+invalid:
+  invalidate_writeset();
+}
+
+bool binlog_cache_data::compress(uint alg)
+{
+  DBUG_ASSERT(!m_compressed);
+  DBUG_ASSERT(cache_log.type == WRITE_CACHE);
+  const my_off_t end= my_b_tell(&cache_log);
+  const my_off_t len= end - m_file_reserved_bytes;
+
+  /*
+    The dump thread and the replica have to handle the whole
+    Transaction_compressed event as one packet, and the replica has to
+    uncompress the whole transaction into memory. Keep transactions whose
+    payload could not fit into max_allowed_packet or
+    slave_max_allowed_packet uncompressed; as only a compressed image
+    shorter than the payload is used, this also bounds the event size.
+  */
+  const ulonglong max_len=
+    MY_MIN(global_system_variables.max_allowed_packet,
+           slave_max_allowed_packet);
+  if (!len || len + LOG_EVENT_HEADER_LEN + BINLOG_CHECKSUM_LEN > max_len ||
+      !binlog_compress_alg_available(alg))
+    return true;
+
+  uchar *src= (uchar*) my_malloc(PSI_INSTRUMENT_ME, (size_t) len, MYF(MY_WME));
+  if (!src)
+    return true;
+
+  uint32 comlen= binlog_get_compress_len((uint32) len, alg);
+  bool err= init_for_read() || my_b_read(&cache_log, src, (size_t) len);
+  /* Go back to the end of the cache, like truncate() would */
+  if (reinit_io_cache(&cache_log, WRITE_CACHE, end, 0, 0))
+    err= true;
+  cache_log.end_of_file= saved_max_binlog_cache_size;
+
+  if (!err &&
+      (m_compressed= (uchar*) my_malloc(PSI_INSTRUMENT_ME, comlen,
+                                        MYF(MY_WME))) &&
+      !binlog_buf_compress(src, m_compressed, (uint32) len, &comlen, alg) &&
+      comlen < len)
+    m_compressed_len= comlen;
+  else
+  {
+    my_free(m_compressed);
+    m_compressed= NULL;
+  }
+  my_free(src);
+  return !m_compressed;
+}
+
 extern void ignore_db_dirs_append(const char *dirname_arg);
 
 bool init_binlog_cache_dir()
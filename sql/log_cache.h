@@ -45,7 +45,10 @@ class binlog_cache_data
                     before_stmt_pos(MY_OFF_T_UNDEF), m_pending(0), status(0),
                     incident(FALSE), precompute_checksums(precompute_checksums),
                     saved_max_binlog_cache_size(0), ptr_binlog_cache_use(0),
-                    ptr_binlog_cache_disk_use(0), m_file_reserved_bytes(0)
+                    ptr_binlog_cache_disk_use(0), m_file_reserved_bytes(0),
+                    m_writeset(PSI_INSTRUMENT_MEM, 0), m_writeset_table(0),
+                    m_writeset_valid(true), m_compressed(0),
+                    m_compressed_len(0)
   {
     /*
       Read the current checksum setting. We will use this setting to decide
@@ -60,6 +63,7 @@ class binlog_cache_data
   ~binlog_cache_data()
   {
     DBUG_ASSERT(empty());
+    my_free(m_compressed);
 
     if (cache_log.file != -1 && !encrypt_tmp_files)
       unlink(my_filename(cache_log.file));
@@ -128,6 +132,12 @@ class binlog_cache_data
     status= 0;
     incident= FALSE;
     before_stmt_pos= MY_OFF_T_UNDEF;
+    m_writeset.clear();
+    m_writeset_table= NULL;
+    m_writeset_valid= true;
+    my_free(m_compressed);
+    m_compressed= NULL;
+    m_compressed_len= 0;
     DBUG_ASSERT(empty());
   }
 
@@ -269,6 +279,46 @@ class binlog_cache_data
   */
   void detach_temp_file();
 
+  /*
+    Add the hash values of the primary and unique key values of a row
+    change to the writeset, for binlog_transaction_dependency_tracking.
+    The writeset is invalidated if a key column was not read, or if it
+    would exceed binlog_transaction_dependency_history_size.
+  */
+  void add_writeset(TABLE *table, const uchar *before_record,
+                    const uchar *after_record);
+
+  /*
+    Return true if the writeset covers every change in the cache, that is,
+    only row events for tables that have a primary or unique key and
+    no foreign keys were written.
+  */
+  bool writeset_valid() const
+  {
+    return m_writeset_valid && !(status & LOGGED_CRITICAL);
+  }
+
+  const Dynamic_array<uint32> &writeset() const { return m_writeset; }
+
+  void invalidate_writeset()
+  {
+    m_writeset_valid= false;
+    m_writeset.clear();
+  }
+
+  /*
+    Compress the contents of the cache with the enum_binlog_compress_alg
+    alg, for binlog_transaction_compression. The cache itself is unchanged,
+    so that it can still be written as it is.
+
+    @retval false  compressed() returns the compressed record
+    @retval true   the contents could not be compressed, or did not shrink
+  */
+  bool compress(uint alg);
+
+  const uchar *compressed() const { return m_compressed; }
+  uint32 compressed_length() const { return m_compressed_len; }
+
   /*
     Cache to store data before copying it to the binary log.
   */
@@ -356,6 +406,19 @@ class binlog_cache_data
   */
   uint32 m_file_reserved_bytes {0};
 
+  /* Hash values of the primary and unique key values that were changed */
+  Dynamic_array<uint32> m_writeset;
+
+  /* The table that was last found suitable for m_writeset */
+  const TABLE *m_writeset_table;
+
+  /* Whether m_writeset covers every row change in the cache */
+  bool m_writeset_valid;
+
+  /* The compressed contents of the cache, see compress() */
+  uchar *m_compressed;
+  uint32 m_compressed_len;
+
   /*
     It truncates the cache to a certain position. This includes deleting the
     pending event.
@@ -55,6 +55,13 @@
 #include "rpl_constants.h"
 #include "sql_digest.h"
 #include "zlib.h"
+#ifndef MYSQL_CLIENT
+#include <providers/lz4.h>
+#define HAVE_BINLOG_LZ4
+#elif defined(HAVE_LZ4)
+#include <lz4.h>
+#define HAVE_BINLOG_LZ4
+#endif
 #include "myisampack.h"
 #include <algorithm>
 
@@ -273,8 +280,9 @@ char *str_to_hex(char *to, const uchar *from, size_t len)
   Compressed Record
     Record Header: 1 Byte
              7 Bit: Always 1, mean compressed;
-           4-6 Bit: Compressed algorithm - Always 0, means zlib
-                    It maybe support other compression algorithm in the future.
+           4-6 Bit: Compressed algorithm, enum_binlog_compress_alg:
+                    0 means zlib, 1 means LZ4. Only Transaction_compressed
+                    events use LZ4.
            0-3 Bit: Bytes of "Record Original Length"
     Record Original Length: 1-4 Bytes
     Compressed Buf:
@@ -284,11 +292,37 @@ char *str_to_hex(char *to, const uchar *from, size_t len)
   Get the length of compress content.
 */
 
-uint32 binlog_get_compress_len(uint32 len)
+uint32 binlog_get_compress_len(uint32 len, uint alg)
 {
+  uint32 bound= compressBound(len);
+#ifdef HAVE_BINLOG_LZ4
+  if (alg == BINLOG_COMPRESS_ALG_LZ4)
+    bound= (uint32) LZ4_compressBound((int) len);
+#endif
     /* 5 for the begin content, 1 reserved for a '\0'*/
     return ALIGN_SIZE((BINLOG_COMPRESSED_HEADER_LEN + BINLOG_COMPRESSED_ORIGINAL_LENGTH_MAX_BYTES) 
-                        + compressBound(len) + 1);
+                        + bound + 1);
+}
+
+/**
+  Check if the compression algorithm alg can be used.
+*/
+bool binlog_compress_alg_available(uint alg)
+{
+  switch (alg) {
+  case BINLOG_COMPRESS_ALG_ZLIB:
+    return true;
+#ifdef HAVE_BINLOG_LZ4
+  case BINLOG_COMPRESS_ALG_LZ4:
+#ifndef MYSQL_CLIENT
+    return provider_service_lz4->is_loaded;
+#else
+    return true;
+#endif
+#endif
+  default:
+    return false;
+  }
 }
 
 /**
@@ -302,7 +336,8 @@ uint32 binlog_get_compress_len(uint32 len)
 
    return zero if successful, others otherwise.
 */
-int binlog_buf_compress(const uchar *src, uchar *dst, uint32 len, uint32 *comlen)
+int binlog_buf_compress(const uchar *src, uchar *dst, uint32 len, uint32 *comlen,
+                        uint alg)
 {
   uchar lenlen;
   if (len & 0xFF000000)
@@ -331,12 +366,30 @@ int binlog_buf_compress(const uchar *src, uchar *dst, uint32 len, uint32 *comlen
     dst[1]= uchar(len);
     lenlen= 1;
   }
-  dst[0]= 0x80 | (lenlen & 0x07);
+  dst[0]= 0x80 | uchar((alg & 0x07) << 4) | (lenlen & 0x07);
 
   uLongf tmplen= (uLongf)*comlen - BINLOG_COMPRESSED_HEADER_LEN - lenlen - 1;
-  if (compress((Bytef *)dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen, &tmplen,
-               (const Bytef *)src, (uLongf)len) != Z_OK)
+  switch (alg) {
+  case BINLOG_COMPRESS_ALG_ZLIB:
+    if (compress((Bytef *)dst + BINLOG_COMPRESSED_HEADER_LEN + lenlen, &tmplen,
+                 (const Bytef *)src, (uLongf)len) != Z_OK)
+      return 1;
+    break;
+#ifdef HAVE_BINLOG_LZ4
+  case BINLOG_COMPRESS_ALG_LZ4:
   {
+    if (!binlog_compress_alg_available(alg) || len > LZ4_MAX_INPUT_SIZE)
+      return 1;
+    int res= LZ4_compress_default((const char*) src,
+                                  (char*) dst + BINLOG_COMPRESSED_HEADER_LEN +
+                                  lenlen, (int) len, (int) tmplen);
+    if (res <= 0)
+      return 1;
+    tmplen= (uLongf) res;
+    break;
+  }
+#endif
+  default:
     return 1;
   }
   *comlen= (uint32)tmplen + BINLOG_COMPRESSED_HEADER_LEN + lenlen;
@@ -612,12 +665,24 @@ int binlog_buf_uncompress(const uchar *src, uchar *dst, uint32 len,
 
   uint32 alg= (src[0] & 0x70) >> 4;
   switch(alg) {
-  case 0:
-    // zlib
+  case BINLOG_COMPRESS_ALG_ZLIB:
     if (uncompress((Bytef *)dst, &buflen,
       (const Bytef*)src + 1 + lenlen, len - 1 - lenlen) != Z_OK)
       return 1;
     break;
+#ifdef HAVE_BINLOG_LZ4
+  case BINLOG_COMPRESS_ALG_LZ4:
+  {
+    if (!binlog_compress_alg_available(alg))
+      return 1;
+    int res= LZ4_decompress_safe((const char*) src + 1 + lenlen, (char*) dst,
+                                 int(len - 1 - lenlen), int(buflen));
+    if (res < 0 || uint32(res) != *newlen)
+      return 1;
+    buflen= (uLongf) res;
+    break;
+  }
+#endif
   default:
     //TODO
     //bad algorithm
@@ -697,6 +762,7 @@ const char* Log_event::get_type_str(Log_event_type type)
   case WRITE_ROWS_COMPRESSED_EVENT_V1: return "Write_rows_compressed_v1";
   case UPDATE_ROWS_COMPRESSED_EVENT_V1: return "Update_rows_compressed_v1";
   case DELETE_ROWS_COMPRESSED_EVENT_V1: return "Delete_rows_compressed_v1";
+  case TRANSACTION_COMPRESSED_EVENT: return "Transaction_compressed";
 
   default: return "Unknown";				/* impossible */
   }
@@ -1210,6 +1276,9 @@ Log_event* Log_event::read_log_event(const uchar *buf, uint event_len,
     case START_ENCRYPTION_EVENT:
       ev= new Start_encryption_log_event(buf, event_len, fdle);
       break;
+    case TRANSACTION_COMPRESSED_EVENT:
+      ev= new Transaction_compressed_log_event(buf, event_len, fdle);
+      break;
     case TRANSACTION_PAYLOAD_EVENT:             // MySQL 8.0
       *error=
         "Found incompatible MySQL 8.0 TRANSACTION_PAYLOAD_EVENT event. "
@@ -2136,6 +2205,8 @@ Format_description_log_event(uint8 binlog_ver, const char* server_ver,
       post_header_len[WRITE_ROWS_COMPRESSED_EVENT_V1-1]=   ROWS_HEADER_LEN_V1;
       post_header_len[UPDATE_ROWS_COMPRESSED_EVENT_V1-1]=  ROWS_HEADER_LEN_V1;
       post_header_len[DELETE_ROWS_COMPRESSED_EVENT_V1-1]=  ROWS_HEADER_LEN_V1;
+      post_header_len[TRANSACTION_COMPRESSED_EVENT-1]=
+        TRANSACTION_COMPRESSED_HEADER_LEN;
 
       // Sanity-check that all post header lengths are initialized.
       int i;
@@ -2449,7 +2520,7 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
                                const Format_description_log_event
                                *description_event)
   : Log_event(buf, description_event), seq_no(0), commit_id(0),
-    flags_extra(0), extra_engines(0), thread_id(0)
+    flags_extra(0), extra_engines(0), thread_id(0), dependency_seq_no(0)
 {
   uint8 header_size= description_event->common_header_len;
   uint8 post_header_len= description_event->post_header_len[GTID_EVENT-1];
@@ -2534,6 +2605,17 @@ Gtid_log_event::Gtid_log_event(const uchar *buf, uint event_len,
       thread_id= uint4korr(buf);
       buf+= 4;
     }
+
+    if (flags_extra & FL_EXTRA_WRITESET_E1)
+    {
+      if (event_len < static_cast<uint>(buf - buf_0) + 8)
+      {
+        seq_no= 0;
+        return;
+      }
+      dependency_seq_no= uint8korr(buf);
+      buf+= 8;
+    }
   }
   /*
     the strict '<' part of the assert corresponds to extra zero-padded
@@ -3969,6 +4051,151 @@ Ignorable_log_event::Ignorable_log_event(const uchar *buf,
 
 Ignorable_log_event::~Ignorable_log_event() = default;
 
+
+/**************************************************************************
+	Transaction_compressed_log_event member functions
+**************************************************************************/
+
+/**
+  Copy the format of a binlog, for reading the events that are contained
+  in an event of that binlog, after the original description is gone.
+
+  @param desc  the description of the binlog
+  @return a copy of desc, or NULL if out of memory
+*/
+static Format_description_log_event *
+copy_format_description(const Format_description_log_event *desc)
+{
+  Format_description_log_event *fdle=
+    new Format_description_log_event(4, NULL, desc->used_checksum_alg);
+  if (!fdle || !fdle->is_valid())
+    goto err;
+  if (fdle->number_of_event_types < desc->number_of_event_types)
+  {
+    my_free(fdle->post_header_len);
+    if (!(fdle->post_header_len=
+          (uint8*) my_malloc(key_memory_log_event,
+                             desc->number_of_event_types +
+                             BINLOG_CHECKSUM_ALG_DESC_LEN, MYF(MY_WME))))
+      goto err;
+  }
+  memcpy(fdle->post_header_len, desc->post_header_len,
+         desc->number_of_event_types);
+  fdle->number_of_event_types= desc->number_of_event_types;
+  fdle->common_header_len= desc->common_header_len;
+  memcpy(fdle->server_version, desc->server_version,
+         sizeof fdle->server_version);
+  fdle->server_version_split= desc->server_version_split;
+  fdle->event_type_permutation= desc->event_type_permutation;
+  fdle->options_written_to_bin_log= desc->options_written_to_bin_log;
+  return fdle;
+err:
+  delete fdle;
+  return NULL;
+}
+
+
+Transaction_compressed_log_event::
+Transaction_compressed_log_event(const uchar *buf, uint event_len,
+                                 const Format_description_log_event *desc)
+  : Log_event(buf, desc), payload(NULL), payload_len(0), uncompressed_len(0),
+    m_checksum_alg(desc->used_checksum_alg), m_events(NULL), m_fdle(NULL)
+{
+  uint8 header_len= desc->common_header_len +
+    desc->post_header_len[TRANSACTION_COMPRESSED_EVENT-1];
+  if (event_len <= header_len)
+    return;
+  /*
+    The compressed events have the format of the binlog that contains this
+    event, which may have been written by a master of another version.
+    Keep a copy, as desc may be replaced before the events are read.
+  */
+  if (!(m_fdle= copy_format_description(desc)))
+    return;
+  payload= buf + header_len;
+  payload_len= event_len - header_len;
+  /* The compressed record header and the original length */
+  if (payload_len > 1U + (payload[0] & 0x07))
+    uncompressed_len= binlog_get_uncompress_len(payload);
+}
+
+Transaction_compressed_log_event::~Transaction_compressed_log_event()
+{
+  my_free(m_events);
+  delete m_fdle;
+}
+
+const char *Transaction_compressed_log_event::algorithm_name() const
+{
+  switch (algorithm()) {
+  case BINLOG_COMPRESS_ALG_ZLIB: return "ZLIB";
+  case BINLOG_COMPRESS_ALG_LZ4: return "LZ4";
+  default: return "unknown";
+  }
+}
+
+Log_event *
+Transaction_compressed_log_event::next_event(uint32 *pos, bool crc_check,
+                                             const char **error)
+{
+  *error= NULL;
+  if (!m_events)
+  {
+    uint32 len= uncompressed_len;
+    if (!binlog_compress_alg_available(algorithm()))
+    {
+      *error= "The compression algorithm of a Transaction_compressed event "
+        "is not available";
+      return NULL;
+    }
+    if (!(m_events= (uchar*) my_malloc(key_memory_log_event, len,
+                                       MYF(MY_WME))) ||
+        binlog_buf_uncompress(payload, m_events, payload_len, &len) ||
+        len != uncompressed_len)
+    {
+      *error= "Could not uncompress a Transaction_compressed event";
+      my_free(m_events);
+      m_events= NULL;
+      return NULL;
+    }
+  }
+
+  if (*pos == uncompressed_len)
+    return NULL;
+
+  const uchar *header= m_events + *pos;
+  uint32 event_len;
+  if (uncompressed_len - *pos < LOG_EVENT_MINIMAL_HEADER_LEN ||
+      (event_len= uint4korr(header + EVENT_LEN_OFFSET)) <
+        LOG_EVENT_MINIMAL_HEADER_LEN ||
+      event_len > uncompressed_len - *pos)
+  {
+    *error= "Found invalid event in a Transaction_compressed event";
+    return NULL;
+  }
+
+  /* Each event gets its own buffer, as some are kept after they are applied */
+  uchar *buf= (uchar*) my_malloc(key_memory_log_event, event_len,
+                                 MYF(MY_WME));
+  if (!buf)
+  {
+    *error= "Out of memory";
+    return NULL;
+  }
+  memcpy(buf, header, event_len);
+  Log_event *ev= read_log_event(buf, event_len, error, m_fdle, crc_check);
+  if (!ev)
+  {
+    my_free(buf);
+    if (!*error)
+      *error= "Found invalid event in a Transaction_compressed event";
+    return NULL;
+  }
+  ev->register_temp_buf(buf, true);
+  *pos+= event_len;
+  return ev;
+}
+
 bool copy_event_cache_to_file_and_reinit(IO_CACHE *cache, FILE *file)
 {
   return (my_b_copy_all_to_file(cache, file) ||
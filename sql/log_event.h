@@ -225,6 +225,7 @@ class String;
 #define GTID_LIST_HEADER_LEN   4
 #define START_ENCRYPTION_HEADER_LEN 0
 #define XA_PREPARE_HEADER_LEN 0
+#define TRANSACTION_COMPRESSED_HEADER_LEN 0
 
 /* 
   Max number of possible extra bytes in a replication event compared to a
@@ -587,9 +588,11 @@ class String;
 #define MARIA_SLAVE_CAPABILITY_BINLOG_CHECKPOINT 3
 /* MariaDB >= 10.0.1, which knows about global transaction id events. */
 #define MARIA_SLAVE_CAPABILITY_GTID 4
+/* MariaDB >= 12.3, which knows about TRANSACTION_COMPRESSED_EVENT. */
+#define MARIA_SLAVE_CAPABILITY_TRANSACTION_COMPRESSED 5
 
 /* Our capability. */
-#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_GTID
+#define MARIA_SLAVE_CAPABILITY_MINE MARIA_SLAVE_CAPABILITY_TRANSACTION_COMPRESSED
 
 
 /*
@@ -745,6 +748,12 @@ enum Log_event_type
   UPDATE_ROWS_COMPRESSED_EVENT = 170,
   DELETE_ROWS_COMPRESSED_EVENT = 171,
 
+  /*
+    The events of one transaction, compressed together at group commit.
+    See Transaction_compressed_log_event.
+  */
+  TRANSACTION_COMPRESSED_EVENT = 172,
+
   /* Add new MariaDB events here - right above this comment!  */
 
   ENUM_END_EVENT /* end marker */
@@ -3368,6 +3377,13 @@ class Gtid_log_event: public Log_event
   */
   uint8 extra_engines;
   my_thread_id thread_id;
+  /*
+    With FL_EXTRA_WRITESET_E1, the seq_no of the latest earlier transaction
+    in the same domain that modified any of the same primary or unique key
+    values, or of an earlier transaction that could not be tracked.
+    The transaction does not conflict with any later transaction.
+  */
+  uint64 dependency_seq_no;
 
   /* Flags2. */
 
@@ -3414,13 +3430,20 @@ class Gtid_log_event: public Log_event
   static const uchar FL_COMMIT_ALTER_E1= 4;
   static const uchar FL_ROLLBACK_ALTER_E1= 8;
   static const uchar FL_EXTRA_THREAD_ID= 16; // thread_id like in BEGIN Query
+  /*
+    FL_EXTRA_WRITESET_E1 is set when the primary determined dependency_seq_no
+    from the writeset of the transaction, with
+    binlog_transaction_dependency_tracking=WRITESET.
+  */
+  static const uchar FL_EXTRA_WRITESET_E1= 32;
 
 #ifdef MYSQL_SERVER
   static const uint max_data_length= GTID_HEADER_LEN + 2 + sizeof(XID)
                                      + 1 /* flags_extra: */
                                      + 1 /* Extra Engines */
                                      + 8 /* sa_seq_no */
-                                     + 4 /* FL_EXTRA_THREAD_ID */;
+                                     + 4 /* FL_EXTRA_THREAD_ID */
+                                     + 8 /* FL_EXTRA_WRITESET_E1 */;
 
   Gtid_log_event(THD *thd_arg, uint64 seq_no, uint32 domain_id, bool standalone,
                  uint16 flags, bool is_transactional, uint64 commit_id,
@@ -4923,6 +4946,16 @@ class Rows_log_event : public Log_event
   uint find_key_parts(const KEY *key) const;
   bool use_pk_position() const;
   int find_row(rpl_group_info *);
+  /** A row of an UPDATE or DELETE event, collected by hash_scan_rows() */
+  struct hash_scan_row
+  {
+    const uchar *row;     /* Start of the row */
+    const uchar *row_end; /* One-after the end of the row */
+    uint32 hash;          /* Hash value of the before image */
+    bool applied;         /* Whether the row was applied by the scan */
+  };
+  bool use_hash_scan();
+  int hash_scan_rows(rpl_group_info *, Dynamic_array<hash_scan_row> *rows);
   int update_sequence();
 
   // Unpack the current row into m_table->record[0], but with
@@ -5019,6 +5052,20 @@ class Rows_log_event : public Log_event
       
   */
   virtual int do_exec_row(rpl_group_info *rli) = 0;
+
+  /**
+    @brief Apply the current row after it has been located.
+
+    DESCRIPTION
+      The row that was located by find_row() or hash_scan_rows() is in
+      m_table->record[0], and m_curr_row_end points at the end of the
+      before image. Only Update and Delete events locate rows.
+  */
+  virtual int do_apply_row(rpl_group_info *)
+  {
+    DBUG_ASSERT(0);
+    return HA_ERR_WRONG_COMMAND;
+  }
 #endif /* defined(MYSQL_SERVER) && defined(HAVE_REPLICATION) */
 };
 
@@ -5174,6 +5221,7 @@ class Update_rows_log_event : public Rows_log_event
                                COPY_INFO*, Write_record*) override;
   int do_after_row_operations(int) override;
   int do_exec_row(rpl_group_info *) override;
+  int do_apply_row(rpl_group_info *) override;
 #endif /* defined(MYSQL_SERVER) && defined(HAVE_REPLICATION) */
 };
 
@@ -5266,6 +5314,7 @@ class Delete_rows_log_event : public Rows_log_event
                                COPY_INFO*, Write_record*) override;
   int do_after_row_operations(int) override;
   int do_exec_row(rpl_group_info *) override;
+  int do_apply_row(rpl_group_info *) override;
 #endif
 };
 
@@ -5454,6 +5503,81 @@ class Ignorable_log_event : public Log_event {
   int get_data_size() override { return IGNORABLE_HEADER_LEN; }
 };
 
+/**
+  @class Transaction_compressed_log_event
+
+  With binlog_transaction_compression, the events that a transaction wrote
+  to the transactional binlog cache are compressed together at commit and
+  written as one Transaction_compressed_log_event. The GTID event before it
+  and the XID, COMMIT or XA PREPARE event after it are not compressed, so
+  the event group can be recognized without uncompressing anything.
+
+  The event has no post-header. The body is a compressed record, see
+  binlog_buf_compress(), of the original events. These have end_log_pos 0
+  and are checksummed like the events of the binlog that contains them.
+*/
+class Transaction_compressed_log_event: public Log_event
+{
+public:
+#ifdef MYSQL_SERVER
+  Transaction_compressed_log_event(THD *thd_arg, const uchar *payload_arg,
+                                   uint32 payload_len_arg);
+  bool write_data_body(Log_event_writer *writer) override;
+#ifdef HAVE_REPLICATION
+  void pack_info(Protocol*) override;
+  bool is_part_of_group() override { return 1; }
+#endif
+#endif
+  Transaction_compressed_log_event(const uchar *buf, uint event_len,
+                                   const Format_description_log_event*);
+  ~Transaction_compressed_log_event();
+
+#ifdef MYSQL_CLIENT
+  bool print(FILE *file, PRINT_EVENT_INFO *print_event_info) override;
+#endif
+
+  Log_event_type get_type_code() override
+  { return TRANSACTION_COMPRESSED_EVENT; }
+  int get_data_size() override { return payload_len; }
+  bool is_valid() const override { return uncompressed_len != 0; }
+
+  /** @return the enum_binlog_compress_alg of the payload */
+  uint algorithm() const { return (payload[0] & 0x70) >> 4; }
+  const char *algorithm_name() const;
+
+  /**
+    Read the next of the compressed events, uncompressing the payload
+    first if needed.
+
+    @param pos        offset of the event; advanced to the next one
+    @param crc_check  whether to verify the checksum of the event
+    @param error      set to an error message if NULL is returned
+                      for another reason than the end of the events
+
+    @return the event, which owns its buffer, or NULL
+  */
+  Log_event *next_event(uint32 *pos, bool crc_check, const char **error);
+
+  /* The compressed record */
+  const uchar *payload;
+  uint32 payload_len;
+  uint32 uncompressed_len;
+
+private:
+#if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
+  int do_apply_event(rpl_group_info *rgi) override;
+  int do_update_pos(rpl_group_info *rgi) override;
+  enum_skip_reason do_shall_skip(rpl_group_info *rgi) override;
+#endif
+
+  /* The checksum algorithm of the compressed events */
+  enum_binlog_checksum_alg m_checksum_alg;
+  /* The uncompressed events, or NULL */
+  uchar *m_events;
+  /* Describes the compressed events: a copy of the format of the binlog */
+  Format_description_log_event *m_fdle;
+};
+
 #ifdef MYSQL_CLIENT
 bool copy_cache_to_string_wrapped(IO_CACHE *body,
                                   LEX_STRING *to,
@@ -5533,12 +5657,20 @@ enum Log_event_type wsrep_peak_event(rpl_group_info *rgi, ulonglong* event_size)
 */
 
 
+/* Algorithms of a compressed record, see binlog_buf_compress() */
+enum enum_binlog_compress_alg
+{
+  BINLOG_COMPRESS_ALG_ZLIB= 0,
+  BINLOG_COMPRESS_ALG_LZ4= 1
+};
+
 int binlog_buf_compress(const uchar *src, uchar *dst, uint32 len,
-                        uint32 *comlen);
+                        uint32 *comlen, uint alg= BINLOG_COMPRESS_ALG_ZLIB);
 int binlog_buf_uncompress(const uchar *src, uchar *dst, uint32 len,
                           uint32 *newlen);
-uint32 binlog_get_compress_len(uint32 len);
+uint32 binlog_get_compress_len(uint32 len, uint alg= BINLOG_COMPRESS_ALG_ZLIB);
 uint32 binlog_get_uncompress_len(const uchar *buf);
+bool binlog_compress_alg_available(uint alg);
 
 int query_event_uncompress(const Format_description_log_event *description_event,
                            bool contain_checksum,
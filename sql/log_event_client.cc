@@ -3734,6 +3734,29 @@ bool Ignorable_log_event::print(FILE *file,
 }
 
 
+/*
+  Only the header is printed here; mysqlbinlog prints the compressed events
+  after it with process_event().
+*/
+bool Transaction_compressed_log_event::print(FILE *file,
+                                             PRINT_EVENT_INFO *print_event_info)
+{
+  if (print_event_info->short_form)
+    return 0;
+
+  if (print_header(&print_event_info->head_cache, print_event_info, FALSE) ||
+      my_b_printf(&print_event_info->head_cache,
+                  "\tTransaction_compressed\n") ||
+      my_b_printf(&print_event_info->head_cache,
+                  "# compression=%s uncompressed_size=%u\n",
+                  algorithm_name(), uncompressed_len) ||
+      copy_event_cache_to_file_and_reinit(&print_event_info->head_cache,
+                                          file))
+    return 1;
+  return 0;
+}
+
+
 /**
   The default values for these variables should be values that are
   *incorrect*, i.e., values that cannot occur in an event.  This way,
@@ -3863,6 +3886,12 @@ Gtid_log_event::print(FILE *file, PRINT_EVENT_INFO *print_event_info)
       if (my_b_printf(&cache, " thread_id=%s", buf2))
         goto err;
     }
+    if (flags_extra & FL_EXTRA_WRITESET_E1)
+    {
+      longlong10_to_str(dependency_seq_no, buf2, 10);
+      if (my_b_printf(&cache, " dependency=%s", buf2))
+        goto err;
+    }
     if (my_b_printf(&cache, "\n"))
       goto err;
 
@@ -61,6 +61,7 @@
 #include "rpl_constants.h"
 #include "sql_digest.h"
 #include "zlib.h"
+#include <algorithm>
 
 
 #define log_cs  &my_charset_latin1
@@ -2891,7 +2892,7 @@ Gtid_log_event::Gtid_log_event(THD *thd_arg, uint64 seq_no_arg,
     pad_to_size(0), flags2((standalone ? FL_STANDALONE : 0) |
            (commit_id_arg ? FL_GROUP_COMMIT_ID : 0)),
     flags_extra(0), extra_engines(0),
-    thread_id(thd_arg->variables.pseudo_thread_id)
+    thread_id(thd_arg->variables.pseudo_thread_id), dependency_seq_no(0)
 {
   cache_type= Log_event::EVENT_NO_CACHE;
   bool is_tmp_table= thd_arg->lex->stmt_accessed_temp_table();
@@ -3083,6 +3084,12 @@ Gtid_log_event::write(Log_event_writer *writer)
     write_len+= 4;
   }
 
+  if (flags_extra & FL_EXTRA_WRITESET_E1)
+  {
+    int8store(buf + write_len, dependency_seq_no);
+    write_len+= 8;
+  }
+
   if (write_len < GTID_HEADER_LEN)
   {
     bzero(buf+write_len, GTID_HEADER_LEN-write_len);
@@ -3149,7 +3156,8 @@ Gtid_log_event::make_compatible_event(String *packet, bool *need_dummy_event,
 void
 Gtid_log_event::pack_info(Protocol *protocol)
 {
-  char buf[6+5+10+1+10+1+20+1+4+20+1+ ser_buf_size+5 /* sprintf */];
+  char buf[6+5+10+1+10+1+20+1+4+20+1+ ser_buf_size+5 /* sprintf */
+           +12+20 /* dependency */];
   char *p;
   p = strmov(buf, (flags2 & FL_STANDALONE  ? "GTID " :
                    flags2 & FL_PREPARED_XA ? "XA START " : "BEGIN GTID "));
@@ -3181,6 +3189,11 @@ Gtid_log_event::pack_info(Protocol *protocol)
     p= strmov(p, " ROLLBACK ALTER id=");
     p= longlong10_to_str(sa_seq_no, p, 10);
   }
+  if (flags_extra & FL_EXTRA_WRITESET_E1)
+  {
+    p= strmov(p, " dependency=");
+    p= longlong10_to_str(dependency_seq_no, p, 10);
+  }
 
   protocol->store(buf, p-buf, &my_charset_bin);
 }
@@ -5283,11 +5296,40 @@ int Rows_log_event::do_apply_event(rpl_group_info *rgi)
     rgi->set_row_stmt_start_timestamp();
 
     THD_STAGE_INFO(thd, stage_executing);
+
+    Dynamic_array<hash_scan_row> hash_scan(PSI_INSTRUMENT_MEM, 0);
+    size_t hash_scan_next= 0;
+    int hash_scan_error= likely(!error) && use_hash_scan()
+      ? hash_scan_rows(rgi, &hash_scan) : 0;
+
     do
     {
       DBUG_ASSERT(table->in_use);
 
-      error= do_exec_row(rgi);
+      const hash_scan_row *hs;
+      if (unlikely(hash_scan_error))
+      {
+        /*
+          do_apply_row() failed in hash_scan_rows(), which positioned
+          m_curr_row at the failed row. Handle the error like an error
+          of do_exec_row() for that row.
+        */
+        error= hash_scan_error;
+        hash_scan_error= 0;
+      }
+      else if ((hs= hash_scan_next < hash_scan.elements()
+                ? &hash_scan.at(hash_scan_next++) : nullptr) && hs->applied)
+      {
+        DBUG_ASSERT(hs->row == m_curr_row);
+        /* The row was already applied by hash_scan_rows() */
+        m_curr_row_end= hs->row_end;
+        error= 0;
+      }
+      else
+      {
+        DBUG_ASSERT(!hs || hs->row == m_curr_row);
+        error= do_exec_row(rgi);
+      }
       THD_STAGE_INFO(thd, stage_executing);
 
       if (unlikely(error))
@@ -7798,6 +7840,201 @@ int Rows_log_event::find_row(rpl_group_info *rgi)
   DBUG_RETURN(error);
 }
 
+
+/**
+  Check if the rows of this event should be located by hash_scan_rows().
+
+  That is the case for UPDATE and DELETE events when find_row() would
+  have to scan the whole table or a non-unique index for every row.
+*/
+bool Rows_log_event::use_hash_scan()
+{
+  const Log_event_type type= get_general_type_code();
+  return opt_slave_rows_hash_scan &&
+    (type == UPDATE_ROWS_EVENT || type == DELETE_ROWS_EVENT) &&
+    (!m_key_info || !(m_key_info->flags & HA_NOSAME)) &&
+    !use_pk_position() && !m_table->versioned() &&
+    !(m_table->triggers && do_invoke_trigger());
+}
+
+/** @return hash value of the fields of m_table->record[0] */
+static uint32 hash_scan_hash(const Dynamic_array<Field*> &fields)
+{
+  Hasher hasher;
+  for (size_t i= 0; i < fields.elements(); i++)
+    fields.at(i)->hash(&hasher);
+  return hasher.finalize();
+}
+
+/**
+  Locate and apply the rows of an UPDATE or DELETE event by one table scan.
+
+  The before images of all rows of the event are hashed on the columns
+  that record_compare() compares. The table is scanned once, and each
+  table row is compared with the before images that have the same hash
+  value. A matching row is applied by do_apply_row().
+
+  Rows that were not applied here, because no matching table row was
+  found or because the scan was stopped on an error that
+  slave_exec_mode=IDEMPOTENT would ignore, are left for the row
+  processing loop, which will locate them by find_row() and report
+  any errors in the usual way.
+
+  Any other error of do_apply_row() is returned, without applying any
+  further rows. After a deadlock or a lock wait timeout, the storage
+  engine may have rolled back the transaction, which must then be
+  retried as a whole.
+
+  @param rgi   replication group
+  @param rows  the rows of the event in the event order; empty if
+               the hash scan was not used
+  @return error code of do_apply_row(), with m_curr_row and
+  m_curr_row_end pointing to the failed row
+  @retval 0    if the remaining rows can be applied by the row loop
+*/
+int Rows_log_event::hash_scan_rows(rpl_group_info *rgi,
+                                   Dynamic_array<hash_scan_row> *rows)
+{
+  DBUG_ENTER("Rows_log_event::hash_scan_rows");
+  DBUG_ASSERT(!rows->elements());
+
+  TABLE *table= m_table;
+  handler *file= table->file;
+  Check_level_instant_set clis(table->in_use, CHECK_FIELD_IGNORE);
+  const uchar *const curr_row= m_curr_row;
+  const uchar *const curr_row_end= m_curr_row_end;
+  const bool is_update= get_general_type_code() == UPDATE_ROWS_EVENT;
+  Dynamic_array<Field*> fields(PSI_INSTRUMENT_MEM);
+  Dynamic_array<uint> by_hash(PSI_INSTRUMENT_MEM);
+  uint *by_hash_end;
+  size_t n_applied= 0;
+
+  /* Collect the before images and their hash values. */
+  while (m_curr_row != m_rows_end)
+  {
+    prepare_record(table, m_width, FALSE);
+    if (unpack_current_row(rgi))
+      goto abandon;
+    normalize_null_bits(table);
+
+    if (!rows->elements())
+    {
+      /* Every before image of the event consists of the same columns. */
+      const bool all_values_set= bitmap_is_set_all(&table->has_value_set);
+      for (Field **ptr= table->field; *ptr; ptr++)
+        if (!(*ptr)->vcol_info &&
+            (all_values_set || (*ptr)->has_explicit_value()) &&
+            fields.append(*ptr))
+          goto abandon;
+    }
+
+    hash_scan_row row{m_curr_row, nullptr, hash_scan_hash(fields), false};
+    if (is_update)
+    {
+      m_curr_row= m_curr_row_end;
+      if (unpack_current_row(rgi, &m_cols_ai))
+        goto abandon;
+    }
+    row.row_end= m_curr_row_end;
+    if (rows->append(row) || by_hash.append_val(uint(rows->elements() - 1)))
+      goto abandon;
+    m_curr_row= m_curr_row_end;
+  }
+
+  if (rows->elements() < 2)
+    goto abandon;
+
+  if (m_key_info)
+  {
+    /*
+      A lookup in a non-unique index examines rec_per_key rows. Unless
+      that adds up to the size of the table, prefer find_row().
+    */
+    const ulong rec_per_key= m_key_info->rec_per_key[m_usable_key_parts - 1];
+    if (!rec_per_key ||
+        ha_rows(rows->elements()) * rec_per_key < file->stats.records)
+      goto abandon;
+  }
+
+  /* We use this to test that the correct key is used in test cases. */
+  DBUG_EXECUTE_IF("slave_crash_if_table_scan", abort(););
+
+  if (file->ha_rnd_init(1))
+    goto abandon;
+
+  by_hash_end= by_hash.front() + by_hash.elements();
+  std::sort(by_hash.front(), by_hash_end, [rows](uint a, uint b)
+            { return rows->at(a).hash < rows->at(b).hash; });
+
+  while (n_applied < rows->elements() && !file->ha_rnd_next(table->record[0]))
+  {
+    const uint32 hash= hash_scan_hash(fields);
+    uint *i= std::lower_bound(by_hash.front(), by_hash_end, hash,
+                              [rows](uint a, uint32 h)
+                              { return rows->at(a).hash < h; });
+    if (i == by_hash_end || rows->at(*i).hash != hash)
+      continue;
+
+    /* Keep the table row in record[1] while unpacking the candidates. */
+    normalize_null_bits(table);
+    store_record(table, record[1]);
+
+    for (; i != by_hash_end && rows->at(*i).hash == hash; i++)
+    {
+      hash_scan_row &row= rows->at(*i);
+      if (row.applied)
+        continue;
+      m_curr_row= row.row;
+      prepare_record(table, m_width, FALSE);
+      if (unpack_current_row(rgi))
+        goto stop;
+      normalize_null_bits(table);
+      if (record_compare(table))
+        continue;
+
+      restore_record(table, record[1]);
+      int error= do_apply_row(rgi);
+      DBUG_EXECUTE_IF("hash_scan_rows_deadlock",
+                      if (n_applied)
+                      {
+                        DBUG_SET("-d,hash_scan_rows_deadlock");
+                        error= HA_ERR_LOCK_DEADLOCK;
+                      });
+      if (unlikely(error))
+      {
+        if (slave_exec_mode == SLAVE_EXEC_MODE_IDEMPOTENT &&
+            idempotent_error_code(error))
+          goto stop;
+        file->ha_rnd_end();
+        m_curr_row= row.row;
+        m_curr_row_end= row.row_end;
+        DBUG_RETURN(error);
+      }
+      row.applied= true;
+      n_applied++;
+      break;
+    }
+  }
+
+  issue_long_find_row_warning(get_general_type_code(), m_table->alias.c_ptr(),
+                              false, rgi);
+func_exit:
+  file->ha_rnd_end();
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  DBUG_RETURN(0);
+stop:
+  /* find_row() will encounter the error again. */
+  thd->clear_error();
+  goto func_exit;
+abandon:
+  thd->clear_error();
+  rows->clear();
+  m_curr_row= curr_row;
+  m_curr_row_end= curr_row_end;
+  DBUG_RETURN(0);
+}
+
 #endif
 
 /*
@@ -7859,42 +8096,50 @@ Delete_rows_log_event::do_after_row_operations(int error)
 int Delete_rows_log_event::do_exec_row(rpl_group_info *rgi)
 {
   int error;
-  const bool invoke_triggers= m_table->triggers && do_invoke_trigger();
 
   thd_proc_info(thd, "Delete_rows_log_event::find_row()");
   if (likely(!(error= find_row(rgi))))
   {
-    /*
-      Delete the record found, located in record[0]
-    */
-    thd_proc_info(thd, "Delete_rows_log_event::ha_delete_row()");
-
-    bool trg_skip_row= false;
-    if (invoke_triggers &&
-        unlikely(process_triggers(TRG_EVENT_DELETE, TRG_ACTION_BEFORE, false,
-                                  &trg_skip_row)))
-      error= HA_ERR_GENERIC; // in case if error is not set yet
-    if (likely(!error) && !trg_skip_row)
+    error= do_apply_row(rgi);
+    m_table->file->ha_index_or_rnd_end();
+  }
+  return error;
+}
+
+int Delete_rows_log_event::do_apply_row(rpl_group_info *rgi)
+{
+  int error= 0;
+  const bool invoke_triggers= m_table->triggers && do_invoke_trigger();
+
+  /*
+    Delete the record found, located in record[0]
+  */
+  thd_proc_info(thd, "Delete_rows_log_event::ha_delete_row()");
+
+  bool trg_skip_row= false;
+  if (invoke_triggers &&
+      unlikely(process_triggers(TRG_EVENT_DELETE, TRG_ACTION_BEFORE, false,
+                                &trg_skip_row)))
+    error= HA_ERR_GENERIC; // in case if error is not set yet
+  if (likely(!error) && !trg_skip_row)
+  {
+    if (m_vers_from_plain && m_table->versioned(VERS_TIMESTAMP))
     {
-      if (m_vers_from_plain && m_table->versioned(VERS_TIMESTAMP))
-      {
-        Field *end= m_table->vers_end_field();
-        store_record(m_table, record[1]);
-        end->set_time();
-        error= m_table->file->ha_update_row(m_table->record[1],
-                                            m_table->record[0]);
-      }
-      else
-      {
-        error= m_table->file->ha_delete_row(m_table->record[0]);
-      }
+      Field *end= m_table->vers_end_field();
+      store_record(m_table, record[1]);
+      end->set_time();
+      error= m_table->file->ha_update_row(m_table->record[1],
+                                          m_table->record[0]);
+    }
+    else
+    {
+      error= m_table->file->ha_delete_row(m_table->record[0]);
     }
-    if (invoke_triggers && likely(!error) && !trg_skip_row &&
-        unlikely(process_triggers(TRG_EVENT_DELETE, TRG_ACTION_AFTER, false,
-                                  nullptr)))
-      error= HA_ERR_GENERIC; // in case if error is not set yet
-    m_table->file->ha_index_or_rnd_end();
   }
+  if (invoke_triggers && likely(!error) && !trg_skip_row &&
+      unlikely(process_triggers(TRG_EVENT_DELETE, TRG_ACTION_AFTER, false,
+                                nullptr)))
+    error= HA_ERR_GENERIC; // in case if error is not set yet
   return error;
 }
 
@@ -7987,9 +8232,6 @@ Update_rows_log_event::do_after_row_operations(int error)
 int
 Update_rows_log_event::do_exec_row(rpl_group_info *rgi)
 {
-  const bool invoke_triggers= (m_table->triggers && do_invoke_trigger());
-  bool trg_skip_row= false;
-
   thd_proc_info(thd, "Update_rows_log_event::find_row()");
   int error= find_row(rgi);
   if (unlikely(error))
@@ -8003,6 +8245,18 @@ Update_rows_log_event::do_exec_row(rpl_group_info *rgi)
     return error;
   }
 
+  error= do_apply_row(rgi);
+  m_table->file->ha_index_or_rnd_end();
+  return error;
+}
+
+int
+Update_rows_log_event::do_apply_row(rpl_group_info *rgi)
+{
+  const bool invoke_triggers= (m_table->triggers && do_invoke_trigger());
+  bool trg_skip_row= false;
+  int error;
+
   TABLE_LIST *tl= m_table->pos_in_table_list;
   uint8 trg_event_map_save= tl->trg_event_map;
 
@@ -8089,7 +8343,6 @@ Update_rows_log_event::do_exec_row(rpl_group_info *rgi)
     error= HA_ERR_GENERIC; // in case if error is not set yet
 
 err:
-  m_table->file->ha_index_or_rnd_end();
   return error;
 }
 
@@ -8203,6 +8456,89 @@ Incident_log_event::write_data_body(Log_event_writer *writer)
 }
 
 
+/**************************************************************************
+	Transaction_compressed_log_event member functions
+**************************************************************************/
+
+Transaction_compressed_log_event::
+Transaction_compressed_log_event(THD *thd_arg, const uchar *payload_arg,
+                                 uint32 payload_len_arg)
+  : Log_event(thd_arg, 0, true), payload(payload_arg),
+    payload_len(payload_len_arg),
+    uncompressed_len(binlog_get_uncompress_len(payload_arg)),
+    m_checksum_alg(BINLOG_CHECKSUM_ALG_UNDEF), m_events(NULL), m_fdle(NULL)
+{
+  cache_type= Log_event::EVENT_NO_CACHE;
+}
+
+
+bool
+Transaction_compressed_log_event::write_data_body(Log_event_writer *writer)
+{
+  return write_data(writer, payload, payload_len);
+}
+
+
+#if defined(HAVE_REPLICATION)
+void Transaction_compressed_log_event::pack_info(Protocol *protocol)
+{
+  char buf[128];
+  size_t bytes= my_snprintf(buf, sizeof(buf),
+                            "compression=%s uncompressed_size=%u",
+                            algorithm_name(), uncompressed_len);
+  protocol->store(buf, bytes, &my_charset_bin);
+}
+
+
+/*
+  Apply the compressed events one by one, like the SQL thread would if they
+  had been in the relay log. Their positions are all within this event.
+*/
+int Transaction_compressed_log_event::do_apply_event(rpl_group_info *rgi)
+{
+  Relay_log_info const *rli= rgi->rli;
+  const char *errmsg;
+  uint32 pos= 0;
+  Log_event *ev;
+
+  while ((ev= next_event(&pos, opt_slave_sql_verify_checksum, &errmsg)))
+  {
+    Log_event_type typ= ev->get_type_code();
+    ev->thd= thd;
+    int error= ev->apply_event(rgi);
+    rgi->current_event= this;
+    if (!error)
+      error= ev->update_pos(rgi);
+    delete_or_keep_event_post_apply(rgi, typ, ev);
+    if (error)
+      return error;
+  }
+
+  if (errmsg)
+  {
+    rli->report(ERROR_LEVEL, ER_SLAVE_RELAY_LOG_READ_FAILURE, rgi->gtid_info(),
+                ER_THD(thd, ER_SLAVE_RELAY_LOG_READ_FAILURE), errmsg);
+    return 1;
+  }
+  return 0;
+}
+
+
+int Transaction_compressed_log_event::do_update_pos(rpl_group_info *rgi)
+{
+  rgi->inc_event_relay_log_pos();
+  return 0;
+}
+
+
+Log_event::enum_skip_reason
+Transaction_compressed_log_event::do_shall_skip(rpl_group_info *rgi)
+{
+  return continue_group(rgi);
+}
+#endif
+
+
 #if defined(MYSQL_SERVER) && defined(HAVE_REPLICATION)
 /* Pack info for its unrecognized ignorable event */
 void Ignorable_log_event::pack_info(Protocol *protocol)
@@ -54,6 +54,7 @@
 #include "sys_vars_shared.h"
 #include "ddl_log.h"
 #include "optimizer_defaults.h"
+#include "sql_parallel.h"  // parallel_tasks_init, parallel_tasks_end
 
 #include <m_ctype.h>
 #include <my_dir.h>
@@ -454,6 +455,7 @@ uint opt_binlog_gtid_index_page_size= 4096;
 uint opt_binlog_gtid_index_span_min= 65536;
 my_bool opt_master_verify_checksum= 0;
 my_bool opt_slave_sql_verify_checksum= 1;
+my_bool opt_slave_rows_hash_scan= 1;
 const char *binlog_format_names[]= {"MIXED", "STATEMENT", "ROW", NullS};
 const char *binlog_formats_create_tmp_names[]= {"MIXED", "STATEMENT", NullS};
 volatile sig_atomic_t calling_initgroups= 0; /**< Used in SIGSEGV handler. */
@@ -513,6 +515,7 @@ ulong specialflag=0;
 ulong binlog_cache_use= 0, binlog_cache_disk_use= 0;
 ulong binlog_stmt_cache_use= 0, binlog_stmt_cache_disk_use= 0;
 ulong binlog_gtid_index_hit= 0, binlog_gtid_index_miss= 0;
+ulong binlog_dump_cache_hit= 0, binlog_dump_cache_miss= 0;
 ulong max_connections, max_connect_errors;
 uint max_password_errors;
 ulong extra_max_connections;
@@ -567,6 +570,10 @@ ulong opt_slave_domain_parallel_threads= 0;
 ulong opt_slave_parallel_mode;
 ulong opt_binlog_commit_wait_count= 0;
 ulong opt_binlog_commit_wait_usec= 0;
+ulong binlog_transaction_dependency_tracking;
+ulong binlog_transaction_dependency_history_size;
+ulong binlog_transaction_compression;
+ulong binlog_dump_cache_size;
 ulong opt_slave_parallel_max_queued= 131072;
 my_bool opt_gtid_ignore_duplicates= FALSE;
 uint opt_gtid_cleanup_batch_size= 64;
@@ -1079,7 +1086,8 @@ PSI_rwlock_key key_rwlock_LOCK_grant, key_rwlock_LOCK_logger,
   key_rwlock_LOCK_vers_stats, key_rwlock_LOCK_stat_serial,
   key_rwlock_LOCK_ssl_refresh,
   key_rwlock_THD_list,
-  key_rwlock_LOCK_all_status_vars;
+  key_rwlock_LOCK_all_status_vars,
+  key_rwlock_BINLOG_dump_cache;
 
 static PSI_rwlock_info all_server_rwlocks[]=
 {
@@ -1097,7 +1105,8 @@ static PSI_rwlock_info all_server_rwlocks[]=
   { &key_rwlock_LOCK_stat_serial, "TABLE_SHARE::LOCK_stat_serial", 0},
   { &key_rwlock_LOCK_ssl_refresh, "LOCK_ssl_refresh", PSI_FLAG_GLOBAL },
   { &key_rwlock_THD_list, "THD_list::lock", PSI_FLAG_GLOBAL },
-  { &key_rwlock_LOCK_all_status_vars, "LOCK_all_status_vars", PSI_FLAG_GLOBAL }
+  { &key_rwlock_LOCK_all_status_vars, "LOCK_all_status_vars", PSI_FLAG_GLOBAL },
+  { &key_rwlock_BINLOG_dump_cache, "Binlog_dump_cache::lock", PSI_FLAG_GLOBAL }
 };
 
 #ifdef HAVE_MMAP
@@ -2017,6 +2026,7 @@ static void clean_up(bool print_message)
   xid_cache_free();
   tdc_deinit();
   mdl_destroy();
+  parallel_tasks_end();
   dflt_key_cache= 0;
   key_caches.delete_elements(free_key_cache);
   free_all_optimizer_costs();
@@ -4959,6 +4969,7 @@ static int init_server_components()
   */
   my_cpu_init();
   mdl_init();
+  parallel_tasks_init();
   if (tdc_init() || hostname_cache_init())
     unireg_abort(1);
 
@@ -7572,6 +7583,8 @@ SHOW_VAR status_vars[]= {
   {"Binlog_bytes_written",     (char*) offsetof(STATUS_VAR, binlog_bytes_written), SHOW_LONGLONG_STATUS},
   {"Binlog_cache_disk_use",    (char*) &binlog_cache_disk_use,  SHOW_LONG},
   {"Binlog_cache_use",         (char*) &binlog_cache_use,       SHOW_LONG},
+  {"Binlog_dump_cache_hit",    (char*) &binlog_dump_cache_hit,  SHOW_LONG},
+  {"Binlog_dump_cache_miss",   (char*) &binlog_dump_cache_miss, SHOW_LONG},
   {"Binlog_gtid_index_hit",    (char*) &binlog_gtid_index_hit, SHOW_LONG},
   {"Binlog_gtid_index_miss",   (char*) &binlog_gtid_index_miss, SHOW_LONG},
   {"Binlog_stmt_cache_disk_use",(char*) &binlog_stmt_cache_disk_use,  SHOW_LONG},
@@ -8003,6 +8016,7 @@ static int mysql_init_variables(void)
   specialflag= 0;
   binlog_cache_use=  binlog_cache_disk_use= 0;
   binlog_gtid_index_hit= binlog_gtid_index_miss= 0;
+  binlog_dump_cache_hit= binlog_dump_cache_miss= 0;
   max_used_connections= slow_launch_threads = 0;
   max_used_connections_time= 0;
   mysqld_user= mysqld_chroot= opt_init_file= opt_bin_logname = 0;
@@ -9670,6 +9684,7 @@ PSI_memory_key key_memory_THD_handler_tables_hash;
 PSI_memory_key key_memory_THD_variables;
 PSI_memory_key key_memory_Table_trigger_dispatcher;
 PSI_memory_key key_memory_Unique_merge_buffer;
+PSI_memory_key key_memory_Unique_hash_set;
 PSI_memory_key key_memory_Unique_sort_buffer;
 PSI_memory_key key_memory_User_level_lock;
 PSI_memory_key key_memory_XID;
@@ -9946,6 +9961,7 @@ static PSI_memory_info all_server_memory[]=
   { &key_memory_JOIN_CACHE, "JOIN_CACHE", 0},
   { &key_memory_Unique_sort_buffer, "Unique::sort_buffer", 0},
   { &key_memory_Unique_merge_buffer, "Unique::merge_buffer", 0},
+  { &key_memory_Unique_hash_set, "Unique_hash_set", 0},
   { &key_memory_TABLE, "TABLE", PSI_FLAG_GLOBAL}, /* Table cache */
   { &key_memory_frm_string, "frm::string", 0},
   { &key_memory_DATE_TIME_FORMAT, "DATE_TIME_FORMAT", 0},
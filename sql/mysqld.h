@@ -211,6 +211,7 @@ extern my_thread_id global_thread_id;
 extern ulong binlog_cache_use, binlog_cache_disk_use;
 extern ulong binlog_stmt_cache_use, binlog_stmt_cache_disk_use;
 extern ulong binlog_gtid_index_hit, binlog_gtid_index_miss;
+extern ulong binlog_dump_cache_hit, binlog_dump_cache_miss;
 extern ulong aborted_threads, aborted_connects, aborted_connects_preauth;
 extern ulong delayed_insert_timeout;
 extern ulong delayed_insert_limit, delayed_queue_size;
@@ -256,6 +257,10 @@ extern ulong opt_slave_parallel_max_queued;
 extern ulong opt_slave_parallel_mode;
 extern ulong opt_binlog_commit_wait_count;
 extern ulong opt_binlog_commit_wait_usec;
+extern ulong binlog_transaction_dependency_tracking;
+extern ulong binlog_transaction_dependency_history_size;
+extern ulong binlog_transaction_compression;
+extern ulong binlog_dump_cache_size;
 extern my_bool opt_gtid_ignore_duplicates;
 extern uint opt_gtid_cleanup_batch_size;
 extern ulong back_log;
@@ -353,7 +358,7 @@ extern PSI_rwlock_key key_rwlock_LOCK_grant, key_rwlock_LOCK_logger,
   key_rwlock_LOCK_system_variables_hash, key_rwlock_query_cache_query_lock,
   key_LOCK_SEQUENCE,
   key_rwlock_LOCK_vers_stats, key_rwlock_LOCK_stat_serial,
-  key_rwlock_THD_list;
+  key_rwlock_THD_list, key_rwlock_BINLOG_dump_cache;
 
 #ifdef HAVE_MMAP
 extern PSI_cond_key key_PAGE_cond, key_COND_active, key_COND_pool;
@@ -494,6 +499,7 @@ extern PSI_memory_key key_memory_PROFILE;
 extern PSI_memory_key key_memory_frm_string;
 extern PSI_memory_key key_memory_Unique_sort_buffer;
 extern PSI_memory_key key_memory_Unique_merge_buffer;
+extern PSI_memory_key key_memory_Unique_hash_set;
 extern PSI_memory_key key_memory_Query_cache;
 extern PSI_memory_key key_memory_Table_trigger_dispatcher;
 extern PSI_memory_key key_memory_native_functions;
@@ -941,6 +947,7 @@ extern my_bool opt_master_verify_checksum;
 extern my_bool opt_stack_trace, disable_log_notes;
 extern my_bool opt_expect_abort;
 extern my_bool opt_slave_sql_verify_checksum;
+extern my_bool opt_slave_rows_hash_scan;
 extern my_bool opt_mysql56_temporal_format, strict_password_validation;
 extern ulong binlog_checksum_options;
 extern bool max_user_connections_checking;
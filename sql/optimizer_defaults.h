@@ -93,6 +93,24 @@
 #define ROWID_FILTER_PER_CHECK_MODIFIER 4       /* times key_copy_cost */
 #define ROWID_FILTER_PER_ELEMENT_MODIFIER 1     /* times rowid_compare_cost */
 
+/*
+  Sizing of bloom filter containers for rowid filters. 10 bits per
+  element with 7 probes gives a false positive rate of about 1%.
+  Each probe is costed as one rowid compare. A filter with less than
+  ROWID_FILTER_BLOOM_MIN_BITS_PER_ELEMENT bits per element (false
+  positive rate above 15%) is not considered.
+*/
+#define ROWID_FILTER_BLOOM_BITS_PER_ELEMENT 10
+#define ROWID_FILTER_BLOOM_MIN_BITS_PER_ELEMENT 4
+#define ROWID_FILTER_BLOOM_MAX_HASHES 8
+
+/*
+  A vector index search checks the WHERE condition itself (reading rows
+  while walking the graph) only if at most this fraction of rows matches.
+  Otherwise it's cheaper to filter rows after the search.
+*/
+#define HLINDEX_PUSHED_COND_MAX_SELECTIVITY 0.5
+
 /*
   Average disk seek time on a hard disk is 8-10 ms, which is also
   about the time to read a IO_SIZE (8192) block.
@@ -506,7 +506,7 @@ static int rr_index_desc(READ_RECORD *info)
 int rr_sequential(READ_RECORD *info)
 {
   int tmp;
-  while ((tmp= info->table->file->ha_rnd_next(info->record())))
+  while ((tmp= info->table->file->ha_rnd_next_batched(info->record())))
   {
     tmp= rr_handle_error(info, tmp);
     break;
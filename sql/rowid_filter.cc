@@ -35,6 +35,8 @@ lookup_cost(Rowid_filter_container_type cont_type)
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER:
     return log2(est_elements) * rowid_compare_cost + base_lookup_cost;
+  case BLOOM_FILTER_CONTAINER:
+    return bloom_hashes * rowid_compare_cost + base_lookup_cost;
   default:
     DBUG_ASSERT(0);
     return 0;
@@ -53,7 +55,7 @@ double Range_rowid_filter_cost_info::
 avg_access_and_eval_gain_per_row(Rowid_filter_container_type cont_type,
                                  double cost_of_row_fetch)
 {
-  return (cost_of_row_fetch + where_cost) * (1 - selectivity) -
+  return (cost_of_row_fetch + where_cost) * (1 - filter_pass_ratio()) -
          lookup_cost(cont_type);
 }
 
@@ -86,7 +88,7 @@ double Range_rowid_filter_cost_info::
 avg_adjusted_gain_per_row(double access_cost_factor)
 {
   DBUG_ASSERT(access_cost_factor >= 0.0 && access_cost_factor <= 1.0);
-  return gain - (1 - access_cost_factor) * (1 - selectivity);
+  return gain - (1 - access_cost_factor) * (1 - filter_pass_ratio());
 }
 
 
@@ -126,6 +128,11 @@ void Range_rowid_filter_cost_info::init(Rowid_filter_container_type cont_type,
   table= tab;
   key_no= idx;
   est_elements= (ulonglong) table->opt_range[key_no].rows;
+  bloom_bits= 0;
+  bloom_hashes= 0;
+  false_positive_rate= 0.0;
+  if (container_type == BLOOM_FILTER_CONTAINER)
+    init_bloom_filter_params(tab->in_use);
   cost_of_building_range_filter= build_cost(container_type);
 
   where_cost= tab->in_use->variables.optimizer_where_cost;
@@ -144,6 +151,35 @@ void Range_rowid_filter_cost_info::init(Rowid_filter_container_type cont_type,
 }
 
 
+/**
+  @brief
+    Choose the size of the bloom filter and the number of probes
+
+  @details
+    The filter gets ROWID_FILTER_BLOOM_BITS_PER_ELEMENT bits for each
+    expected element, but never more than max_rowid_filter_size bytes.
+    The number of probes is the one that minimizes the false positive
+    rate for the resulting number of bits per element.
+*/
+
+void Range_rowid_filter_cost_info::init_bloom_filter_params(THD *thd)
+{
+  ulonglong max_bits= thd->variables.max_rowid_filter_size * 8;
+  ulonglong elems= MY_MAX(est_elements, 1);
+  double bits_per_elem;
+
+  bloom_bits= MY_MIN(elems * ROWID_FILTER_BLOOM_BITS_PER_ELEMENT, max_bits);
+  bloom_bits= MY_ALIGN(MY_MAX(bloom_bits, 64), 64);
+  if (bloom_bits > max_bits)
+    bloom_bits= max_bits & ~(ulonglong) 63;
+  bits_per_elem= (double) bloom_bits / elems;
+  bloom_hashes= (uint) MY_MIN(MY_MAX(round(bits_per_elem * M_LN2), 1),
+                              ROWID_FILTER_BLOOM_MAX_HASHES);
+  false_positive_rate= pow(1.0 - exp(-bloom_hashes / bits_per_elem),
+                           bloom_hashes);
+}
+
+
 /**
   @brief
    Return the cost of building a range filter of a certain type
@@ -166,6 +202,12 @@ Range_rowid_filter_cost_info::build_cost(Rowid_filter_container_type cont_type)
             (costs->rowid_copy_cost +                      // Copying rowid
              costs->rowid_cmp_cost * log2(est_elements))); // Sort
     break;
+  case BLOOM_FILTER_CONTAINER:
+    /* Add cost of hashing rowids and setting the bits */
+    cost+= (est_elements *
+            (costs->rowid_copy_cost +                      // Hashing rowid
+             costs->rowid_cmp_cost * bloom_hashes));       // Setting bits
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -185,6 +227,11 @@ Rowid_filter_container *Range_rowid_filter_cost_info::create_container()
     res= new (thd->mem_root) Rowid_filter_sorted_array((uint) est_elements,
                                                        elem_sz);
     break;
+  case BLOOM_FILTER_CONTAINER:
+    res= new (thd->mem_root) Rowid_filter_bloom_filter(bloom_bits,
+                                                       bloom_hashes,
+                                                       elem_sz);
+    break;
   default:
     DBUG_ASSERT(0);
   }
@@ -336,6 +383,10 @@ get_max_range_rowid_filter_elems_for_table(
   switch (cont_type) {
   case SORTED_ARRAY_CONTAINER :
     return thd->variables.max_rowid_filter_size/tab->file->ref_length;
+  case BLOOM_FILTER_CONTAINER :
+    /* Not less than ROWID_FILTER_BLOOM_MIN_BITS_PER_ELEMENT per element */
+    return (thd->variables.max_rowid_filter_size * 8 /
+            ROWID_FILTER_BLOOM_MIN_BITS_PER_ELEMENT);
   default :
     DBUG_ASSERT(0);
     return 0;
@@ -368,16 +419,23 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
 {
   uint key_no;
   key_map usable_range_filter_keys;
+  key_map bloom_filter_keys;
   usable_range_filter_keys.clear_all();
+  bloom_filter_keys.clear_all();
   key_map::Iterator it(opt_range_keys);
+  bool can_use_bloom_filter;
 
   if (file->ha_table_flags() & HA_NON_COMPARABLE_ROWID)
     return;                                     // Cannot create filtering
 
+  can_use_bloom_filter= rowid_can_be_hashed();
+
   /*
     From all indexes that can be used for range accesses select only such that
     - can be used as rowid filters                                  (1)
     - the range filter containers for them are not too large        (2)
+    A sorted array is used when it fits into max_rowid_filter_size,
+    otherwise a bloom filter of the same size is used if possible.
   */
   while ((key_no= it++) != key_map::Iterator::BITMAP_END)
   {
@@ -385,8 +443,15 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
       continue;
    if (opt_range[key_no].rows >
        get_max_range_rowid_filter_elems_for_table(thd, this,
-                                                  SORTED_ARRAY_CONTAINER)) // !2
-      continue;
+                                                  SORTED_ARRAY_CONTAINER))
+   {
+     if (!can_use_bloom_filter ||
+         opt_range[key_no].rows >
+         get_max_range_rowid_filter_elems_for_table(thd, this,
+                                                    BLOOM_FILTER_CONTAINER))
+       continue;                                                           // !2
+     bloom_filter_keys.set_bit(key_no);
+   }
     usable_range_filter_keys.set_bit(key_no);
   }
 
@@ -420,7 +485,10 @@ void TABLE::init_cost_info_for_usable_range_rowid_filters(THD *thd)
   while ((key_no= li++) != key_map::Iterator::BITMAP_END)
   {
     *curr_ptr= curr_filter_cost_info;
-    curr_filter_cost_info->init(SORTED_ARRAY_CONTAINER, this, key_no);
+    curr_filter_cost_info->init(bloom_filter_keys.is_set(key_no) ?
+                                BLOOM_FILTER_CONTAINER :
+                                SORTED_ARRAY_CONTAINER,
+                                this, key_no);
     curr_filter_cost_info->is_forced_by_hint=
         hint_key_state(thd, this, key_no, ROWID_FILTER_HINT_ENUM, false);
     curr_ptr++;
@@ -467,6 +535,39 @@ bool TABLE::rowid_filter_can_be_applied_to_key(uint index) const
 }
 
 
+/*
+  Return true if equal rowids of this table always have equal images,
+  so that they can be put into a bloom filter container.
+  This is the case for engines with physical rowids. For engines that
+  use the clustered primary key as rowid all key parts must be compared
+  as binary images.
+*/
+
+bool TABLE::rowid_can_be_hashed() const
+{
+  if (!file->pk_is_clustering_key(s->primary_key))
+    return true;
+  KEY *pk= key_info + s->primary_key;
+  for (uint i= 0; i < pk->user_defined_key_parts; i++)
+  {
+    Field *field= pk->key_part[i].field;
+    switch (field->cmp_type()) {
+    case INT_RESULT:
+    case DECIMAL_RESULT:
+    case TIME_RESULT:
+      break;
+    case STRING_RESULT:
+      if (field->charset() == &my_charset_bin)
+        break;
+      /* fall through */
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+
 void TABLE::trace_range_rowid_filters(THD *thd) const
 {
   DBUG_ASSERT(thd->trace_started());
@@ -493,6 +594,12 @@ void Range_rowid_filter_cost_info::trace_info(THD *thd)
     add("key", table->key_info[key_no].name).
     add("build_cost", cost_of_building_range_filter).
     add("rows", est_elements);
+  if (container_type == BLOOM_FILTER_CONTAINER)
+    js_obj.
+      add("container", "bloom_filter").
+      add("bits", bloom_bits).
+      add("hashes", (ulonglong) bloom_hashes).
+      add("false_positive_rate", false_positive_rate);
 }
 
 /**
@@ -565,13 +672,14 @@ TABLE::best_range_rowid_filter(uint access_key_no, double records,
     if (no_filter_usage.is_set(filter->key_no))
       continue;
 
+    double pass_ratio= filter->filter_pass_ratio();
     new_records= records * filter->selectivity;
     set_if_smaller(*records_out, new_records);
-    cost_of_accepted_rows= fetch_cost * filter->selectivity;
-    cost_of_rejected_rows= index_only_cost * (1 - filter->selectivity);
+    cost_of_accepted_rows= fetch_cost * pass_ratio;
+    cost_of_rejected_rows= index_only_cost * (1 - pass_ratio);
     new_cost= (cost_of_accepted_rows + cost_of_rejected_rows +
                records * filter->lookup_cost());
-    new_total_cost= ((new_cost + new_records *
+    new_total_cost= ((new_cost + records * pass_ratio *
                       in_use->variables.optimizer_where_cost) *
                      prev_records + filter->get_setup_cost());
 
@@ -689,7 +797,11 @@ Rowid_filter::build_return_code Range_rowid_filter::build()
   file->in_range_check_pushed_down= in_range_check_pushed_down_save;
 
   tracker->set_container_elements_count(container->elements());
-  tracker->report_container_buff_size(file->ref_length);
+  if (container->get_type() == BLOOM_FILTER_CONTAINER)
+    tracker->set_container_buff_size(
+      ((Rowid_filter_bloom_filter *) container)->buff_size());
+  else
+    tracker->report_container_buff_size(file->ref_length);
 
   if (rc != SUCCESS)
     return rc;
@@ -738,6 +850,52 @@ bool Rowid_filter_sorted_array::check(void *ctxt, char *elem)
 }
 
 
+bool Rowid_filter_bloom_filter::alloc()
+{
+  DBUG_ASSERT(n_bits % 64 == 0);
+  bits= (ulonglong *) my_malloc(PSI_INSTRUMENT_ME, (size_t) (n_bits / 8),
+                                MYF(MY_ZEROFILL | MY_THREAD_SPECIFIC));
+  return bits == NULL;
+}
+
+
+bool Rowid_filter_bloom_filter::add(void *ctxt, char *elem)
+{
+  uint32 h1, h2;
+  get_hashes(elem, &h1, &h2);
+  for (uint i= 0; i < n_hashes; i++)
+  {
+    ulonglong pos= bit_pos(h1, h2, i);
+    bits[pos / 64]|= 1ULL << (pos % 64);
+  }
+  n_elements++;
+  return false;
+}
+
+
+/**
+  @brief
+    Check a rowid against the bloom filter
+
+  @retval
+    true    elem may be in the container
+    false   elem is definitely not in the container
+*/
+
+bool Rowid_filter_bloom_filter::check(void *ctxt, char *elem)
+{
+  uint32 h1, h2;
+  get_hashes(elem, &h1, &h2);
+  for (uint i= 0; i < n_hashes; i++)
+  {
+    ulonglong pos= bit_pos(h1, h2, i);
+    if (!(bits[pos / 64] & (1ULL << (pos % 64))))
+      return false;
+  }
+  return true;
+}
+
+
 Range_rowid_filter::~Range_rowid_filter()
 {
   delete container;
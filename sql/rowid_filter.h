@@ -146,7 +146,7 @@ class Range_rowid_filter_cost_info;
 typedef enum
 {
   SORTED_ARRAY_CONTAINER,
-  BLOOM_FILTER_CONTAINER      // Not used yet
+  BLOOM_FILTER_CONTAINER
 } Rowid_filter_container_type;
 
 /**
@@ -382,6 +382,70 @@ class Rowid_filter_sorted_array: public Rowid_filter_container
 
 };
 
+/**
+  @class Rowid_filter_bloom_filter
+
+  The implementation of the Rowid_filter_container interface as
+  a bloom filter over rowids / primary keys.
+
+  The filter uses n_bits bits and n_hashes probes per element computed
+  by double hashing of the rowid image. It never gives false negatives,
+  but it can accept a rowid that was never added. The probability of this
+  is taken into account by Range_rowid_filter_cost_info.
+  The container can only be used when equal rowids have equal images,
+  see TABLE::rowid_can_be_hashed().
+*/
+
+class Rowid_filter_bloom_filter: public Rowid_filter_container
+{
+  /* Number of bits in the filter */
+  ulonglong n_bits;
+  /* Number of bits set for each added element */
+  uint n_hashes;
+  /* Length of the rowid images */
+  uint elem_size;
+  /* Number of elements added to the filter */
+  uint n_elements;
+  ulonglong *bits;
+
+  inline void get_hashes(const char *elem, uint32 *h1, uint32 *h2)
+  {
+    *h1= my_crc32c(0, elem, elem_size);
+    *h2= my_crc32c(0x9e3779b9, elem, elem_size) | 1;
+  }
+
+  inline ulonglong bit_pos(uint32 h1, uint32 h2, uint i)
+  {
+    return (h1 + (ulonglong) i * h2) % n_bits;
+  }
+
+public:
+  Rowid_filter_bloom_filter(ulonglong bits_arg, uint hashes_arg,
+                            uint elem_sz)
+    : n_bits(bits_arg), n_hashes(hashes_arg), elem_size(elem_sz),
+      n_elements(0), bits(0) {}
+
+  ~Rowid_filter_bloom_filter() { my_free(bits); }
+
+  Rowid_filter_container_type get_type() override
+  { return BLOOM_FILTER_CONTAINER; }
+
+  bool alloc() override;
+
+  bool add(void *ctxt, char *elem) override;
+
+  bool check(void *ctxt, char *elem) override;
+
+  uint elements() override { return n_elements; }
+
+  /* Size of the bit array in bytes */
+  size_t buff_size() const { return (size_t) (n_bits / 8); }
+
+  /* The bits of the filter do not depend on the order of elements */
+  void sort (int (*cmp) (void *ctxt, const void *el1, const void *el2),
+                         void *cmp_arg) override {}
+};
+
 /**
   @class Range_rowid_filter_cost_info
 
@@ -400,6 +464,14 @@ class Range_rowid_filter_cost_info final: public Sql_alloc
   uint key_no;
   double cost_of_building_range_filter;
   double where_cost, base_lookup_cost, rowid_compare_cost;
+  /* Parameters of the bloom filter (used only for BLOOM_FILTER_CONTAINER) */
+  ulonglong bloom_bits;
+  uint bloom_hashes;
+  /*
+    Probability that the container accepts a rowid that is not in the
+    filter. Always 0 for SORTED_ARRAY_CONTAINER.
+  */
+  double false_positive_rate;
 
   /*
      (gain*row_combinations)-cost_of_building_range_filter yields the gain of
@@ -429,9 +501,20 @@ class Range_rowid_filter_cost_info final: public Sql_alloc
 
   Range_rowid_filter_cost_info() : table(0), key_no(0) {}
 
+  /*
+    The fraction of key tuples accepted by the container of the filter.
+    This is bigger than selectivity for containers with false positives.
+  */
+  double filter_pass_ratio() const
+  {
+    return selectivity + (1 - selectivity) * false_positive_rate;
+  }
+
   void init(Rowid_filter_container_type cont_type,
             TABLE *tab, uint key_no);
 
+  void init_bloom_filter_params(THD *thd);
+
   double build_cost(Rowid_filter_container_type container_type);
 
   double lookup_cost(Rowid_filter_container_type cont_type);
@@ -463,7 +546,7 @@ class Range_rowid_filter_cost_info final: public Sql_alloc
   */
   inline double get_cmp_gain(double row_combinations)
   {
-    return (row_combinations * (1 - selectivity) * where_cost);
+    return (row_combinations * (1 - filter_pass_ratio()) * where_cost);
   }
 
   Rowid_filter_container *create_container();
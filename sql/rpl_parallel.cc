@@ -2262,6 +2262,7 @@ rpl_parallel_thread::get_gco(uint64 wait_count, group_commit_orderer *prev,
   gco->prev_gco= prev;
   gco->next_gco= NULL;
   gco->prior_sub_id= prior_sub_id;
+  gco->prior_seq_no= 0;
   gco->installed= false;
   gco->flags= 0;
 #ifndef DBUG_OFF
@@ -3447,6 +3448,7 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     uchar gtid_flags= gtid_ev->flags2;
     group_commit_orderer *gco;
     uint8 force_switch_flag;
+    bool writeset_dependency;
     enum rpl_group_info::enum_speculation speculation;
 
     if (!(rgi= cur_thread->get_rgi(rli, gtid_ev, e, event_size)))
@@ -3477,6 +3479,13 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
     speculation= rpl_group_info::SPECULATE_NO;
     new_gco= true;
     force_switch_flag= 0;
+    writeset_dependency= mode >= SLAVE_PARALLEL_CONSERVATIVE &&
+      (gtid_ev->flags_extra & Gtid_log_event::FL_EXTRA_WRITESET_E1) &&
+      (gtid_flags & Gtid_log_event::FL_TRANSACTIONAL) &&
+      (gtid_flags & Gtid_log_event::FL_ALLOW_PARALLEL) &&
+      !(gtid_flags & Gtid_log_event::FL_DDL) &&
+      gtid_ev->dependency_seq_no < gtid_ev->seq_no &&
+      e->last_seq_no < gtid_ev->seq_no;
     gco= e->current_gco;
     if (likely(gco))
     {
@@ -3503,6 +3512,21 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         */
         new_gco= false;
       }
+      else if (writeset_dependency &&
+               !(flags & group_commit_orderer::FORCE_SWITCH))
+      {
+        /*
+          The master recorded (binlog_transaction_dependency_tracking=
+          WRITESET) the last earlier transaction that modified any of the
+          same keys. If that transaction was queued before the current GCO,
+          then it will have started to commit before this one can start, so
+          we can run this one in parallel with the current GCO without any
+          speculation. Otherwise, do not speculate on a known conflict; start
+          a new GCO instead.
+        */
+        if (gtid_ev->dependency_seq_no <= gco->prior_seq_no)
+          new_gco= false;
+      }
       else if ((mode >= SLAVE_PARALLEL_OPTIMISTIC) &&
                !(flags & group_commit_orderer::FORCE_SWITCH))
       {
@@ -3575,9 +3599,11 @@ rpl_parallel::do_event(rpl_group_info *serial_rgi, Log_event *ev,
         return 1;
       }
       gco->flags|= force_switch_flag;
+      gco->prior_seq_no= e->last_seq_no;
       e->current_gco= gco;
     }
     rgi->gco= gco;
+    e->last_seq_no= gtid_ev->seq_no;
 
     qev->rgi= e->current_group_info= rgi;
     e->current_sub_id= rgi->gtid_sub_id;
@@ -63,6 +63,12 @@ struct group_commit_orderer {
     is non-NULL.
   */
   uint64 last_sub_id;
+  /*
+    The GTID seq_no of the last event group queued before this GCO. A
+    transaction whose writeset dependency (Gtid_log_event::dependency_seq_no)
+    is not after this can safely be run in parallel with this GCO.
+  */
+  uint64 prior_seq_no;
   /*
     This flag is set when this GCO has been installed into the next_gco pointer
     of the previous GCO.
@@ -375,6 +381,8 @@ struct rpl_parallel_entry {
   */
   uint32 need_sub_id_signal;
   uint64 last_commit_id;
+  /* The GTID seq_no of the last event group queued for this domain. */
+  uint64 last_seq_no;
   uint32 pending_start_alters;
   bool active;
   /*
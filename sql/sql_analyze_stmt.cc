@@ -78,6 +78,9 @@ void Filesort_tracker::print_json_members(Json_writer *writer)
 
   get_data_format(&str);
   writer->add_member("r_sort_mode").add_str(str.ptr(), str.length());
+
+  if (r_sort_threads > 1)
+    writer->add_member("r_sort_threads").add_ll(r_sort_threads);
 }
 
 void Filesort_tracker::get_data_format(String *str)
@@ -282,7 +282,8 @@ class Filesort_tracker : public Sql_alloc
     sort_buffer_size(0),
     r_using_addons(false),
     r_packed_addon_fields(false),
-    r_sort_keys_packed(false)
+    r_sort_keys_packed(false),
+    r_sort_threads(0)
   {}
   
   /* Functions that filesort uses to report various things about its execution */
@@ -335,6 +336,11 @@ class Filesort_tracker : public Sql_alloc
     r_sort_keys_packed= sort_keys_packed;
   }
 
+  inline void report_sort_threads(uint threads)
+  {
+    set_if_bigger(r_sort_threads, threads);
+  }
+
   void get_data_format(String *str);
 
   /* Functions to get the statistics */
@@ -400,6 +406,8 @@ class Filesort_tracker : public Sql_alloc
   bool r_using_addons;
   bool r_packed_addon_fields;
   bool r_sort_keys_packed;
+  /* Most threads that sorted one buffer, 1 or 0 if it was never parallel */
+  uint r_sort_threads;
 };
 
 
@@ -452,6 +460,12 @@ class Rowid_filter_tracker : public Sql_alloc
    container_buff_size= container_elements * elem_size / 8;
   }
 
+  /* Save the size of a container that does not store elements */
+  inline void set_container_buff_size(size_t size)
+  {
+    container_buff_size= size;
+  }
+
   Time_and_counter_tracker *get_time_tracker()
   {
     return &time_tracker;
@@ -10147,6 +10147,27 @@ int TABLE::hlindexes_on_insert()
   return 0;
 }
 
+/*
+  Start collecting rows to build hlindexes at once in hlindexes_bulk_end().
+  Only done for an empty table, e.g. when ALTER TABLE copies the data.
+*/
+int TABLE::hlindexes_bulk_start()
+{
+  DBUG_ASSERT(s->hlindexes() == (hlindex != NULL));
+  if (hlindex && hlindex->in_use)
+    if (int err= mhnsw_bulk_start(this, key_info + s->keys))
+      return err;
+  return 0;
+}
+
+int TABLE::hlindexes_bulk_end(bool abort)
+{
+  if (hlindex_bulk)
+    if (int err= mhnsw_bulk_end(this, abort))
+      return err;
+  return 0;
+}
+
 int TABLE::hlindexes_on_update()
 {
   DBUG_ASSERT(s->hlindexes() == (hlindex != NULL));
@@ -10181,7 +10202,12 @@ int TABLE::hlindexes_on_delete_all(bool truncate)
   return 0;
 }
 
-int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
+/*
+  rows not matching cond (and the pushed rowid filter, if any) are skipped
+  by the hlindex search itself, see mhnsw_read_first()
+*/
+int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                              Item *cond, double cond_selectivity)
 {
   DBUG_ASSERT(s->hlindexes() == 1);
   DBUG_ASSERT(nr == s->keys);
@@ -10191,7 +10217,8 @@ int TABLE::hlindex_read_first(uint nr, Item *item, ulonglong limit)
 
   DBUG_ASSERT(hlindex->in_use == in_use);
 
-  return mhnsw_read_first(this, key_info + s->keys, item, limit);
+  return mhnsw_read_first(this, key_info + s->keys, item, limit,
+                          cond, cond_selectivity);
 }
 
 int TABLE::hlindex_read_next()
@@ -1916,6 +1916,8 @@ void Explain_rowid_filter::print_explain_json(Explain_query *query,
   quick->print_json(writer);
   writer->add_member("rows").add_ll(rows);
   writer->add_member("selectivity_pct").add_double(selectivity * 100.0);
+  if (is_bloom_filter)
+    writer->add_member("container").add_str("bloom_filter");
   if (is_analyze)
   {
     writer->add_member("r_rows").add_double(tracker->get_container_elements());
@@ -683,6 +683,9 @@ class Explain_rowid_filter : public Sql_alloc
   /* Expected selectivity for the filter */
   double selectivity;
 
+  /* True if the filter uses a bloom filter container */
+  bool is_bloom_filter;
+
   /* Tracker with the information about how rowid filter is executed */
   Rowid_filter_tracker *tracker;
 
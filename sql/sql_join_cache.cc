@@ -3285,7 +3285,7 @@ bool JOIN_CACHE_HASHED::key_search(uchar *key, uint key_len,
 */
 
 inline
-uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+ulong JOIN_CACHE_HASHED::get_hash_simple(uchar* key, uint key_len)
 {
   ulong nr= 1;
   ulong nr2= 4;
@@ -3296,7 +3296,13 @@ uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
     nr^= (ulong) ((((uint) nr & 63)+nr2)*((uint) *pos))+ (nr << 8);
     nr2+= 3;
   }
-  return nr % hash_entries;
+  return nr;
+}
+
+inline
+uint JOIN_CACHE_HASHED::get_hash_idx_simple(uchar* key, uint key_len)
+{
+  return get_hash_simple(key, key_len) % hash_entries;
 }
 
 
@@ -3331,6 +3337,35 @@ uint JOIN_CACHE_HASHED::get_hash_idx_complex(uchar *key, uint key_len)
 }
 
 
+/*
+  Get the number of the partition a key value belongs to
+
+  SYNOPSIS
+    get_partition_idx()
+      key             pointer to the key value
+      parts           number of partitions
+
+  DESCRIPTION
+    The function calculates the partition number for the given key in
+    the grace hash join mode. It uses the same hash values as the hash
+    table of the join buffer, so equal keys always get into the same
+    partition. The hash value is scrambled before taking the remainder
+    in order for the records of one partition to be spread over all
+    entries of the hash table when the partition is loaded.
+
+  RETURN VALUE
+    the number of the partition in the range [0, parts)
+*/
+
+uint JOIN_CACHE_HASHED::get_partition_idx(uchar *key, uint parts)
+{
+  ulonglong nr= hash_func == &JOIN_CACHE_HASHED::get_hash_idx_complex ?
+                key_hashnr(ref_key_info, ref_used_key_parts, key) :
+                get_hash_simple(key, key_length);
+  return (uint) (((nr * 0x9E3779B97F4A7C15ULL) >> 32) % parts);
+}
+
+
 /* 
   Compare two key entries in the hash table as sequence of bytes
 
@@ -3626,6 +3661,87 @@ void JOIN_TAB_SCAN::close()
 }
 
 
+/*
+  Prepare to iterate over the spilled records of the joined table
+
+  SYNOPSIS
+    open()
+
+  DESCRIPTION
+    The function prepares the temporary files of the partitions set by
+    set_partitions() for reading from their beginning.
+
+  RETURN VALUE
+    0            the initiation is a success
+    error code   otherwise
+*/
+
+int JOIN_TAB_SCAN_SPILLED::open()
+{
+  save_or_restore_used_tabs(join_tab, FALSE);
+  join_tab->tracker->r_scans++;
+  join_tab->table->null_row= 0;
+  for (uint part= curr_part; part <= last_part; part++)
+  {
+    if (reinit_io_cache(files + part, READ_CACHE, 0L, 0, 0))
+      return 1;
+  }
+  return 0;
+}
+
+
+/*
+  Read the next spilled record of the joined table
+
+  SYNOPSIS
+    next()
+
+  DESCRIPTION
+    The function reads the next record of join_tab from the files of the
+    current range of partitions into the record buffer of join_tab.
+    The records have been already checked against the condition pushed
+    to join_tab when they were written into the files.
+
+  RETURN VALUE
+    0            the next record exists and has been successfully read
+    -1           there are no more records
+    1            an error occurred
+*/
+
+int JOIN_TAB_SCAN_SPILLED::next()
+{
+  TABLE *table= join_tab->table;
+  for ( ; curr_part <= last_part; curr_part++)
+  {
+    if (!my_b_read(files + curr_part, table->record[0], table->s->reclength))
+    {
+      join_tab->tracker->r_rows++;
+      join_tab->tracker->r_rows_after_where++;
+      return 0;
+    }
+    if (files[curr_part].error == -1)
+      return 1;
+  }
+  return -1;
+}
+
+
+/*
+  Perform finalizing actions for a scan over the spilled records
+
+  SYNOPSIS
+    close()
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_TAB_SCAN_SPILLED::close()
+{
+  save_or_restore_used_tabs(join_tab, TRUE);
+}
+
+
 /*
   Prepare to iterate over the BNL join cache buffer to look for matches 
 
@@ -3962,10 +4078,465 @@ int JOIN_CACHE_BNLH::init(bool for_explain)
   if (!(join_tab_scan= new JOIN_TAB_SCAN(join, join_tab)))
     DBUG_RETURN(1);
 
+  spill_parts= (uint) join->thd->variables.join_buff_spill_partitions;
+
   DBUG_RETURN(JOIN_CACHE_HASHED::init(for_explain));
 }
 
 
+/* Size of the buffer of each temporary file used by the grace hash join */
+static constexpr size_t spill_file_buff_size= 4*IO_SIZE;
+
+
+/*
+  Add a record into the buffer of the BNLH join cache
+
+  SYNOPSIS
+    put_record()
+
+  DESCRIPTION
+    This implementation of the virtual function put_record additionally
+    to what JOIN_CACHE_HASHED::put_record does remembers whether the
+    buffer has been filled up. join_records() uses this to tell a refill
+    of the join buffer from the end of the records to be joined.
+
+  RETURN VALUE
+    TRUE    if it has been decided that it should be the last record
+            in the join buffer,
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::put_record()
+{
+  return buffer_is_full= JOIN_CACHE_HASHED::put_record();
+}
+
+
+/*
+  Check whether the grace hash join mode can be used by the BNLH cache
+
+  SYNOPSIS
+    can_spill()
+
+  DESCRIPTION
+    Records are moved between the join buffer and temporary files as the
+    images of the record buffers of the tables they are built from.
+    That's why the mode is not used when the records refer to other join
+    buffers or are referred from them, when the records need match flags,
+    blob data or rowids, and when join_tab has blobs.
+
+  RETURN VALUE
+    TRUE    the mode can be used
+    FALSE   otherwise
+*/
+
+bool JOIN_CACHE_BNLH::can_spill()
+{
+  if (!spill_parts || get_join_alg() != BNLH_JOIN_ALG ||
+      prev_cache || next_cache || with_match_flag || blobs ||
+      join_tab->first_inner || join_tab->first_sj_inner_tab ||
+      join_tab->bush_root_tab || join_tab->keep_current_rowid ||
+      join_tab->check_only_first_match() ||
+      join_tab->table->s->blob_fields)
+    return FALSE;
+
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    if (tab->keep_current_rowid)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+
+/*
+  Open the temporary files of the partitions for the grace hash join mode
+
+  SYNOPSIS
+    open_spill_files()
+
+  DESCRIPTION
+    The function opens two temporary files per partition: one for the
+    records from the join buffer and one for the records of join_tab.
+    A file is actually created only when its data do not fit into the
+    buffer of the file.
+
+  RETURN VALUE
+    FALSE   the files have been successfully opened
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::open_spill_files()
+{
+  THD *thd= join->thd;
+
+  if (!build_files)
+  {
+    if (!(build_files= thd->calloc<IO_CACHE>(spill_parts*2)))
+      return TRUE;
+    probe_files= build_files + spill_parts;
+    if (!(spill_scan= new JOIN_TAB_SCAN_SPILLED(join, join_tab, probe_files)))
+      return TRUE;
+    size_t len= 0;
+    for (JOIN_TAB *tab= start_tab; tab != join_tab;
+         tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+      len+= tab->table->s->reclength + 1;
+    if (!(last_rec_image= (uchar *) thd->alloc(len)))
+      return TRUE;
+  }
+
+  for (uint i= 0; i < spill_parts*2; i++)
+  {
+    if (open_cached_file(build_files + i, mysql_tmpdir, TEMP_PREFIX,
+                         spill_file_buff_size, MYF(MY_WME)))
+      return TRUE;
+  }
+  return FALSE;
+}
+
+
+/*
+  Close the temporary files of the partitions
+
+  SYNOPSIS
+    close_spill_files()
+
+  RETURN VALUE
+    none
+*/
+
+void JOIN_CACHE_BNLH::close_spill_files()
+{
+  if (build_files)
+  {
+    for (uint i= 0; i < spill_parts*2; i++)
+      close_cached_file(build_files + i);
+  }
+  spilled= FALSE;
+}
+
+
+/*
+  Move all records from the join buffer into the partition files
+
+  SYNOPSIS
+    spill_buffer()
+
+  DESCRIPTION
+    The function reads the records from the join buffer into the record
+    buffers of the tables, builds the join key for each of them in the same
+    way as put_record() does, and writes the record buffers into the file
+    of the partition the key belongs to. After this the buffer is reset
+    for writing.
+
+  RETURN VALUE
+    FALSE   the records have been successfully written
+    TRUE    otherwise
+*/
+
+bool JOIN_CACHE_BNLH::spill_buffer()
+{
+  TABLE_REF *ref= &join_tab->ref;
+
+  reset(FALSE);
+  for (size_t cnt= records; cnt; cnt--)
+  {
+    get_record();
+    cp_buffer_from_ref(join->thd, join_tab->table, ref);
+    IO_CACHE *file= build_files + get_partition_idx(ref->key_buff,
+                                                    spill_parts);
+    for (JOIN_TAB *tab= start_tab; tab != join_tab;
+         tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+    {
+      TABLE *table= tab->table;
+      uchar null_row= table->null_row;
+      if (my_b_write(file, table->record[0], table->s->reclength) ||
+          my_b_write(file, &null_row, 1))
+        return TRUE;
+    }
+  }
+  reset(TRUE);
+  spilled= TRUE;
+  return FALSE;
+}
+
+
+/*
+  Save or restore the images of the current partial join record
+
+  SYNOPSIS
+    save_last_record_image()
+      restore   TRUE to copy the saved images back into the record buffers
+
+  DESCRIPTION
+    When join_records() is called with skip_last the current partial join
+    record is not in the join buffer, but the caller extends it after the
+    call. Joining the spilled partitions overwrites the record buffers of
+    the tables, so the function keeps their images in the same format as
+    spill_buffer() writes them.
+*/
+
+void JOIN_CACHE_BNLH::save_last_record_image(bool restore)
+{
+  uchar *pos= last_rec_image;
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    size_t len= table->s->reclength;
+    if (restore)
+    {
+      memcpy(table->record[0], pos, len);
+      table->null_row= pos[len];
+    }
+    else
+    {
+      memcpy(pos, table->record[0], len);
+      pos[len]= table->null_row;
+    }
+    pos+= len + 1;
+  }
+}
+
+
+/*
+  Read the next record written by spill_buffer() into the record buffers
+
+  SYNOPSIS
+    read_spilled_record()
+      file    the file of the partition to read from
+
+  RETURN VALUE
+    FALSE   the record has been successfully read
+    TRUE    there are no more records in the file or an error occurred
+*/
+
+bool JOIN_CACHE_BNLH::read_spilled_record(IO_CACHE *file)
+{
+  for (JOIN_TAB *tab= start_tab; tab != join_tab;
+       tab= next_linear_tab(join, tab, WITHOUT_BUSH_ROOTS))
+  {
+    TABLE *table= tab->table;
+    uchar null_row;
+    if (my_b_read(file, table->record[0], table->s->reclength) ||
+        my_b_read(file, &null_row, 1))
+      return TRUE;
+    table->null_row= null_row;
+  }
+  return FALSE;
+}
+
+
+/*
+  Partition the records of the joined table by the join key
+
+  SYNOPSIS
+    partition_join_tab()
+
+  DESCRIPTION
+    The function scans join_tab once, exactly as join_matching_records()
+    would do it, and writes each record that meets the condition pushed
+    to join_tab into the file of the partition its join key belongs to.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::partition_join_tab()
+{
+  int error;
+  enum_nested_loop_state rc= NESTED_LOOP_OK;
+  TABLE *table= join_tab->table;
+  KEY *keyinfo= join_tab->get_keyinfo_by_key_no(join_tab->ref.key);
+  table->null_row= 0;
+
+  if ((rc= join_tab_execution_startup(join_tab)) < 0)
+    return rc;
+
+  if (join_tab->need_to_build_rowid_filter &&
+      join_tab->build_range_rowid_filter())
+    return NESTED_LOOP_ERROR;
+
+  if (likely(!(error= join_tab_scan->open())))
+  {
+    while (!(error= join_tab_scan->next()))
+    {
+      if (unlikely(join->thd->check_killed()))
+      {
+        rc= NESTED_LOOP_KILLED;
+        break;
+      }
+      key_copy(key_buff, table->record[0], keyinfo, key_length, TRUE);
+      IO_CACHE *file= probe_files + get_partition_idx(key_buff, spill_parts);
+      if (my_b_write(file, table->record[0], table->s->reclength))
+      {
+        error= 1;
+        break;
+      }
+    }
+  }
+  join_tab_scan->close();
+  if (rc == NESTED_LOOP_OK && error > 0)
+    rc= NESTED_LOOP_ERROR;
+  return rc;
+}
+
+
+/*
+  Join the records in the join buffer with records of some partitions
+
+  SYNOPSIS
+    join_partitions()
+      from    the first partition whose join_tab records are to be joined
+      to      the last partition whose join_tab records are to be joined
+
+  DESCRIPTION
+    The function calls JOIN_CACHE::join_records() with the scan over the
+    spilled records of join_tab from the partitions [from, to] used instead
+    of the scan over join_tab itself. After this the join buffer is empty.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_partitions(uint from, uint to)
+{
+  JOIN_TAB_SCAN *save_scan= join_tab_scan;
+  spill_scan->set_partitions(from, to);
+  join_tab_scan= spill_scan;
+  enum_nested_loop_state rc= JOIN_CACHE::join_records(FALSE);
+  join_tab_scan= save_scan;
+  return rc;
+}
+
+
+/*
+  Join all records that have been spilled into the partition files
+
+  SYNOPSIS
+    join_spilled_records()
+
+  DESCRIPTION
+    The function partitions the records of join_tab, then loads the
+    partitions of records spilled from the join buffer back into the buffer
+    in turn, as many of them as the buffer can take at once. Each time the
+    buffer is full it is joined with the join_tab records of the loaded
+    partitions. If a partition does not fit into the buffer the rest of its
+    records is loaded with the next portion, so it is joined with its
+    join_tab records more than once, but each time with a different part
+    of its records.
+    Whatever happens, all partition files are closed at the end.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_spilled_records()
+{
+  enum_nested_loop_state rc;
+  uint first= 0;
+
+  if ((rc= partition_join_tab()) != NESTED_LOOP_OK)
+    goto finish;
+
+  for (uint part= 0; part < spill_parts; part++)
+  {
+    IO_CACHE *file= build_files + part;
+    if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    {
+      rc= NESTED_LOOP_ERROR;
+      goto finish;
+    }
+    while (!read_spilled_record(file))
+    {
+      if (!JOIN_CACHE_HASHED::put_record())
+        continue;
+      rc= join_partitions(first, part);
+      if (rc != NESTED_LOOP_OK && rc != NESTED_LOOP_NO_MORE_ROWS)
+        goto finish;
+      first= part;
+    }
+    if (file->error == -1)
+    {
+      rc= NESTED_LOOP_ERROR;
+      goto finish;
+    }
+  }
+  if (records)
+    rc= join_partitions(first, spill_parts-1);
+
+finish:
+  close_spill_files();
+  reset(TRUE);
+  return rc;
+}
+
+
+/*
+  Join records from the join buffer with records from the next join table
+
+  SYNOPSIS
+    join_records()
+      skip_last    do not look for matches for the last partial join record
+
+  DESCRIPTION
+    This implementation of the virtual function join_records implements
+    the grace hash join mode. When the join buffer is filled up for the
+    first time and the mode can be used, the records are moved from the
+    buffer into the partition files instead of being joined, and so are
+    the records of all the following refills. After the last record has
+    been put into the buffer all spilled records are joined partition by
+    partition, so that join_tab is scanned only once.
+    If skip_last is set after the records have been spilled, the current
+    partial join record is not in the buffer and is extended by the caller.
+    The buffer is then spilled and all partitions are joined as well, while
+    the images of the current record are kept aside and restored at the end.
+    Otherwise the function just calls JOIN_CACHE::join_records.
+
+  RETURN VALUE
+    return one of enum_nested_loop_state
+*/
+
+enum_nested_loop_state JOIN_CACHE_BNLH::join_records(bool skip_last)
+{
+  bool is_full= buffer_is_full;
+  buffer_is_full= FALSE;
+
+  if (skip_last ? !spilled : !(spilled || (is_full && can_spill())))
+    return JOIN_CACHE::join_records(skip_last);
+
+  if (skip_last)
+    save_last_record_image(FALSE);
+
+  if ((!spilled && open_spill_files()) || spill_buffer())
+  {
+    close_spill_files();
+    reset(TRUE);
+    return NESTED_LOOP_ERROR;
+  }
+
+  if (is_full && !skip_last)
+    return NESTED_LOOP_OK;
+
+  enum_nested_loop_state rc= join_spilled_records();
+  if (skip_last)
+    save_last_record_image(TRUE);
+  return rc;
+}
+
+
+/*
+  Free the join buffer and close the partition files if they are open
+*/
+
+void JOIN_CACHE_BNLH::free()
+{
+  close_spill_files();
+  JOIN_CACHE::free();
+}
+
+
 /* 
   Calculate the increment of the MRR buffer for a record write       
 
@@ -62,6 +62,7 @@ typedef struct st_cache_field {
 
 
 class JOIN_TAB_SCAN;
+class JOIN_TAB_SCAN_SPILLED;
 
 class EXPLAIN_BKA_TYPE;
 
@@ -671,7 +672,10 @@ class JOIN_CACHE :public Sql_alloc
   }
      
   /* Join records from the join buffer with records from the next join table */ 
-  enum_nested_loop_state join_records(bool skip_last);
+  virtual enum_nested_loop_state join_records(bool skip_last);
+
+  /* Shall return TRUE if records have been moved out of the join buffer */
+  virtual bool is_spilled() { return FALSE; }
 
   /* Add a comment on the join algorithm employed by the join cache */
   virtual bool save_explain_data(EXPLAIN_BKA_TYPE *explain);
@@ -680,7 +684,7 @@ class JOIN_CACHE :public Sql_alloc
 
   virtual ~JOIN_CACHE() = default;
   void reset_join(JOIN *j) { join= j; }
-  void free()
+  virtual void free()
   { 
     my_free(buff);
     buff= 0;
@@ -803,6 +807,7 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* The offset of the data fields from the beginning of the record fields */
   uint data_fields_offset;
 
+  inline ulong get_hash_simple(uchar *key, uint key_len);
   inline uint get_hash_idx_simple(uchar *key, uint key_len);
   inline uint get_hash_idx_complex(uchar *key, uint key_len);
 
@@ -984,6 +989,9 @@ class JOIN_CACHE_HASHED: public JOIN_CACHE
   /* Search for a key in the hash table of the join buffer */
   bool key_search(uchar *key, uint key_len, uchar **key_ref_ptr);
 
+  /* Get the number of the partition a key value belongs to */
+  uint get_partition_idx(uchar *key, uint parts);
+
   /* Reallocate the join buffer of a hashed join cache */
   int realloc_buffer() override;
 
@@ -1098,6 +1106,35 @@ class JOIN_TAB_SCAN: public Sql_alloc
 
 };
 
+/*
+  The class JOIN_TAB_SCAN_SPILLED is a companion class for the class
+  JOIN_CACHE_BNLH used in the grace hash join mode. It iterates over the
+  records of join_tab that have been written into the temporary files of
+  the partitions from the range set by set_partitions() and restores them
+  in the record buffer of join_tab.
+*/
+
+class JOIN_TAB_SCAN_SPILLED: public JOIN_TAB_SCAN
+{
+  /* Array of the partition files */
+  IO_CACHE *files;
+  /* The partition currently read and the last partition to read */
+  uint curr_part, last_part;
+
+public:
+
+  JOIN_TAB_SCAN_SPILLED(JOIN *j, JOIN_TAB *tab, IO_CACHE *f)
+    :JOIN_TAB_SCAN(j, tab), files(f), curr_part(0), last_part(0) {}
+
+  void set_partitions(uint from, uint to) { curr_part= from; last_part= to; }
+
+  int open() override;
+
+  int next() override;
+
+  void close() override;
+};
+
 /*
   The class JOIN_CACHE_BNL is used when the BNL join algorithm is
   employed to perform a join operation   
@@ -1190,6 +1227,39 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
 
   void read_next_candidate_for_match(uchar *rec_ptr) override;
 
+  /*
+    The members below support the grace hash join mode. When the records
+    to be joined do not fit into the join buffer they are partitioned by
+    the join key into temporary files, together with the records of
+    join_tab. Then each partition of records is loaded into the join buffer
+    and joined only with the join_tab records of the same partition.
+  */
+
+  /* Number of partitions, 0 if the mode is not used */
+  uint spill_parts;
+  /* Set by put_record() when the join buffer has been filled up */
+  bool buffer_is_full;
+  /* TRUE if records have been moved from the join buffer to build_files */
+  bool spilled;
+  /* Partial join records partitioned by the join key */
+  IO_CACHE *build_files;
+  /* Records of join_tab partitioned by the join key */
+  IO_CACHE *probe_files;
+  /* The scan over probe_files that replaces join_tab_scan for partitions */
+  JOIN_TAB_SCAN_SPILLED *spill_scan;
+  /* Saved images of the current partial join record for skip_last */
+  uchar *last_rec_image;
+
+  bool can_spill();
+  bool open_spill_files();
+  void close_spill_files();
+  bool spill_buffer();
+  void save_last_record_image(bool restore);
+  enum_nested_loop_state partition_join_tab();
+  bool read_spilled_record(IO_CACHE *file);
+  enum_nested_loop_state join_partitions(uint from, uint to);
+  enum_nested_loop_state join_spilled_records();
+
 public:
 
   /* 
@@ -1197,7 +1267,10 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     used to join table 'tab' to the result of joining the previous tables 
     specified by the 'j' parameter.
   */   
-  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab) : JOIN_CACHE_HASHED(j, tab) {}
+  JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab)
+    : JOIN_CACHE_HASHED(j, tab), spill_parts(0), buffer_is_full(FALSE),
+      spilled(FALSE), build_files(0), probe_files(0), spill_scan(0),
+      last_rec_image(0) {}
 
   /* 
     This constructor creates a linked BNLH join cache. The cache is to be 
@@ -1206,11 +1279,21 @@ class JOIN_CACHE_BNLH :public JOIN_CACHE_HASHED
     cache object to which this cache is linked.
   */   
   JOIN_CACHE_BNLH(JOIN *j, JOIN_TAB *tab, JOIN_CACHE *prev) 
-    : JOIN_CACHE_HASHED(j, tab, prev) {}
+    : JOIN_CACHE_HASHED(j, tab, prev), spill_parts(0), buffer_is_full(FALSE),
+      spilled(FALSE), build_files(0), probe_files(0), spill_scan(0),
+      last_rec_image(0) {}
 
   /* Initialize the BNLH cache */       
   int init(bool for_explain) override;
 
+  bool put_record() override;
+
+  enum_nested_loop_state join_records(bool skip_last) override;
+
+  void free() override;
+
+  bool is_spilled() override { return spilled; }
+
   enum Join_algorithm get_join_alg() override { return BNLH_JOIN_ALG; }
 
   bool is_key_access() override { return TRUE; }
@@ -0,0 +1,123 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+#include "mariadb.h"
+#include "sql_parallel.h"
+#include <my_sys.h>
+#include <tpool.h>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+static tpool::thread_pool *parallel_pool;
+
+
+void parallel_tasks_init()
+{
+  DBUG_ASSERT(!parallel_pool);
+  parallel_pool= tpool::create_thread_pool_generic(1, MY_MAX(my_getncpus(), 4));
+  if (parallel_pool)
+    parallel_pool->set_thread_callbacks([]() { my_thread_init(); },
+                                        []() { my_thread_end(); });
+}
+
+
+void parallel_tasks_end()
+{
+  delete parallel_pool;
+  parallel_pool= nullptr;
+}
+
+
+/*
+  Every submitted task, and the calling thread, take the numbers of the
+  parts to compute from a shared counter, so the caller does all the
+  work that the pool has not got to yet. The pool releases a task after
+  running it; the caller returns when all submitted tasks are released.
+*/
+
+namespace
+{
+class Parallel_run
+{
+  const std::function<void(uint)> &func;
+  const uint count;
+  std::atomic<uint> next{0};
+  std::mutex mutex;
+  std::condition_variable cond;
+  uint pending= 0;
+
+  class Task : public tpool::task
+  {
+  public:
+    Parallel_run *owner;
+    Task() : tpool::task(work, this) {}
+    void release() override { owner->task_done(); }
+  };
+
+  static void work(void *arg) { static_cast<Task*>(arg)->owner->work(); }
+
+  void task_done()
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    if (!--pending)
+      cond.notify_one();
+  }
+
+public:
+  Parallel_run(const std::function<void(uint)> &func, uint count)
+    : func(func), count(count) {}
+
+  void work()
+  {
+    for (uint i; (i= next++) < count; )
+      func(i);
+  }
+
+  void run(tpool::thread_pool *pool)
+  {
+    Task tasks[64];
+    uint n_tasks= MY_MIN(count - 1, (uint) array_elements(tasks));
+    pending= n_tasks;
+    for (uint i= 0; i < n_tasks; i++)
+    {
+      tasks[i].owner= this;
+      pool->submit_task(tasks + i);
+    }
+    work();
+    std::unique_lock<std::mutex> lk(mutex);
+    while (pending)
+      cond.wait(lk);
+  }
+};
+}
+
+
+/**
+  Call task(0) ... task(count-1) in parallel, return when all are done
+
+  The calling thread works too, the parts are not bound to threads.
+*/
+
+void run_parallel_tasks(uint count, const std::function<void(uint)> &task)
+{
+  if (count <= 1 || !parallel_pool)
+  {
+    for (uint i= 0; i < count; i++)
+      task(i);
+    return;
+  }
+  Parallel_run(task, count).run(parallel_pool);
+}
@@ -0,0 +1,34 @@
+/* Copyright (c) 2026, MariaDB
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335  USA */
+
+#ifndef SQL_PARALLEL_INCLUDED
+#define SQL_PARALLEL_INCLUDED
+
+#include <functional>
+
+/**
+  @file
+
+  @brief
+  A thread pool for the parts of a statement that can be computed
+  in parallel, like sorting a filesort buffer or building a vector index.
+  The threads do not have a THD.
+*/
+
+void parallel_tasks_init();
+void parallel_tasks_end();
+void run_parallel_tasks(uint count, const std::function<void(uint)> &task);
+
+#endif /* SQL_PARALLEL_INCLUDED */
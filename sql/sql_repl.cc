@@ -154,6 +154,9 @@ struct binlog_send_info {
   /** last pos for error message */
   my_off_t last_pos;
 
+  /** events sent from mysql_bin_log.dump_cache, or read from the file */
+  ulong dump_cache_hit, dump_cache_miss;
+
 #ifndef DBUG_OFF
   int left_events;
   uint dbug_reconnect_counter;
@@ -176,6 +179,7 @@ struct binlog_send_info {
       error(0),
       errmsg("Unknown error"),
       heartbeat_period(0),
+      dump_cache_hit(0), dump_cache_miss(0),
 #ifndef DBUG_OFF
       left_events(max_binlog_dump_events),
       dbug_reconnect_counter(0),
@@ -2177,6 +2181,18 @@ send_event_to_slave(binlog_send_info *info, Log_event_type event_type,
     }
   }
 
+  /*
+    A compressed transaction can not be left out or replaced, so slaves that
+    do not understand it can not continue.
+  */
+  if (event_type == TRANSACTION_COMPRESSED_EVENT &&
+      mariadb_slave_capability < MARIA_SLAVE_CAPABILITY_TRANSACTION_COMPRESSED)
+  {
+    info->error= ER_MASTER_FATAL_ERROR_READING_BINLOG;
+    return "Found a Transaction_compressed event, which the slave does not "
+           "understand; set binlog_transaction_compression=NONE on the master";
+  }
+
   /*
     Replace GTID events with old-style BEGIN events for slaves that do not
     understand global transaction IDs. For stand-alone events, where there is
@@ -2926,15 +2942,38 @@ static int send_events(binlog_send_info *info, IO_CACHE* log, LOG_INFO* linfo,
       return 1;
 
     info->last_pos= linfo->pos;
-    error= Log_event::read_log_event(log, packet, info->fdev,
-                       opt_master_verify_checksum ? info->current_checksum_alg
-                                                  : BINLOG_CHECKSUM_ALG_OFF);
-    linfo->pos= my_b_tell(log);
-
-    if (unlikely(error))
+    if (binlog_dump_cache_size &&
+        mysql_bin_log.dump_cache.read_event(linfo->log_file_name, linfo->pos,
+                                            packet))
     {
-      set_read_error(info, error);
-      return 1;
+      /* The event was copied from memory; skip over it in the file. */
+      linfo->pos+= packet->length() - ev_offset;
+      my_b_seek(log, linfo->pos);
+      info->dump_cache_hit++;
+    }
+    else
+    {
+      error= Log_event::read_log_event(log, packet, info->fdev,
+                         opt_master_verify_checksum ? info->current_checksum_alg
+                                                    : BINLOG_CHECKSUM_ALG_OFF);
+      linfo->pos= my_b_tell(log);
+
+      if (unlikely(error))
+      {
+        set_read_error(info, error);
+        return 1;
+      }
+      if (binlog_dump_cache_size)
+      {
+        /* Let the other dump threads copy the event from memory. */
+        mysql_bin_log.dump_cache.add_event(linfo->log_file_name,
+                                           info->last_pos,
+                                           (const uchar*) packet->ptr() +
+                                           ev_offset,
+                                           packet->length() - ev_offset,
+                                           opt_master_verify_checksum);
+        info->dump_cache_miss++;
+      }
     }
 
   Log_event_type event_type= static_cast<Log_event_type>(
@@ -3064,7 +3103,15 @@ static int send_one_binlog_file(binlog_send_info *info,
     /**
      * send events from current position up to end_pos
      */
-    if (send_events(info, log, linfo, end_pos))
+    int error= send_events(info, log, linfo, end_pos);
+    if (info->dump_cache_hit || info->dump_cache_miss)
+    {
+      statistic_add(binlog_dump_cache_hit, info->dump_cache_hit, &LOCK_status);
+      statistic_add(binlog_dump_cache_miss, info->dump_cache_miss,
+                    &LOCK_status);
+      info->dump_cache_hit= info->dump_cache_miss= 0;
+    }
+    if (error)
       return 1;
   }
 
@@ -8448,6 +8448,7 @@ apply_filter(THD *thd, TABLE *table, ALL_READ_COST *cost,
   double new_cost, org_cost, records= *records_arg, new_records;
   double filter_startup_cost= get_setup_cost();
   double filter_lookup_cost= records * lookup_cost();
+  double pass_ratio= filter_pass_ratio();
   double tmp;
   ALL_READ_COST adjusted_cost;
 
@@ -8475,10 +8476,13 @@ apply_filter(THD *thd, TABLE *table, ALL_READ_COST *cost,
   */
 
   adjusted_cost= *cost;
-  /* We are going to read 'selectivity' fewer rows */
-  adjusted_cost.row_cost.io*= selectivity;
-  adjusted_cost.row_cost.cpu*= selectivity;
-  adjusted_cost.copy_cost*= selectivity;        // Cost of copying row or key
+  /*
+    We are going to read 'pass_ratio' fewer rows. This is the same as
+    'selectivity' unless the container can have false positives.
+  */
+  adjusted_cost.row_cost.io*= pass_ratio;
+  adjusted_cost.row_cost.cpu*= pass_ratio;
+  adjusted_cost.copy_cost*= pass_ratio;         // Cost of copying row or key
   adjusted_cost.index_cost.cpu+= filter_lookup_cost;
 
   tmp= prev_records * WHERE_COST_THD(thd);
@@ -8488,7 +8492,7 @@ apply_filter(THD *thd, TABLE *table, ALL_READ_COST *cost,
 
   new_cost= (file->cost_for_reading_multiple_times(prev_records,
                                                    &adjusted_cost) +
-             new_records * tmp + filter_startup_cost);
+             records * pass_ratio * tmp + filter_startup_cost);
 
   DBUG_ASSERT(new_cost >= 0 && new_records >= 0);
   use_filter= new_cost < org_cost || is_forced_by_hint;
@@ -22421,9 +22425,19 @@ bool Create_tmp_table::choose_engine(THD *thd, TABLE *table,
   /*
     If result table is small; use a heap, otherwise TMP_TABLE_HTON (Aria)
     In the future we should try making storage engine selection more dynamic
+
+    HEAP can store blobs but not index them, so a group or distinct key
+    over blobs needs Aria.
   */
+  bool blob_key= m_distinct && m_blobs_count[distinct];
+  for (ORDER *cur_group= m_group; cur_group && !blob_key;
+       cur_group= cur_group->next)
+  {
+    Field *field= (*cur_group->item)->get_tmp_table_field();
+    blob_key= field && (field->flags & BLOB_FLAG);
+  }
 
-  if (share->blob_fields || m_using_unique_constraint ||
+  if (blob_key || m_using_unique_constraint ||
       (m_select_options & TMP_TABLE_FORCE_MYISAM) ||
       thd->variables.tmp_memory_table_size == 0)
   {
@@ -24290,7 +24304,14 @@ sub_select_cache(JOIN *join, JOIN_TAB *join_tab, bool end_of_records)
   }
   join_tab->jbuf_loops_tracker->on_scan_init();
 
-  if (!(err= test_if_use_dynamic_range_scan(join_tab)))
+  err= test_if_use_dynamic_range_scan(join_tab);
+  DBUG_EXECUTE_IF("join_cache_skip_last_spilled",
+                  if (!err && cache->is_spilled())
+                  {
+                    err= 1;
+                    DBUG_SET("-d,join_cache_skip_last_spilled");
+                  });
+  if (!err)
   {
     if (!cache->put_record())
       DBUG_RETURN(NESTED_LOOP_OK); 
@@ -25666,9 +25687,19 @@ join_read_first(JOIN_TAB *tab)
     DBUG_ASSERT(order);
     DBUG_ASSERT(order->next == NULL);
     DBUG_ASSERT(order->item[0]->real_item()->type() == Item::FUNC_ITEM);
+    /*
+      records_out can be cut by the LIMIT, the selectivity of the
+      conditions on the table is what the search has to compensate for
+    */
+    Item *cond= tab->select_cond;
+    double selectivity= table->cond_selectivity;
+    if (!cond || selectivity > HLINDEX_PUSHED_COND_MAX_SELECTIVITY ||
+        cond->with_subquery() || cond->is_expensive())
+      cond= NULL;
     tab->read_record.read_record_func= join_hlindex_read_next;
     error= tab->table->hlindex_read_first(tab->index, *order->item,
-                                          tab->join->select_limit);
+                                          tab->join->select_limit,
+                                          cond, selectivity);
   }
   else
   {
@@ -28261,8 +28292,8 @@ JOIN_TAB::remove_duplicates()
   table->file->info(HA_STATUS_VARIABLE);
   table->reginfo.lock_type=TL_WRITE;
 
-  if (table->s->db_type() == heap_hton ||
-      (!table->s->blob_fields &&
+  if (!table->s->blob_fields &&
+      (table->s->db_type() == heap_hton ||
        ((ALIGN_SIZE(keylength) + HASH_OVERHEAD) * table->file->stats.records <
 	thd->variables.sortbuff_size)))
     error= remove_dup_with_hash_index(join->thd, table, field_count,
@@ -31032,6 +31063,8 @@ bool JOIN_TAB::save_explain_data(Explain_table_access *eta,
     Explain_rowid_filter *erf= new (thd->mem_root) Explain_rowid_filter;
     erf->quick= quick->get_explain(thd->mem_root);
     erf->selectivity= range_rowid_filter_info->selectivity;
+    erf->is_bloom_filter= (range_rowid_filter_info->container_type ==
+                           BLOOM_FILTER_CONTAINER);
     erf->rows= quick->records;
     if (!(erf->tracker= new Rowid_filter_tracker(thd->lex->analyze_stmt)))
       return 1;
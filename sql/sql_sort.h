@@ -562,6 +562,8 @@ class Sort_param {
   uint min_dupl_count;
   ha_rows limit_rows;         // Select limit, or HA_POS_ERROR if unlimited.
   ha_rows examined_rows;      // Number of examined rows.
+  uint max_sort_threads;      // Threads allowed to sort a buffer
+  uint used_sort_threads;     // Most threads that sorted or merged
   TABLE *sort_form;           // For quicker make_sortkey.
   /**
     ORDER BY list with some precalculated info for filesort.
@@ -2766,7 +2766,13 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
 
   if (thd->variables.sample_percentage == 0)
   {
-    if (file->records() < MIN_THRESHOLD_FOR_SAMPLING)
+    /*
+      An estimate is enough here, records() may count the rows or
+      return HA_POS_ERROR
+    */
+    file->info(HA_STATUS_VARIABLE | HA_STATUS_NO_LOCK);
+    const ha_rows total_rows= file->stats.records;
+    if (total_rows < MIN_THRESHOLD_FOR_SAMPLING)
     {
       sample_fraction= 1;
     }
@@ -2774,7 +2780,7 @@ int collect_statistics_for_table(THD *thd, TABLE *table)
     {
       sample_fraction= std::fmin(
                   (MIN_THRESHOLD_FOR_SAMPLING + 4096 *
-                   log(200 * file->records())) / file->records(), 1);
+                   log(200 * total_rows)) / total_rows, 1);
     }
   }
 
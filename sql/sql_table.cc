@@ -12784,6 +12784,11 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
 
   to->file->prepare_for_modify(true, false);
   DBUG_ASSERT(to->file->inited == handler::NONE);
+  if (int hl_error= to->hlindexes_bulk_start())
+  {
+    to->file->print_error(hl_error, MYF(0));
+    goto err;
+  }
 
   /* Tell handler that we have values for all columns in the to table */
   to->use_all_columns();
@@ -12801,7 +12806,9 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   restore_record(to, s->default_values);        // Create empty record
   to->reset_default_fields();
 
-  thd->progress.max_counter= from->file->records();
+  /* Only an estimate is needed, records() may count the rows */
+  from->file->info(HA_STATUS_VARIABLE | HA_STATUS_NO_LOCK);
+  thd->progress.max_counter= from->file->stats.records;
   time_to_report_progress= MY_HOW_OFTEN_TO_WRITE/10;
   /* for now, InnoDB needs the undo log for ALTER IGNORE */
   if (!ignore && !to->s->hlindexes())
@@ -12983,6 +12990,13 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
   THD_STAGE_INFO(thd, stage_enabling_keys);
   thd_progress_next_stage(thd);
 
+  if (int hl_error= to->hlindexes_bulk_end(error > 0))
+  {
+    if (!thd->is_error())
+      to->file->print_error(hl_error, MYF(0));
+    error= 1;
+  }
+
   if (bulk_insert_started && to->file->ha_end_bulk_insert() && error <= 0)
   {
     /* Give error, if not already given */
@@ -13118,6 +13132,7 @@ copy_data_between_tables(THD *thd, TABLE *from, TABLE *to,
 end:
   if (bulk_insert_started)
     (void) to->file->ha_end_bulk_insert();
+  (void) to->hlindexes_bulk_end(true);
 
   if (init_read_record_done)
     end_read_record(&info);
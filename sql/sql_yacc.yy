@@ -1181,6 +1181,7 @@ bool my_yyoverflow(short **a, YYSTYPE **b, size_t *yystacksize);
 %token  <kwd>  XML_SYM
 %token  <kwd>  YEAR_SYM                      /* SQL-2003-R */
 %token  <kwd>   ST_COLLECT_SYM
+%token  <kwd>   APPROX_COUNT_DISTINCT_SYM
 /* A dummy token to force the priority of table_ref production in a join. */
 %left   CONDITIONLESS_JOIN
 %left   JOIN_SYM INNER_SYM STRAIGHT_JOIN CROSS LEFT RIGHT ON_SYM USING
@@ -11497,6 +11498,12 @@ sum_expr:
             if (unlikely($$ == NULL))
               MYSQL_YYABORT;
           }
+        | APPROX_COUNT_DISTINCT_SYM '(' in_sum_expr ')'
+          {
+            $$= new (thd->mem_root) Item_sum_approx_count_distinct(thd, $3);
+            if (unlikely($$ == NULL))
+              MYSQL_YYABORT;
+          }
         ;
 
 window_func_expr:
@@ -66,6 +66,7 @@
 #include "rpl_parallel.h"
 #include "semisync_master.h"
 #include "semisync_slave.h"
+#include <providers/lz4.h>
 #include <ssl_compat.h>
 #ifdef WITH_WSREP
 #include "wsrep_mysqld.h"
@@ -2724,6 +2725,75 @@ Sys_binlog_commit_wait_usec(
        VALID_RANGE(0, ULONG_MAX), DEFAULT(100000), BLOCK_SIZE(1));
 
 
+static const char *binlog_transaction_dependency_tracking_names[]=
+  {"COMMIT_ORDER", "WRITESET", NullS};
+static Sys_var_on_access_global<Sys_var_enum,
+            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_TRACKING>
+Sys_binlog_transaction_dependency_tracking(
+       "binlog_transaction_dependency_tracking",
+       "How the dependencies between transactions are recorded in the binary "
+       "log for parallel replication. COMMIT_ORDER (default) records only "
+       "the group commit. WRITESET additionally records in each GTID event "
+       "the latest earlier transaction that modified the same primary or "
+       "unique key values, so that a parallel slave can run transactions "
+       "that do not conflict in parallel without speculation",
+       GLOBAL_VAR(binlog_transaction_dependency_tracking),
+       CMD_LINE(REQUIRED_ARG), binlog_transaction_dependency_tracking_names,
+       DEFAULT(BINLOG_DEPENDENCY_TRACKING_COMMIT_ORDER));
+
+
+static Sys_var_on_access_global<Sys_var_ulong,
+            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_DEPENDENCY_HISTORY_SIZE>
+Sys_binlog_transaction_dependency_history_size(
+       "binlog_transaction_dependency_history_size",
+       "Maximum number of key hash values that are remembered per replication "
+       "domain for binlog_transaction_dependency_tracking=WRITESET. When the "
+       "limit is exceeded, the history is cleared, and the next transactions "
+       "will depend on all transactions before that",
+       GLOBAL_VAR(binlog_transaction_dependency_history_size),
+       CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 1000000), DEFAULT(25000),
+       BLOCK_SIZE(1));
+
+
+static bool check_binlog_transaction_compression(sys_var *self, THD *thd,
+                                                 set_var *var)
+{
+  if (var->save_result.ulonglong_value == BINLOG_TRANSACTION_COMPRESSION_LZ4 &&
+      !provider_service_lz4->is_loaded)
+  {
+    my_error(ER_PROVIDER_NOT_LOADED, MYF(0), "LZ4 compression");
+    return true;
+  }
+  return false;
+}
+
+static const char *binlog_transaction_compression_names[]=
+  {"NONE", "ZLIB", "LZ4", NullS};
+static Sys_var_on_access_global<Sys_var_enum,
+            PRIV_SET_SYSTEM_GLOBAL_VAR_BINLOG_TRANSACTION_COMPRESSION>
+Sys_binlog_transaction_compression(
+       "binlog_transaction_compression",
+       "Compress the row and statement events of each transaction together "
+       "into one event when it is written to the binary log at commit. "
+       "NONE (default) disables this. ZLIB or LZ4 select the algorithm; "
+       "LZ4 requires the provider_lz4 plugin. Slaves must be new enough to "
+       "understand the compressed transactions",
+       GLOBAL_VAR(binlog_transaction_compression),
+       CMD_LINE(REQUIRED_ARG), binlog_transaction_compression_names,
+       DEFAULT(BINLOG_TRANSACTION_COMPRESSION_NONE), NO_MUTEX_GUARD,
+       NOT_IN_BINLOG, ON_CHECK(check_binlog_transaction_compression));
+
+
+static Sys_var_ulong Sys_binlog_dump_cache_size(
+       "binlog_dump_cache_size",
+       "Size of an in-memory copy of the most recently written part of the "
+       "binary log, which the binlog dump threads of slaves and other "
+       "clients read instead of the file when they are not lagging behind. "
+       "0 (default) disables the cache",
+       READ_ONLY GLOBAL_VAR(binlog_dump_cache_size), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, ULONG_MAX), DEFAULT(0), BLOCK_SIZE(IO_SIZE));
+
+
 static bool fix_max_join_size(sys_var *self, THD *thd, enum_var_type type)
 {
   SV *sv= type == OPT_GLOBAL ? &global_system_variables : &thd->variables;
@@ -3713,6 +3783,17 @@ Slave_ddl_exec_mode(
        GLOBAL_VAR(slave_ddl_exec_mode_options), CMD_LINE(REQUIRED_ARG),
        slave_exec_mode_names, DEFAULT(SLAVE_EXEC_MODE_IDEMPOTENT));
 
+static Sys_var_on_access_global<Sys_var_mybool,
+                              PRIV_SET_SYSTEM_GLOBAL_VAR_SLAVE_ROWS_HASH_SCAN>
+Sys_slave_rows_hash_scan(
+       "slave_rows_hash_scan",
+       "Locate the rows of an UPDATE or DELETE row event on a table without "
+       "a unique key by one table scan, matching each table row against a "
+       "hash of the before images of all rows in the event, instead of "
+       "searching the table for every row separately",
+       GLOBAL_VAR(opt_slave_rows_hash_scan), CMD_LINE(OPT_ARG),
+       DEFAULT(TRUE));
+
 static const char *slave_run_triggers_for_rbr_names[]=
   {"NO", "YES", "LOGGING", "ENFORCE", 0};
 static Sys_var_on_access_global<Sys_var_enum,
@@ -3995,6 +4076,18 @@ static Sys_var_ulonglong Sys_sort_buffer(
        VALID_RANGE(MIN_SORT_MEMORY, SIZE_T_MAX), DEFAULT(MAX_SORT_MEMORY),
        BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_filesort_threads(
+       "filesort_threads",
+       "Number of threads that sort the rows collected in the sort buffer. "
+       "The rows are split between the threads and the sorted parts are "
+       "merged by key ranges in parallel. The threads are taken from a pool "
+       "shared by all connections. Sorted chunks that did not fit into the "
+       "sort buffer are written to disk, and their final merge is split by "
+       "key ranges between the threads too, unless the rows have variable "
+       "length or temporary files are encrypted. 1 disables parallel sorting",
+       SESSION_VAR(filesort_threads), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(1, MAX_FILESORT_THREADS), DEFAULT(1), BLOCK_SIZE(1));
+
 export sql_mode_t expand_sql_mode(sql_mode_t sql_mode)
 {
   if (sql_mode & MODE_ANSI)
@@ -4599,6 +4692,18 @@ Sys_threadpool_dedicated_listener(
   GLOBAL_VAR(threadpool_dedicated_listener), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
   NO_MUTEX_GUARD, NOT_IN_BINLOG
 );
+
+static Sys_var_on_access_global<Sys_var_mybool,
+                                PRIV_SET_SYSTEM_GLOBAL_VAR_THREAD_POOL>
+Sys_threadpool_work_stealing(
+  "thread_pool_work_stealing",
+  "If set to 1, a worker thread that would go idle handles a queued "
+  "request from another thread group whose workers are all busy "
+  "(thread_pool_oversubscribe). The connection returns to its own group "
+  "after the request",
+  GLOBAL_VAR(threadpool_work_stealing), CMD_LINE(OPT_ARG), DEFAULT(FALSE),
+  NO_MUTEX_GUARD, NOT_IN_BINLOG
+);
 #endif /* HAVE_POOL_OF_THREADS */
 
 /**
@@ -7123,6 +7228,17 @@ static Sys_var_ulonglong Sys_join_buffer_space_limit(
        VALID_RANGE(2048, ULONGLONG_MAX), DEFAULT(16*128*1024),
        BLOCK_SIZE(2048));
 
+static Sys_var_ulong Sys_join_buffer_spill_partitions(
+       "join_buffer_spill_partitions",
+       "Number of partitions used by the hashed join buffers when the rows "
+       "to join do not fit into join_buffer_size. The rows of both joined "
+       "inputs are then split by the join key into temporary files and the "
+       "partitions are joined one by one, so that the joined table is read "
+       "only once. 0 means the joined table is read again for every refill "
+       "of the join buffer",
+       SESSION_VAR(join_buff_spill_partitions), CMD_LINE(REQUIRED_ARG),
+       VALID_RANGE(0, 1024), DEFAULT(0), BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_progress_report_time(
        "progress_report_time",
        "Seconds between sending progress reports to the client for "
@@ -1399,6 +1399,7 @@ struct TABLE
   TABLE_LIST *internal_tables;
 
   TABLE *hlindex;
+  void *hlindex_bulk;                     /* see hlindexes_bulk_start() */
   /*
     Not-null for temporary tables only. Non-null values means this table is
     used to compute GROUP BY, it has a unique of GROUP BY columns.
@@ -1833,12 +1834,15 @@ struct TABLE
 
   int hlindex_open(uint nr);
   int hlindex_lock(uint nr);
-  int hlindex_read_first(uint nr, Item *item, ulonglong limit);
+  int hlindex_read_first(uint nr, Item *item, ulonglong limit,
+                         Item *cond= NULL, double cond_selectivity= 1);
   int hlindex_read_next();
   int hlindex_read_end();
 
   int open_hlindexes_for_write();
   int hlindexes_on_insert();
+  int hlindexes_bulk_start();
+  int hlindexes_bulk_end(bool abort);
   int hlindexes_on_update();
   int hlindexes_on_delete(const uchar *buf);
   int hlindexes_on_delete_all(bool truncate);
@@ -1985,6 +1989,8 @@ struct TABLE
 
   bool key_can_be_used_as_rowid_filter(THD *thd, uint index) const;
 
+  bool rowid_can_be_hashed() const;
+
   ulonglong vers_start_id(const uchar *ptr) const;
   ulonglong vers_end_id(const uchar *ptr) const;
 #ifdef WITH_PARTITION_STORAGE_ENGINE
@@ -121,6 +121,9 @@ static int  wake_or_create_thread(thread_group_t *thread_group, bool due_to_stal
 static int  create_worker(thread_group_t *thread_group, bool due_to_stall);
 static void *worker_main(void *param);
 static void check_stall(thread_group_t *thread_group);
+static int change_group(TP_connection_generic *c,
+                        thread_group_t *old_group,
+                        thread_group_t *new_group);
 static void set_next_timeout_check(ulonglong abstime);
 static void print_pool_blocked_message(bool);
 
@@ -443,6 +446,20 @@ int io_poll_wait(TP_file_handle pollfd, native_event *events, int maxevents,
 #endif
 
 
+/*
+  Publish the number of queued connections, for steal_connection()
+  which reads it without holding the group mutex.
+*/
+
+static void update_queue_length(thread_group_t *thread_group)
+{
+  mysql_mutex_assert_owner(&thread_group->mutex);
+  thread_group->queue_length=
+    int(thread_group->queues[TP_PRIORITY_HIGH].elements() +
+        thread_group->queues[TP_PRIORITY_LOW].elements());
+}
+
+
 /* Dequeue element from a workqueue */
 
 static TP_connection_generic *queue_get(thread_group_t *thread_group)
@@ -454,7 +471,10 @@ static TP_connection_generic *queue_get(thread_group_t *thread_group)
   {
     c= thread_group->queues[i].pop_front();
     if (c)
+    {
+      update_queue_length(thread_group);
       DBUG_RETURN(c);
+    }
   }
   DBUG_RETURN(0);
 }
@@ -486,6 +506,7 @@ static void queue_init(thread_group_t *thread_group)
   {
     thread_group->queues[i].empty();
   }
+  thread_group->queue_length= 0;
 }
 
 static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt)
@@ -497,6 +518,7 @@ static void queue_put(thread_group_t *thread_group, native_event *ev, int cnt)
     c->enqueue_time= now;
     thread_group->queues[c->priority].push_back(c);
   }
+  update_queue_length(thread_group);
 }
 
 /*
@@ -1125,6 +1147,7 @@ static void queue_put(thread_group_t *thread_group, TP_connection_generic *conne
 
   connection->enqueue_time= threadpool_exact_stats?microsecond_interval_timer():pool_timer.current_microtime;
   thread_group->queues[connection->priority].push_back(connection);
+  update_queue_length(thread_group);
 
   if (thread_group->active_thread_count == 0)
     wake_or_create_thread(thread_group);
@@ -1145,6 +1168,56 @@ static bool too_many_threads(thread_group_t *thread_group)
 }
 
 
+/**
+  Take over a queued connection from another group, whose workers
+  are all busy (thread_pool_work_stealing).
+
+  Only a group that has reached its limit of active threads
+  (too_many_threads()) is a victim; otherwise its own workers will
+  handle the queue soon. The groups are scanned without locking, using
+  queue_length, and a group whose mutex is busy is skipped, so that an
+  idle worker never waits for an overloaded group. The connection is
+  moved to the group of the current worker, like in change_group() after
+  thread_pool_size was changed, so that wait_begin() and wait_end()
+  account for the right group. It is moved back to its own group by
+  start_io() after the current request.
+
+  @param thread_group - group of the current worker
+  @return connection with pending event, or NULL
+*/
+
+static TP_connection_generic *steal_connection(thread_group_t *thread_group)
+{
+  DBUG_ENTER("steal_connection");
+  mysql_mutex_assert_not_owner(&thread_group->mutex);
+  const uint count= group_count;
+  const size_t self= size_t(thread_group - all_groups);
+
+  for (uint i= 1; i < count; i++)
+  {
+    thread_group_t *victim= &all_groups[(self + i) % count];
+    if (victim->queue_length <= 0 || mysql_mutex_trylock(&victim->mutex))
+      continue;
+
+    TP_connection_generic *c= NULL;
+    if (!victim->shutdown && too_many_threads(victim))
+      c= queue_get(victim);
+    if (c)
+      TP_INCREMENT_GROUP_COUNTER(victim, stolen);
+    mysql_mutex_unlock(&victim->mutex);
+
+    if (c)
+    {
+      /* This does not create a thread, as the current worker is there. */
+      change_group(c, victim, thread_group);
+      c->fix_group= true;
+      DBUG_RETURN(c);
+    }
+  }
+  DBUG_RETURN(NULL);
+}
+
+
 /**
   Retrieve a connection with pending event.
 
@@ -1229,6 +1302,26 @@ TP_connection_generic *get_event(worker_thread_t *current_thread,
     }
 
 
+    /*
+      Before going to sleep, help a group that has queued connections
+      while all of its workers are busy.
+    */
+    if (!oversubscribed && threadpool_work_stealing && group_count > 1)
+    {
+      mysql_mutex_unlock(&thread_group->mutex);
+      connection= steal_connection(thread_group);
+      mysql_mutex_lock(&thread_group->mutex);
+      if (connection)
+      {
+        TP_INCREMENT_GROUP_COUNTER(thread_group, steals);
+        break;
+      }
+      if (thread_group->shutdown)
+        break;
+      if (!is_queue_empty(thread_group) || !thread_group->listener)
+        continue;
+    }
+
     /* And now, finally sleep */
     current_thread->woken = false; /* wake() sets this to true */
 
@@ -16,6 +16,7 @@
 #if defined (HAVE_POOL_OF_THREADS)
 #include <my_global.h>
 #include <sql_plist.h>
+#include <my_atomic_wrapper.h>
 #include <my_pthread.h>
 #include <mysqld.h>
 #include <threadpool.h>
@@ -126,12 +127,18 @@ struct thread_group_counters_t
   ulonglong stalls;
   ulonglong dequeues[2];
   ulonglong polls[2];
+  /* connections taken over from other groups by thread_pool_work_stealing */
+  ulonglong steals;
+  /* connections that other groups took over from this group */
+  ulonglong stolen;
 };
 
 struct thread_group_t
 {
   mysql_mutex_t mutex;
   connection_queue_t queues[NQUEUES];
+  /* Number of queued connections, readable without holding mutex */
+  Atomic_relaxed<int> queue_length;
   worker_list_t waiting_threads;
   worker_thread_t* listener;
   pthread_attr_t* pthread_attr;
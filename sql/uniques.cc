@@ -849,3 +849,288 @@ bool Unique::get(TABLE *table)
   my_free(sort_buffer);  
   DBUG_RETURN(rc);
 }
+
+
+/* Partitions of a Unique_hash_set that does not fit into memory */
+#define UNIQUE_HASH_PARTITION_BITS 4
+#define UNIQUE_HASH_PARTITIONS (1U << UNIQUE_HASH_PARTITION_BITS)
+/* The levels take the partition number from different bits of the hash */
+#define UNIQUE_HASH_MAX_LEVELS (32 / UNIQUE_HASH_PARTITION_BITS)
+
+/*
+  Partition of a key on a level of partitioning
+
+  The hash is multiplied to spread all its bits to the high ones, which
+  are then used level by level. The slot in the hash table is taken from
+  the low bits of the hash itself, so a partition still fills the whole
+  table.
+*/
+
+static inline uint unique_hash_partition(uint32 hash, uint level)
+{
+  uint32 mixed= hash * 0x9E3779B1U;
+  return (mixed << (level * UNIQUE_HASH_PARTITION_BITS)) >>
+         (32 - UNIQUE_HASH_PARTITION_BITS);
+}
+
+
+Unique_hash_set::Unique_hash_set(uint size_arg, size_t max_in_memory_size)
+  :keys(NULL), hashes(NULL), capacity(0), elements_in_set(0),
+   size(size_arg), partitions(NULL)
+{
+  size_t slot_size= size + sizeof(uint32);
+  for (max_capacity= 16;
+       max_capacity * 2 * slot_size <= max_in_memory_size &&
+       max_capacity < (1UL << 30);
+       max_capacity*= 2)
+  {}
+}
+
+
+Unique_hash_set::~Unique_hash_set()
+{
+  my_free(keys);
+  my_free(hashes);
+  free_partitions(partitions);
+}
+
+
+void Unique_hash_set::free_partitions(IO_CACHE *files)
+{
+  if (!files)
+    return;
+  for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+    close_cached_file(files + i);
+  my_free(files);
+}
+
+
+bool Unique_hash_set::alloc_slots(ulong slots)
+{
+  uchar *new_keys;
+  uint32 *new_hashes;
+  if (!(new_keys= (uchar*) my_malloc(key_memory_Unique_hash_set,
+                                     (size_t) slots * size + 1,
+                                     MYF(MY_THREAD_SPECIFIC | MY_WME))) ||
+      !(new_hashes= (uint32*) my_malloc(key_memory_Unique_hash_set,
+                                        slots * sizeof(uint32),
+                                        MYF(MY_THREAD_SPECIFIC | MY_WME |
+                                            MY_ZEROFILL))))
+  {
+    my_free(new_keys);
+    return 1;
+  }
+  my_free(keys);
+  my_free(hashes);
+  keys= new_keys;
+  hashes= new_hashes;
+  capacity= slots;
+  return 0;
+}
+
+
+/* Double the table, keeping its keys */
+
+bool Unique_hash_set::grow()
+{
+  uchar *old_keys= keys;
+  uint32 *old_hashes= hashes;
+  ulong old_capacity= capacity;
+
+  keys= NULL;
+  hashes= NULL;
+  if (alloc_slots(old_capacity * 2))
+  {
+    keys= old_keys;
+    hashes= old_hashes;
+    capacity= old_capacity;
+    return 1;
+  }
+  for (ulong i= 0; i < old_capacity; i++)
+  {
+    if (!old_hashes[i])
+      continue;
+    ulong slot= old_hashes[i] & (capacity - 1);
+    while (hashes[slot])
+      slot= (slot + 1) & (capacity - 1);
+    hashes[slot]= old_hashes[i];
+    memcpy(keys + (size_t) slot * size, old_keys + (size_t) i * size, size);
+  }
+  my_free(old_keys);
+  my_free(old_hashes);
+  return 0;
+}
+
+
+void Unique_hash_set::clear_slots()
+{
+  if (elements_in_set)
+    bzero(hashes, capacity * sizeof(uint32));
+  elements_in_set= 0;
+}
+
+
+/*
+  Add a key unless it's already there
+
+  @param spill_to  Partition files to empty the table to when it's full.
+                   Opened on the first use.
+  @param level     Level of the partitions in *spill_to
+*/
+
+bool Unique_hash_set::insert(const uchar *key, uint32 hash,
+                             IO_CACHE **spill_to, uint level)
+{
+  if (!capacity && alloc_slots(MY_MIN(1024, max_capacity)))
+    return 1;
+
+  ulong slot= hash & (capacity - 1);
+  for (; hashes[slot]; slot= (slot + 1) & (capacity - 1))
+  {
+    if (hashes[slot] == hash && !memcmp(keys + (size_t) slot * size, key, size))
+      return 0;
+  }
+
+  /* Keep the table at most 3/4 full */
+  if (elements_in_set >= capacity / 4 * 3)
+  {
+    /*
+      After the last level all keys of a partition have the same hash,
+      so partitioning them again would not split them. The table does
+      not grow beyond the limit then either.
+    */
+    if (capacity < max_capacity)
+    {
+      if (grow())
+        return 1;
+    }
+    else if (level < UNIQUE_HASH_MAX_LEVELS)
+    {
+      if (spill(spill_to, level))
+        return 1;
+    }
+    else
+    {
+      my_error(ER_OUT_OF_RESOURCES, MYF(0));
+      return 1;
+    }
+    for (slot= hash & (capacity - 1); hashes[slot];
+         slot= (slot + 1) & (capacity - 1))
+    {}
+  }
+  hashes[slot]= hash;
+  memcpy(keys + (size_t) slot * size, key, size);
+  elements_in_set++;
+  return 0;
+}
+
+
+/* Write all keys of the table to the partitions of the level; empty it */
+
+bool Unique_hash_set::spill(IO_CACHE **files, uint level)
+{
+  if (!*files)
+  {
+    if (!(*files= (IO_CACHE*) my_malloc(key_memory_Unique_hash_set,
+                                        sizeof(IO_CACHE) *
+                                        UNIQUE_HASH_PARTITIONS,
+                                        MYF(MY_THREAD_SPECIFIC | MY_WME))))
+      return 1;
+    for (uint i= 0; i < UNIQUE_HASH_PARTITIONS; i++)
+      my_b_clear(*files + i);
+  }
+  for (ulong i= 0; i < capacity; i++)
+  {
+    if (!hashes[i])
+      continue;
+    IO_CACHE *file= *files + unique_hash_partition(hashes[i], level);
+    if ((!my_b_inited(file) &&
+         open_cached_file(file, mysql_tmpdir, TEMP_PREFIX, DISK_CHUNK_SIZE,
+                          MYF(MY_WME | MY_TRACK_WITH_LIMIT))) ||
+        my_b_write(file, (uchar*) (hashes + i), sizeof(uint32)) ||
+        my_b_write(file, keys + (size_t) i * size, size))
+      return 1;
+  }
+  clear_slots();
+  return 0;
+}
+
+
+/*
+  Count the distinct keys of partition files
+
+  A partition holds all copies of its keys, so the counts of the
+  partitions add up. One that does not fit into the table is spilled to
+  partitions of the next level.
+*/
+
+bool Unique_hash_set::count_partitions(IO_CACHE *files, uint level,
+                                       ulonglong *count)
+{
+  bool error= 0;
+  uchar *key;
+  if (!(key= (uchar*) my_malloc(key_memory_Unique_hash_set, size + 1,
+                                MYF(MY_THREAD_SPECIFIC | MY_WME))))
+    return 1;
+
+  for (uint i= 0; i < UNIQUE_HASH_PARTITIONS && !error; i++)
+  {
+    IO_CACHE *file= files + i, *next_level= NULL;
+    if (!my_b_inited(file))
+      continue;
+    my_off_t records= my_b_tell(file) / (sizeof(uint32) + size);
+    if (reinit_io_cache(file, READ_CACHE, 0L, 0, 0))
+    {
+      error= 1;
+      break;
+    }
+    clear_slots();
+    for (; records && !error; records--)
+    {
+      uint32 hash;
+      error= my_b_read(file, (uchar*) &hash, sizeof(hash)) ||
+             my_b_read(file, key, size) ||
+             insert(key, hash, &next_level, level + 1);
+    }
+    if (!error)
+    {
+      if (next_level)
+        error= spill(&next_level, level + 1) ||
+               count_partitions(next_level, level + 1, count);
+      else
+        *count+= elements_in_set;
+    }
+    free_partitions(next_level);
+    close_cached_file(file);
+  }
+  clear_slots();
+  my_free(key);
+  return error;
+}
+
+
+void Unique_hash_set::reset()
+{
+  clear_slots();
+  free_partitions(partitions);
+  partitions= NULL;
+}
+
+
+/*
+  Get the number of distinct keys
+
+  Partitioned keys are read back and the set is emptied, so it must be
+  reset() before it's used again.
+*/
+
+bool Unique_hash_set::get_count(ulonglong *count)
+{
+  if (!partitions)
+  {
+    *count= elements_in_set;
+    return 0;
+  }
+  *count= 0;
+  return spill(&partitions, 0) || count_partitions(partitions, 0, count);
+}
@@ -107,4 +107,55 @@ class Unique :public Sql_alloc
                                             void *unique);
 };
 
+
+/*
+   Unique_hash_set -- counting of distinct keys that are equal only when
+   they are equal byte by byte.
+   The keys are kept in an open addressing hash table. When the table can't
+   grow within the memory limit, its keys are written to partition files by
+   another hash of the key, so that all copies of a key end up in the same
+   partition, and the table is emptied. At the end the partitions are
+   counted one by one, partitioning them again if they are still too big.
+   Unlike Unique the keys can't be retrieved in order, only counted.
+ */
+
+class Unique_hash_set :public Sql_alloc
+{
+  uchar *keys;               /* capacity keys of size bytes each */
+  uint32 *hashes;            /* hash of the key in the slot, 0 if empty */
+  ulong capacity;            /* number of slots, a power of 2 */
+  ulong max_capacity;        /* the most slots that fit in the memory limit */
+  ulong elements_in_set;
+  uint size;
+  /* Level 0 partitions, NULL while everything fits in memory */
+  IO_CACHE *partitions;
+
+  bool alloc_slots(ulong slots);
+  bool grow();
+  void clear_slots();
+  bool insert(const uchar *key, uint32 hash, IO_CACHE **spill_to,
+              uint level);
+  bool spill(IO_CACHE **files, uint level);
+  bool count_partitions(IO_CACHE *files, uint level, ulonglong *count);
+  static void free_partitions(IO_CACHE *files);
+
+public:
+  Unique_hash_set(uint size_arg, size_t max_in_memory_size);
+  ~Unique_hash_set();
+  bool unique_add(const uchar *key)
+  {
+    return insert(key, key_hash(key), &partitions, 0);
+  }
+  uint32 key_hash(const uchar *key) const
+  {
+    uint32 hash= my_crc32c(0, key, size);
+    return hash ? hash : 1;
+  }
+  bool is_in_memory() const { return !partitions; }
+  ulong elements_in_memory() const { return elements_in_set; }
+  void reset();
+  /* Number of distinct keys added since the last reset() */
+  bool get_count(ulonglong *count);
+};
+
 #endif /* UNIQUE_INCLUDED */
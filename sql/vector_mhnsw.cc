@@ -20,9 +20,11 @@
 #include "create_options.h"
 #include "table_cache.h"
 #include "vector_mhnsw.h"
+#include "rowid_filter.h"
 #include <scope.h>
 #include <my_atomic_wrapper.h>
 #include "bloom_filters.h"
+#include "sql_parallel.h"
 
 // distance can be a little bit < 0 because of fast math
 static constexpr float NEAREST = -1.0f;
@@ -35,6 +37,7 @@ static constexpr size_t subdist_part= 192;
 static constexpr float subdist_margin= 1.05f;
 static constexpr double subdist_stddev_threshold= 0.05;  // 3σ, p>99.9%
 static constexpr ulonglong subdist_stddev_valid= 10000;  // sufficient
+static constexpr uint rerank_factor[]= { 1, 2, 8 };      // per quant_type
 
 /*
  The class below can assume normal distribution and only collect
@@ -93,6 +96,11 @@ static ulonglong mhnsw_max_cache_size;
 static MYSQL_SYSVAR_ULONGLONG(max_cache_size, mhnsw_max_cache_size,
        PLUGIN_VAR_RQCMDARG, "Upper limit for one MHNSW vector index cache",
        nullptr, nullptr, 16*1024*1024, 1024*1024, SIZE_T_MAX, 1);
+static uint mhnsw_build_threads;
+static MYSQL_SYSVAR_UINT(build_threads, mhnsw_build_threads,
+       PLUGIN_VAR_RQCMDARG, "Number of threads that build the MHNSW graph "
+       "when ALTER TABLE copies rows into a table with a vector index",
+       nullptr, nullptr, 4, 1, 256, 1);
 static MYSQL_THDVAR_UINT(ef_search, PLUGIN_VAR_RQCMDARG,
        "Larger values mean slower SELECTs but more accurate results. "
        "Defines the minimal number of result candidates to look for in the "
@@ -111,10 +119,21 @@ static MYSQL_THDVAR_ENUM(default_distance, PLUGIN_VAR_RQCMDARG,
        "Distance function to build the vector index for",
        nullptr, nullptr, EUCLIDEAN, &distances);
 
+enum quant_type : uint { QUANT_NONE, QUANT_INT8, QUANT_BINARY };
+static const char *quantization_names[]= { "none", "int8", "binary", nullptr };
+static TYPELIB quantizations= CREATE_TYPELIB_FOR(quantization_names);
+static MYSQL_THDVAR_ENUM(default_quantization, PLUGIN_VAR_RQCMDARG,
+       "How vector index stores vectors. NONE uses 16 bits per coordinate, "
+       "INT8 uses 8 bits, BINARY uses one bit. Smaller representations "
+       "mean smaller and faster indexes but less accurate distances, "
+       "the final result candidates are always reordered by the exact "
+       "distance", nullptr, nullptr, QUANT_NONE, &quantizations);
+
 struct ha_index_option_struct
 {
   ulonglong M; // option struct does not support uint
   metric_type metric;
+  quant_type quant;
 };
 
 enum Graph_table_fields {
@@ -129,6 +148,11 @@ class FVectorNode;
 
 /*
   One vector, an array of coordinates in ctx->vec_len dimensions
+
+  Coordinates are stored as int16_t, as int8_t, or as one sign bit each
+  (packed in 64-bit words), depending on the index quantization.
+  In all cases a coordinate is approximately dims[i]*scale, for binary
+  vectors dims[i] is +1 or -1 and scale is the mean absolute coordinate.
 */
 #pragma pack(push, 1)
 struct FVector
@@ -141,27 +165,87 @@ struct FVector
 
   uchar *data() const { return (uchar*)(&scale); }
 
-  static size_t data_size(size_t n)
-  { return data_header + n*2; }
+  static size_t dims_size(quant_type q, size_t n)
+  {
+    switch (q) {
+    case QUANT_NONE:   return n*2;
+    case QUANT_INT8:   return n;
+    case QUANT_BINARY: return MY_ALIGN(n, 64)/8;
+    }
+    return n*2;
+  }
+
+  static size_t data_size(quant_type q, size_t n)
+  { return data_header + dims_size(q, n); }
 
-  static size_t data_to_value_size(size_t data_size)
-  { return (data_size - data_header)*2; }
+  /* per-architecture alloc_size() below counts in int16_t coordinates */
+  static size_t alloc_size(quant_type q, size_t n)
+  { return alloc_size((dims_size(q, n) + 1)/2); }
 
   static const FVector *create(const MHNSW_Share *ctx, void *mem, const void *src);
 
-  void postprocess(bool use_subdist, size_t vec_len)
+  void fix_tail(quant_type q, size_t vec_len)
+  {
+    size_t len= dims_size(q, vec_len);
+    if (len & 1)
+      ((uchar*)dims)[len]= 0;
+    fix_tail((len + 1)/2);
+  }
+
+  /* dot product of coordinates [from, from+len) */
+  float dot(quant_type q, const FVector *other, size_t from, size_t len) const
+  {
+    switch (q) {
+    case QUANT_NONE:
+      return dot_product(dims + from, other->dims + from, len);
+    case QUANT_INT8:
+      return dot_product((const int8_t*)dims + from,
+                         (const int8_t*)other->dims + from, len);
+    case QUANT_BINARY:
+      DBUG_ASSERT(from == 0);
+      return static_cast<float>(len) -
+             2.0f * hamming_distance((const uchar*)dims,
+                                     (const uchar*)other->dims, len);
+    }
+    return 0;
+  }
+
+  void postprocess(quant_type q, bool use_subdist, size_t vec_len)
   {
-    int16_t *d= dims;
-    fix_tail(vec_len);
+    size_t from= 0;
+    fix_tail(q, vec_len);
     if (use_subdist)
     {
-      subabs2= scale * scale * dot_product(d, d, subdist_part) / 2;
-      d+= subdist_part;
-      vec_len-= subdist_part;
+      subabs2= scale * scale * dot(q, this, 0, subdist_part) / 2;
+      from= subdist_part;
     }
     else
       subabs2= 0;
-    abs2= subabs2 + scale * scale * dot_product(d, d, vec_len) / 2;
+    abs2= subabs2 + scale * scale * dot(q, this, from, vec_len - from) / 2;
+  }
+
+  /*
+    Number of different bits in two sign-bit vectors. Every CPU with AVX2
+    has POPCNT, but the avx2 target does not imply it, so it's separate
+  */
+#ifdef AVX2_IMPLEMENTATION
+  __attribute__ ((target ("popcnt")))
+  static size_t hamming_distance(const uchar *v1, const uchar *v2, size_t len)
+  {
+    size_t d= 0;
+    for (size_t i= 0; i < (len + 63)/64; i++, v1+= 8, v2+= 8)
+      d+= __builtin_popcountll(uint8korr(v1) ^ uint8korr(v2));
+    return d;
+  }
+
+  __attribute__ ((target ("default")))
+#endif
+  static size_t hamming_distance(const uchar *v1, const uchar *v2, size_t len)
+  {
+    size_t d= 0;
+    for (size_t i= 0; i < (len + 63)/64; i++, v1+= 8, v2+= 8)
+      d+= __builtin_popcountll(uint8korr(v1) ^ uint8korr(v2));
+    return d;
   }
 
 #ifdef AVX2_IMPLEMENTATION
@@ -186,6 +270,24 @@ struct FVector
     return d[0] + d[1] + d[2] + d[3] + d[4] + d[5] + d[6] + d[7];
   }
 
+  AVX2_IMPLEMENTATION
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    /* |127*127*2| per lane, int32 cannot overflow for any vector length */
+    __m256i d= _mm256_setzero_si256();
+    for (size_t i= 0; i < (len + AVX2_dims-1)/AVX2_dims; i++)
+    {
+      __m256i p1= _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)v1 + i));
+      __m256i p2= _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)v2 + i));
+      d= _mm256_add_epi32(d, _mm256_madd_epi16(p1, p2));
+    }
+    __m128i s= _mm_add_epi32(_mm256_castsi256_si128(d),
+                             _mm256_extracti128_si256(d, 1));
+    s= _mm_hadd_epi32(s, s);
+    s= _mm_hadd_epi32(s, s);
+    return static_cast<float>(_mm_cvtsi128_si32(s));
+  }
+
   AVX2_IMPLEMENTATION
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n*2, AVX2_bytes) + AVX2_bytes - 1; }
@@ -219,6 +321,19 @@ struct FVector
     return _mm512_reduce_add_ps(d);
   }
 
+  AVX512_IMPLEMENTATION
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    __m512i d= _mm512_setzero_si512();
+    for (size_t i= 0; i < (len + AVX512_dims-1)/AVX512_dims; i++)
+    {
+      __m512i p1= _mm512_cvtepi8_epi16(_mm256_loadu_si256((__m256i*)v1 + i));
+      __m512i p2= _mm512_cvtepi8_epi16(_mm256_loadu_si256((__m256i*)v2 + i));
+      d= _mm512_add_epi32(d, _mm512_madd_epi16(p1, p2));
+    }
+    return static_cast<float>(_mm512_reduce_add_epi32(d));
+  }
+
   AVX512_IMPLEMENTATION
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n*2, AVX512_bytes) + AVX512_bytes - 1; }
@@ -265,6 +380,21 @@ struct FVector
     return static_cast<float>(d);
   }
 
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32x4_t d= vdupq_n_s32(0);
+    for (size_t i= 0; i < (len + NEON_bytes - 1) / NEON_bytes; i++)
+    {
+      int8x16_t p1= vld1q_s8(v1);
+      int8x16_t p2= vld1q_s8(v2);
+      d= vpadalq_s16(d, vmull_s8(vget_low_s8(p1), vget_low_s8(p2)));
+      d= vpadalq_s16(d, vmull_high_s8(p1, p2));
+      v1+= NEON_bytes;
+      v2+= NEON_bytes;
+    }
+    return static_cast<float>(vaddvq_s32(d));
+  }
+
   static size_t alloc_size(size_t n)
   { return alloc_header + MY_ALIGN(n * 2, NEON_bytes) + NEON_bytes - 1; }
 
@@ -314,6 +444,14 @@ struct FVector
                               static_cast<int64_t>(ll_sum[1]));
   }
 
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32_t d= 0;
+    for (size_t i= 0; i < len; i++)
+      d+= int32_t(v1[i]) * int32_t(v2[i]);
+    return static_cast<float>(d);
+  }
+
   static size_t alloc_size(size_t n)
   {
     return alloc_header + MY_ALIGN(n * 2, POWER_bytes) + POWER_bytes - 1;
@@ -343,6 +481,15 @@ struct FVector
     return static_cast<float>(d);
   }
 
+  DEFAULT_IMPLEMENTATION
+  static float dot_product(const int8_t *v1, const int8_t *v2, size_t len)
+  {
+    int32_t d= 0;
+    for (size_t i= 0; i < len; i++)
+      d+= int32_t(v1[i]) * int32_t(v2[i]);
+    return static_cast<float>(d);
+  }
+
   DEFAULT_IMPLEMENTATION
   static size_t alloc_size(size_t n) { return alloc_header + n*2; }
 
@@ -353,22 +500,21 @@ struct FVector
   void fix_tail(size_t) { }
 #endif
 
-  float distance_to(const FVector *other, size_t vec_len) const
+  float distance_to(quant_type q, const FVector *other, size_t vec_len) const
   {
     return abs2 + other->abs2 - scale * other->scale *
-           dot_product(dims, other->dims, vec_len);
+           dot(q, other, 0, vec_len);
   }
 
-  float distance_greater_than(const FVector *other, size_t vec_len, float than,
-                              Stats *stats) const
+  float distance_greater_than(quant_type q, const FVector *other,
+                              size_t vec_len, float than, Stats *stats) const
   {
     float k = scale * other->scale;
-    float dp= dot_product(dims, other->dims, subdist_part);
+    float dp= dot(q, other, 0, subdist_part);
     float subdist= (subabs2 + other->subabs2 - k * dp)/subdist_part*vec_len;
     if (subdist > than)
       return subdist;
-    dp+= dot_product(dims+subdist_part, other->dims+subdist_part,
-                     vec_len - subdist_part);
+    dp+= dot(q, other, subdist_part, vec_len - subdist_part);
     float dist= abs2 + other->abs2 - k * dp;
     stats->subdist.add(subdist/dist);
     return dist;
@@ -449,7 +595,7 @@ class FVectorNode
                               Stats *stats) const;
   int load(TABLE *graph);
   int load_from_record(TABLE *graph);
-  int save(TABLE *graph);
+  int save(TABLE *graph, bool with_neighbors= true);
   size_t tref_len() const;
   size_t gref_len() const;
   uchar *gref() const;
@@ -490,7 +636,7 @@ class MHNSW_Share : public Sql_alloc
   void *alloc_node_internal()
   {
     return alloc_root(&root, sizeof(FVectorNode) + gref_len + tref_len
-                      + FVector::alloc_size(vec_len));
+                      + FVector::alloc_size(quant, vec_len));
   }
 
 protected:
@@ -509,12 +655,14 @@ class MHNSW_Share : public Sql_alloc
   const uint gref_len;
   const uint M;
   metric_type metric;
+  quant_type quant;
   bool use_subdist;
 
   MHNSW_Share(TABLE *t)
     : tref_len(t->file->ref_length), gref_len(t->hlindex->file->ref_length),
       M(static_cast<uint>(t->s->key_info[t->s->keys].option_struct->M)),
-      metric(t->s->key_info[t->s->keys].option_struct->metric)
+      metric(t->s->key_info[t->s->keys].option_struct->metric),
+      quant(t->s->key_info[t->s->keys].option_struct->quant)
   {
     mysql_rwlock_init(PSI_INSTRUMENT_ME, &commit_lock);
     mysql_mutex_init(PSI_INSTRUMENT_ME, &cache_lock, MY_MUTEX_INIT_FAST);
@@ -555,7 +703,7 @@ class MHNSW_Share : public Sql_alloc
   {
     byte_len= len;
     vec_len= len / sizeof(float);
-    use_subdist= vec_len >= subdist_part * 2;
+    use_subdist= vec_len >= subdist_part * 2 && quant != QUANT_BINARY;
   }
 
   static int acquire(MHNSW_Share **ctx, TABLE *table, bool for_update);
@@ -643,6 +791,8 @@ class MHNSW_Share : public Sql_alloc
     return p;
   }
 
+  size_t cache_size() { return root_size(&root); }
+
   void read_stats(Stats *out)
   {
     mysql_mutex_lock(&cache_lock);
@@ -881,7 +1031,7 @@ int MHNSW_Share::acquire(MHNSW_Share **ctx, TABLE *table, bool for_update)
     return err;
 
   graph->file->position(graph->record[0]);
-  (*ctx)->set_lengths(FVector::data_to_value_size(graph->field[FIELD_VEC]->value_length()));
+  (*ctx)->set_lengths(table->key_info[table->s->keys].key_part->field->field_length);
 
   if (int err= graph->file->info(HA_STATUS_VARIABLE))
     return err;
@@ -902,12 +1052,42 @@ const FVector *FVector::create(const MHNSW_Share *ctx, void *mem, const void *sr
     scale= std::max(scale, std::abs(get_float(v + i)));
 
   FVector *vec= align_ptr(mem);
-  vec->scale= scale ? scale/32767 : 1;
-  if (std::round(scale/vec->scale) > 32767)
-    vec->scale= std::nextafter(vec->scale, FLT_MAX);
-  for (size_t i= 0; i < ctx->vec_len; i++)
-    vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
-  vec->postprocess(ctx->use_subdist, ctx->vec_len);
+  switch (ctx->quant) {
+  case QUANT_NONE:
+    vec->scale= scale ? scale/32767 : 1;
+    if (std::round(scale/vec->scale) > 32767)
+      vec->scale= std::nextafter(vec->scale, FLT_MAX);
+    for (size_t i= 0; i < ctx->vec_len; i++)
+      vec->dims[i] = static_cast<int16_t>(std::round(get_float(v + i) / vec->scale));
+    break;
+  case QUANT_INT8:
+  {
+    int8_t *d= (int8_t*)vec->dims;
+    vec->scale= scale ? scale/127 : 1;
+    if (std::round(scale/vec->scale) > 127)
+      vec->scale= std::nextafter(vec->scale, FLT_MAX);
+    for (size_t i= 0; i < ctx->vec_len; i++)
+      d[i]= static_cast<int8_t>(std::round(get_float(v + i) / vec->scale));
+    break;
+  }
+  case QUANT_BINARY:
+  {
+    /* a vector of signs times the mean |v[i]| is the closest one to v */
+    uchar *d= (uchar*)vec->dims;
+    double sum= 0;
+    bzero(d, dims_size(QUANT_BINARY, ctx->vec_len));
+    for (size_t i= 0; i < ctx->vec_len; i++)
+    {
+      float f= get_float(v + i);
+      sum+= std::abs(f);
+      if (f > 0)
+        d[i/8]|= static_cast<uchar>(1 << (i % 8));
+    }
+    vec->scale= static_cast<float>(sum / ctx->vec_len);
+    break;
+  }
+  }
+  vec->postprocess(ctx->quant, ctx->use_subdist, ctx->vec_len);
   if (ctx->metric == COSINE)
   {
     if (vec->abs2 > 0.0f)
@@ -946,7 +1126,7 @@ FVectorNode::FVectorNode(MHNSW_Share *ctx_, const void *tref_, uint8_t layer,
 
 float FVectorNode::distance_to(const FVector *other) const
 {
-  return vec->distance_to(other, ctx->vec_len);
+  return vec->distance_to(ctx->quant, other, ctx->vec_len);
 }
 
 float FVectorNode::distance_greater_than(const FVector *other, float than,
@@ -955,7 +1135,7 @@ float FVectorNode::distance_greater_than(const FVector *other, float than,
   static constexpr float mul[3]= {0, 10, subdist_margin };
   if (mode == NOSTAT_NOSUBDIST)
     return distance_to(other);
-  return vec->distance_greater_than(other, ctx->vec_len,
+  return vec->distance_greater_than(ctx->quant, other, ctx->vec_len,
                                     than*mul[mode], stats);
 }
 
@@ -1007,11 +1187,11 @@ int FVectorNode::load_from_record(TABLE *graph)
   if (unlikely(!v))
     return my_errno= HA_ERR_CRASHED;
 
-  if (v->length() != FVector::data_size(ctx->vec_len))
+  if (v->length() != FVector::data_size(ctx->quant, ctx->vec_len))
     return my_errno= HA_ERR_CRASHED;
   FVector *vec_ptr= FVector::align_ptr(tref() + tref_len());
   memcpy(vec_ptr->data(), v->ptr(), v->length());
-  vec_ptr->postprocess(ctx->use_subdist, ctx->vec_len);
+  vec_ptr->postprocess(ctx->quant, ctx->use_subdist, ctx->vec_len);
 
   longlong layer= graph->field[FIELD_LAYER]->val_int();
   if (layer > 100) // 10e30 nodes at M=2, more at larger M's
@@ -1059,6 +1239,153 @@ const uchar *FVectorNode::get_key(const void *elem, size_t *key_len, my_bool)
 }
 
 
+/*
+  Bulk build of the graph, used when ALTER TABLE copies rows into
+  a new table with a vector index.
+
+  The graph table is empty, so there is no need to write every node
+  and every changed neighbor on every insert. Instead mhnsw_insert()
+  only creates nodes (and chooses their layers), then the graph is
+  built in memory by many threads and is written out at the end:
+  first all nodes are inserted to learn their grefs, then their
+  neighbor lists are stored.
+
+  The node on the highest layer is the entry point, it is linked first,
+  so the entry point never changes while threads insert other nodes.
+  Neighbor lists are protected by a partitioned lock, a search works
+  on a copy of a list, as it can be changed by another thread.
+
+  Everything must fit into the cache, when it's not the case, the nodes
+  collected so far are built and written, and remaining rows are
+  inserted one by one as usual.
+*/
+class MHNSW_Bulk : public Sql_alloc
+{
+  mysql_mutex_t node_lock[64];
+  std::atomic<size_t> next{0};
+  std::atomic<int> error{0};
+
+  void link_nodes();
+  int write();
+
+public:
+  MHNSW_Share * const ctx;
+  TABLE * const graph;
+  Dynamic_array<FVectorNode*> nodes{PSI_INSTRUMENT_MEM, 1024, 1024};
+  FVectorNode *entry= nullptr;
+
+  MHNSW_Bulk(MHNSW_Share *ctx, TABLE *graph) : ctx(ctx), graph(graph)
+  {
+    for (uint i=0; i < array_elements(node_lock); i++)
+      mysql_mutex_init(PSI_INSTRUMENT_ME, node_lock + i, MY_MUTEX_INIT_FAST);
+  }
+  ~MHNSW_Bulk()
+  {
+    for (uint i=0; i < array_elements(node_lock); i++)
+      mysql_mutex_destroy(node_lock + i);
+  }
+
+  uint lock_node(const FVectorNode *ptr)
+  {
+    uint ticket= static_cast<uint>((intptr)ptr >> 6) % array_elements(node_lock);
+    mysql_mutex_lock(node_lock + ticket);
+    return ticket;
+  }
+
+  void unlock_node(uint ticket)
+  {
+    mysql_mutex_unlock(node_lock + ticket);
+  }
+
+  /* copies neighbors, the same way they're laid out in Neighborhood */
+  FVectorNode **copy_neighbors(const FVectorNode *node, size_t layer,
+                               FVectorNode **to, size_t *num)
+  {
+    uint ticket= lock_node(node);
+    *num= node->neighbors[layer].num;
+    memcpy(to, node->neighbors[layer].links,
+           MY_ALIGN(*num, 8) * sizeof(*to));
+    unlock_node(ticket);
+    return to;
+  }
+
+  int add(TABLE *table, const String *vec);
+  int build();
+};
+
+/*
+  Filter-aware search. Rows that don't match the WHERE clause are not
+  returned, but the graph is still traversed through them, so that the
+  search keeps expanding until it finds enough matching rows, instead of
+  returning fewer rows than LIMIT or needing a huge mhnsw_ef_search.
+
+  A rowid filter is checked by the tref, a pushed condition needs the
+  row to be read from the table. It is read into a separate buffer, with
+  the fields moved there while the condition is evaluated, so record[0]
+  is never changed by the search. Only done on the zero layer.
+*/
+class Search_filter : public Sql_alloc
+{
+  TABLE *table;
+  Rowid_filter *rowid_filter;
+  Item *cond;
+  uchar *row= nullptr;
+public:
+  double selectivity= 1;
+  int error= 0;
+
+  Search_filter(TABLE *table, Item *cond, double cond_selectivity,
+                size_t graph_size)
+    : table(table), cond(cond)
+  {
+    handler *file= table->file;
+    rowid_filter= file->rowid_filter_is_active ? file->pushed_rowid_filter : 0;
+    /*
+      cond normally includes the condition the rowid filter was built for,
+      so the selectivities are not multiplied
+    */
+    if (cond)
+      selectivity= cond_selectivity;
+    if (rowid_filter && graph_size)
+      selectivity= std::min(selectivity,
+                            rowid_filter->get_container()->elements() /
+                            (double)graph_size);
+    selectivity= std::max(selectivity, 0.001);
+    if (cond &&
+        (row= (uchar*) alloc_root(table->in_use->mem_root,
+                                  table->s->rec_buff_length)))
+      memcpy(row, table->s->default_values, table->s->reclength);
+  }
+
+  bool is_empty() const { return !rowid_filter && !cond; }
+
+  /* false if the row doesn't match, or on error */
+  bool check(const FVectorNode *node)
+  {
+    if (rowid_filter && !rowid_filter->check((char*)node->tref()))
+      return false;
+    if (!cond)
+      return true;
+    if (!row)
+    {
+      error= HA_ERR_OUT_OF_MEM;
+      return false;
+    }
+    if (int err= table->file->ha_rnd_pos(row, node->tref()))
+    {
+      if (err != HA_ERR_RECORD_DELETED && err != HA_ERR_KEY_NOT_FOUND)
+        error= err;
+      return false;
+    }
+    table->move_fields(table->field, row, table->record[0]);
+    if (table->vfield)
+      table->update_virtual_fields(table->file, VCOL_UPDATE_FOR_READ);
+    bool res= cond->val_bool();
+    table->move_fields(table->field, table->record[0], row);
+    return res;
+  }
+};
+
 /* common set of params for many search/select functions */
 struct MHNSW_param
 {
@@ -1068,8 +1395,11 @@ struct MHNSW_param
   Stats acc;
   dgt_mode mode;
   double max_est_size;
+  MEM_ROOT *root;
+  MHNSW_Bulk *bulk= nullptr;  // set only when building the graph in threads
+  Search_filter *filter= nullptr;
   MHNSW_param(MHNSW_Share *ctx, TABLE *graph, int layer)
-    : ctx(ctx), graph(graph), layer(layer)
+    : ctx(ctx), graph(graph), layer(layer), root(graph->in_use->mem_root)
   {
     Stats stats;
     ctx->read_stats(&stats);
@@ -1157,7 +1487,7 @@ static int select_neighbors(MHNSW_param *p, FVectorNode *target,
   if (pq.init(max_ef, false, Visited::cmp))
     return my_errno= HA_ERR_OUT_OF_MEM;
 
-  MEM_ROOT * const root= p->graph->in_use->mem_root;
+  MEM_ROOT * const root= p->root;
   auto discarded= (Visited**)my_safe_alloca(sizeof(Visited**)*max_neighbor_connections);
   size_t discarded_num= 0;
   Neighborhood &neighbors= target->neighbors[p->layer];
@@ -1199,7 +1529,11 @@ static int select_neighbors(MHNSW_param *p, FVectorNode *target,
 }
 
 
-int FVectorNode::save(TABLE *graph)
+/*
+  with_neighbors=false writes empty neighbor lists, this is used when
+  the nodes that the lists refer to may not have been written yet
+*/
+int FVectorNode::save(TABLE *graph, bool with_neighbors)
 {
   DBUG_ASSERT(vec);
   DBUG_ASSERT(neighbors);
@@ -1213,18 +1547,20 @@ int FVectorNode::save(TABLE *graph)
     graph->field[FIELD_TREF]->set_notnull();
     graph->field[FIELD_TREF]->store_binary(tref(), tref_len());
   }
-  graph->field[FIELD_VEC]->store_binary(vec->data(), FVector::data_size(ctx->vec_len));
+  graph->field[FIELD_VEC]->store_binary(vec->data(),
+                                        FVector::data_size(ctx->quant, ctx->vec_len));
 
   size_t total_size= 0;
   for (size_t i=0; i <= max_layer; i++)
-    total_size+= 1 + gref_len() * neighbors[i].num;
+    total_size+= 1 + (with_neighbors ? gref_len() * neighbors[i].num : 0);
 
   uchar *neighbor_blob= static_cast<uchar *>(my_safe_alloca(total_size));
   uchar *ptr= neighbor_blob;
   for (size_t i= 0; i <= max_layer; i++)
   {
-    *ptr++= (uchar)(neighbors[i].num);
-    for (size_t j= 0; j < neighbors[i].num; j++, ptr+= gref_len())
+    size_t num= with_neighbors ? neighbors[i].num : 0;
+    *ptr++= (uchar) num;
+    for (size_t j= 0; j < num; j++, ptr+= gref_len())
       memcpy(ptr, neighbors[i].links[j]->gref(), gref_len());
   }
   graph->field[FIELD_NEIGHBORS]->store_binary(neighbor_blob, total_size);
@@ -1254,19 +1590,30 @@ int FVectorNode::save(TABLE *graph)
 static int update_second_degree_neighbors(MHNSW_param *p, FVectorNode *node)
 {
   const uint max_neighbors= p->ctx->max_neighbors(p->layer);
+  FVectorNode **links= node->neighbors[p->layer].links;
+  size_t num= node->neighbors[p->layer].num;
+  if (p->bulk) // other threads may be adding to the node's neighbors
+    links= p->bulk->copy_neighbors(node, p->layer, (FVectorNode**)
+             alloc_root(p->root, sizeof(*links) * MY_ALIGN(max_neighbors, 8)),
+             &num);
+
   // it seems that one could update nodes in the gref order
   // to avoid InnoDB deadlocks, but it produces no noticeable effect
-  for (size_t i=0; i < node->neighbors[p->layer].num; i++)
+  for (size_t i=0; i < num; i++)
   {
-    FVectorNode *neigh= node->neighbors[p->layer].links[i];
+    FVectorNode *neigh= links[i];
     Neighborhood &neighneighbors= neigh->neighbors[p->layer];
+    uint ticket= p->bulk ? p->bulk->lock_node(neigh) : 0;
+    int err= 0;
     if (neighneighbors.num < max_neighbors)
       neigh->push_neighbor(p->layer, node);
     else
-      if (int err= select_neighbors(p, neigh, neighneighbors, node,
-                                    max_neighbors))
-        return err;
-    if (int err= neigh->save(p->graph))
+      err= select_neighbors(p, neigh, neighneighbors, node, max_neighbors);
+    if (p->bulk)
+      p->bulk->unlock_node(ticket);
+    else if (!err)
+      err= neigh->save(p->graph);
+    if (err)
       return err;
   }
   return 0;
@@ -1290,7 +1637,7 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
 {
   DBUG_ASSERT(inout->num > 0);
 
-  MEM_ROOT * const root= p->graph->in_use->mem_root;
+  MEM_ROOT * const root= p->root;
   Queue<Visited> candidates, best;
   bool skip_deleted;
   uint ef= result_size;
@@ -1308,16 +1655,22 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
     if (ef > 1 || p->layer == 0)
       ef= std::max(THDVAR(p->graph->in_use, ef_search), ef);
   }
+  Search_filter * const filter= skip_deleted ? p->filter : nullptr;
 
   // WARNING! heuristic here
   const double est_heuristic= 8 * std::sqrt(p->ctx->max_neighbors(p->layer));
   double est_size= est_heuristic * std::pow(ef, p->acc.ef_power);
+  if (filter) // will have to look at more nodes to find ef matching ones
+    est_size/= filter->selectivity;
   est_size= std::min(est_size, p->max_est_size);
   VisitedSet visited(root, static_cast<uint>(est_size));
 
   candidates.init(max_ef, false, Visited::cmp);
   best.init(ef, true, Visited::cmp);
 
+  FVectorNode **links_copy= p->bulk ? (FVectorNode**)alloc_root(root,
+    sizeof(*links_copy) * MY_ALIGN(p->ctx->max_neighbors(p->layer), 8)) : 0;
+
   DBUG_ASSERT(inout->num <= result_size);
   for (size_t i=0; i < inout->num; i++)
   {
@@ -1325,7 +1678,8 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
     Visited *v= visited.create(node, node->distance_to(target));
     p->acc.diameter= std::max(p->acc.diameter, v->distance_to_target);
     candidates.push(v);
-    if ((skip_deleted && v->node->deleted) || threshold > NEAREST)
+    if ((skip_deleted && v->node->deleted) || threshold > NEAREST ||
+        (filter && !filter->check(node)))
       continue;
     best.push(v);
   }
@@ -1342,6 +1696,12 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
 
     Neighborhood &neighbors= cur.node->neighbors[p->layer];
     FVectorNode **links= neighbors.links, **end= links + neighbors.num;
+    if (p->bulk)
+    {
+      size_t num;
+      links= p->bulk->copy_neighbors(cur.node, p->layer, links_copy, &num);
+      end= links + num;
+    }
     for (; links < end; links+= 8)
     {
       uint8_t res= visited.seen(links);
@@ -1363,6 +1723,8 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
           candidates.safe_push(v);
           if (skip_deleted && v->node->deleted)
             continue;
+          if (filter && !filter->check(v->node))
+            continue;
           best.push(v);
           furthest_best= generous_furthest(best, p->acc.diameter, generosity);
         }
@@ -1378,7 +1740,8 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
             candidates.safe_push(v);
             if (skip_deleted && v->node->deleted)
               continue;
-            if (v->distance_to_target < best.top()->distance_to_target)
+            if (v->distance_to_target < best.top()->distance_to_target &&
+                (!filter || filter->check(v->node)))
             {
               best.replace_top(v);
               furthest_best= generous_furthest(best, p->acc.diameter, generosity);
@@ -1388,7 +1751,10 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
       }
     }
   }
-  if (ef > 1 && visited.count > est_size)
+  if (filter && filter->error)
+    return filter->error;
+
+  if (ef > 1 && visited.count > est_size && !filter)
   {
     double ef_power= std::log(visited.count/est_heuristic) / std::log(ef);
     p->acc.ef_power= std::max(p->acc.ef_power, ef_power);
@@ -1405,6 +1771,41 @@ static int search_layer(MHNSW_param *p, const FVector *target, float threshold,
 }
 
 
+/* a random layer for a new node, at most one above the current top */
+static uint8_t random_layer(THD *thd, const MHNSW_Share *ctx, uint8_t max_layer)
+{
+  const double NORMALIZATION_FACTOR= 1 / std::log(ctx->M);
+  double log= -std::log(my_rnd(&thd->rand)) * NORMALIZATION_FACTOR;
+  return std::min<uint8_t>(static_cast<uint8_t>(std::floor(log)), max_layer + 1);
+}
+
+/*
+  searches the graph down from candidates (on the layer p->layer)
+  and selects target neighbors on all layers of the target
+*/
+static int find_neighbors(MHNSW_param *p, Neighborhood *candidates,
+                          FVectorNode *target)
+{
+  for (; p->layer > target->max_layer; p->layer--)
+  {
+    if (int err= search_layer(p, target->vec, NEAREST, 1, candidates, false))
+      return err;
+  }
+
+  for (; p->layer >= 0; p->layer--)
+  {
+    uint max_neighbors= p->ctx->max_neighbors(p->layer);
+    if (int err= search_layer(p, target->vec, NEAREST, max_neighbors,
+                              candidates, true))
+      return err;
+
+    if (int err= select_neighbors(p, target, *candidates, 0, max_neighbors))
+      return err;
+  }
+  return 0;
+}
+
+
 int mhnsw_insert(TABLE *table, KEY *keyinfo)
 {
   THD *thd= table->in_use;
@@ -1426,6 +1827,15 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
 
   table->file->position(table->record[0]);
 
+  if (auto bulk= static_cast<MHNSW_Bulk*>(table->hlindex_bulk))
+  {
+    int err= bulk->add(table, res);
+    dbug_tmp_restore_column_map(&table->read_set, old_map);
+    if (!err && bulk->ctx->cache_size() > mhnsw_max_cache_size)
+      err= mhnsw_bulk_end(table, false); // continue one row at a time
+    return err;
+  }
+
   int err= MHNSW_Share::acquire(&ctx, table, true);
   SCOPE_EXIT([ctx, table](){ ctx->release(table); });
   if (err)
@@ -1454,10 +1864,8 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
   candidates.init(thd->alloc<FVectorNode*>(max_found + 7), max_found);
   candidates.links[candidates.num++]= ctx->start;
 
-  const double NORMALIZATION_FACTOR= 1 / std::log(ctx->M);
-  double log= -std::log(my_rnd(&thd->rand)) * NORMALIZATION_FACTOR;
   const uint8_t max_layer= candidates.links[0]->max_layer;
-  uint8_t target_layer= std::min<uint8_t>(static_cast<uint8_t>(std::floor(log)), max_layer + 1);
+  uint8_t target_layer= random_layer(thd, ctx, max_layer);
 
   FVectorNode *target= new (ctx->alloc_node())
                  FVectorNode(ctx, table->file->ref, target_layer, res->ptr());
@@ -1469,22 +1877,8 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
   MHNSW_param p(ctx, graph, max_layer);
   p.acc.graph_size= 1; // we're adding one node to the graph
 
-  for (; p.layer > target_layer; p.layer--)
-  {
-    if (int err= search_layer(&p, target->vec, NEAREST, 1, &candidates, false))
-      return err;
-  }
-
-  for (; p.layer >= 0; p.layer--)
-  {
-    uint max_neighbors= ctx->max_neighbors(p.layer);
-    if (int err= search_layer(&p, target->vec, NEAREST, max_neighbors,
-                              &candidates, true))
-      return err;
-
-    if (int err= select_neighbors(&p, target, candidates, 0, max_neighbors))
-      return err;
-  }
+  if (int err= find_neighbors(&p, &candidates, target))
+    return err;
 
   if (int err= target->save(graph))
     return err;
@@ -1505,28 +1899,222 @@ int mhnsw_insert(TABLE *table, KEY *keyinfo)
 }
 
 
+/*
+  nodes are created in the order of rows, layers are chosen the same way
+  as in mhnsw_insert(), but nothing is linked or written yet
+*/
+int MHNSW_Bulk::add(TABLE *table, const String *vec)
+{
+  if (!ctx->byte_len)
+    ctx->set_lengths(vec->length());
+  else if (ctx->byte_len != vec->length())
+    return my_errno= HA_ERR_CRASHED;
+
+  uint8_t layer= entry ? random_layer(table->in_use, ctx, entry->max_layer) : 0;
+  FVectorNode *node= new (ctx->alloc_node())
+                 FVectorNode(ctx, table->file->ref, layer, vec->ptr());
+  if (nodes.append(node))
+    return my_errno= HA_ERR_OUT_OF_MEM;
+  if (!entry || layer > entry->max_layer)
+    entry= node;
+  return 0;
+}
+
+/* one build thread, links nodes into the graph until there are none left */
+void MHNSW_Bulk::link_nodes()
+{
+  MEM_ROOT root;
+  init_alloc_root(PSI_INSTRUMENT_MEM, &root, 65536, 0, MYF(0));
+  MHNSW_param p(ctx, graph, 0);
+  p.root= &root;
+  p.bulk= this;
+
+  const size_t max_found= ctx->max_neighbors(0);
+  for (size_t i; !error && (i= next++) < nodes.elements();
+       free_root(&root, MYF(MY_MARK_BLOCKS_FREE)))
+  {
+    FVectorNode *target= nodes.at(i);
+    if (target == entry)
+      continue;
+
+    Neighborhood candidates;
+    candidates.init((FVectorNode**)alloc_root(&root,
+                      sizeof(FVectorNode*) * (max_found + 7)), max_found);
+    candidates.links[candidates.num++]= entry;
+    p.layer= entry->max_layer;
+    p.max_est_size= i/1.3;
+
+    int err= find_neighbors(&p, &candidates, target);
+    for (p.layer= target->max_layer; !err && p.layer >= 0; p.layer--)
+      err= update_second_degree_neighbors(&p, target);
+    if (err)
+    {
+      int no_error= 0;
+      error.compare_exchange_strong(no_error, err);
+    }
+  }
+  ctx->add_to_stats(p.acc);
+  free_root(&root, MYF(0));
+}
+
+/*
+  grefs are only known after nodes are written, so it takes two passes:
+  first all nodes are written with empty neighbor lists, then the lists
+  are filled in
+*/
+int MHNSW_Bulk::write()
+{
+  if (int err= graph->file->ha_rnd_init(0))
+    return err;
+  SCOPE_EXIT([this](){ graph->file->ha_rnd_end(); });
+
+  for (size_t i= 0; i < nodes.elements(); i++)
+    if (int err= nodes.at(i)->save(graph, false))
+      return err;
+
+  for (size_t i= 0; i < nodes.elements(); i++)
+    if (int err= nodes.at(i)->save(graph))
+      return err;
+  return 0;
+}
+
+int MHNSW_Bulk::build()
+{
+  if (!nodes.elements())
+    return 0;
+
+  /*
+    nodes are linked by tasks of the shared parallel task pool, the calling
+    thread works too, so with mhnsw_build_threads=1 nothing is submitted
+    to the pool. Small graphs aren't worth it.
+  */
+  size_t threads= std::min<size_t>(mhnsw_build_threads,
+                                   nodes.elements() / 1000 + 1);
+  run_parallel_tasks((uint) threads, [this](uint) { link_nodes(); });
+
+  if (int err= error)
+    return err;
+  if (int err= write())
+    return err;
+
+  ctx->set_stats(nodes.elements());
+  ctx->start= entry;
+  return 0;
+}
+
+
+int mhnsw_bulk_start(TABLE *table, KEY *keyinfo)
+{
+  MHNSW_Share *ctx;
+  DBUG_ASSERT(!table->hlindex_bulk);
+  DBUG_ASSERT(keyinfo->algorithm == HA_KEY_ALG_VECTOR);
+
+  int err= MHNSW_Share::acquire(&ctx, table, true);
+  if (err != HA_ERR_END_OF_FILE) // the graph isn't empty, insert row by row
+  {
+    ctx->release(table);
+    return err;
+  }
+
+  if (!(table->hlindex_bulk= new (table->in_use->mem_root)
+                               MHNSW_Bulk(ctx, table->hlindex)))
+  {
+    ctx->release(table);
+    return my_errno= HA_ERR_OUT_OF_MEM;
+  }
+  return 0;
+}
+
+
+int mhnsw_bulk_end(TABLE *table, bool abort)
+{
+  auto bulk= static_cast<MHNSW_Bulk*>(table->hlindex_bulk);
+  MHNSW_Share *ctx= bulk->ctx;
+  table->hlindex_bulk= nullptr;
+
+  int err= abort ? 0 : bulk->build();
+  if (abort || err)
+    ctx->reset(table->s); // don't let anyone see a partially built graph
+  bulk->~MHNSW_Bulk();
+  ctx->release(table);
+  return err;
+}
+
+
+struct Ranked { FVectorNode *node; double dist; };
+
 struct Search_context: public Sql_alloc
 {
   Neighborhood found;
   MHNSW_Share *ctx;
   const FVector *target;
+  Search_filter *filter;
+  Item_func_vec_distance *fun;
   ulonglong ctx_version;
   size_t pos= 0;
+  size_t ready;                 // found.links[pos..ready) can be returned
+  size_t batch= 0;              // rows to return per reranked window
+  Ranked *ranked= nullptr;      // exact distances of found, if quantized
   float threshold= NEAREST/2;
-  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v)
-    : found(*n), ctx(s->dup(false)), target(v), ctx_version(ctx->version) {}
+  Search_context(Neighborhood *n, MHNSW_Share *s, const FVector *v,
+                 Search_filter *f, Item_func_vec_distance *d)
+    : found(*n), ctx(s->dup(false)), target(v), filter(f), fun(d),
+      ctx_version(ctx->version), ready(n->num) {}
+
+  int rerank(TABLE *table, size_t fresh, size_t kept);
 };
 
 
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
+/*
+  Quantized distances are only approximate, so the index returns more
+  candidates than needed and they're reordered here by the exact distance,
+  calculated from the row itself.
+
+  found.links[0..fresh) are new candidates, ranked[pos..pos+kept) are
+  the ones that were ranked before, but not returned yet. They're all
+  sorted together, and only the best batch rows are returned, the rest
+  are kept for the next window. This way a better candidate that was
+  found later still goes before a worse one that was found earlier.
+*/
+int Search_context::rerank(TABLE *table, size_t fresh, size_t kept)
+{
+  memmove(ranked, ranked + pos, kept * sizeof(*ranked));
+  for (size_t i= 0; i < fresh; i++)
+  {
+    FVectorNode *node= found.links[i];
+    if (int err= table->file->ha_rnd_pos(table->record[0], node->tref()))
+      return err;
+    double d= fun->val_real();
+    ranked[kept + i]= { node, fun->null_value ? DBL_MAX : d };
+  }
+  found.num= kept + fresh;
+  std::stable_sort(ranked, ranked + found.num,
+                   [](const Ranked &a, const Ranked &b)
+                   { return a.dist < b.dist; });
+  for (size_t i= 0; i < found.num; i++)
+    found.links[i]= ranked[i].node;
+  pos= 0;
+  /* when the search found nothing new, the window is final */
+  ready= fresh ? std::min(found.num, batch) : found.num;
+  return 0;
+}
+
+
+/*
+  @param cond              a condition that every returned row must satisfy,
+                           or NULL
+  @param cond_selectivity  expected fraction of rows that satisfy cond
+
+  A rowid filter pushed into table->file is always used.
+*/
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Item *cond, double cond_selectivity)
 {
   THD *thd= table->in_use;
   TABLE *graph= table->hlindex;
   auto *fun= static_cast<Item_func_vec_distance*>(dist->real_item());
   DBUG_ASSERT(fun);
 
-  limit= std::min<ulonglong>(limit, max_ef);
-
   String buf, *res= fun->get_const_arg()->val_str(&buf);
   MHNSW_Share *ctx;
 
@@ -1538,6 +2126,9 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   if (err)
     return err;
 
+  const size_t batch= static_cast<size_t>(std::min<ulonglong>(limit, max_ef));
+  limit= std::min<ulonglong>(batch * rerank_factor[ctx->quant], max_ef);
+
   Neighborhood candidates;
   candidates.init(thd->alloc<FVectorNode*>(limit + 7), limit);
 
@@ -1559,13 +2150,20 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
       ((float*)buf.ptr())[i]= i == 0;
   }
 
-  auto target= FVector::create(ctx, thd->alloc(FVector::alloc_size(ctx->vec_len)),
-                               res->ptr());
+  auto target= FVector::create(ctx,
+                 thd->alloc(FVector::alloc_size(ctx->quant, ctx->vec_len)),
+                 res->ptr());
 
   if (int err= graph->file->ha_rnd_init(0))
     return err;
 
   MHNSW_param p(ctx, graph, candidates.links[0]->max_layer);
+  Stats stats;
+  ctx->read_stats(&stats);
+  auto filter= new (thd->mem_root) Search_filter(table, cond, cond_selectivity,
+                                                 stats.graph_size);
+  if (!filter->is_empty())
+    p.filter= filter;
 
   for (; p.layer > 0; p.layer--)
   {
@@ -1584,16 +2182,26 @@ int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit)
   }
   ctx->add_to_stats(p.acc);
 
-  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target);
+  auto result= new (thd->mem_root) Search_context(&candidates, ctx, target,
+                                                  p.filter, fun);
   graph->context= result;
 
+  if (ctx->quant != QUANT_NONE)
+  {
+    result->batch= batch;
+    if (!(result->ranked= thd->alloc<Ranked>(limit)))
+      return my_errno= HA_ERR_OUT_OF_MEM;
+    if (int err= result->rerank(table, result->found.num, 0))
+      return err;
+  }
+
   return mhnsw_read_next(table);
 }
 
 int mhnsw_read_next(TABLE *table)
 {
   auto result= static_cast<Search_context*>(table->hlindex->context);
-  if (result->pos < result->found.num)
+  if (result->pos < result->ready)
   {
     uchar *ref= result->found.links[result->pos++]->tref();
     return table->file->ha_rnd_pos(table->record[0], ref);
@@ -1624,6 +2232,8 @@ int mhnsw_read_next(TABLE *table)
       if ((err= node->load(graph)))
         return err;
       result->found.links[i]= node;
+      if (result->ranked)
+        result->ranked[i].node= node;
     }
     ctx->release(false, table->s);      // release shared ctx
     result->ctx= trx->dup(false);       // replace it with trx
@@ -1631,13 +2241,33 @@ int mhnsw_read_next(TABLE *table)
     std::swap(trx, ctx);        // free shared ctx in this scope, keep trx
   }
 
-  float new_threshold= result->found.links[result->found.num-1]->distance_to(result->target);
+  /* after rerank() the last node isn't necessarily the furthest one */
+  float new_threshold= 0;
+  for (size_t i= ctx->quant == QUANT_NONE ? result->found.num-1 : 0;
+       i < result->found.num; i++)
+    new_threshold= std::max(new_threshold,
+                       result->found.links[i]->distance_to(result->target));
+  /* the rows ranked, but not returned yet, are still search entry points */
+  const size_t kept= result->found.num - result->pos;
   MHNSW_param p(ctx, graph, 0);
+  p.filter= result->filter;
   if (int err= search_layer(&p, result->target, result->threshold,
-                            static_cast<uint>(result->pos), &result->found, false))
+                            static_cast<uint>(result->found.num),
+                            &result->found, false))
     return err;
-  result->pos= 0;
   result->threshold= new_threshold + FLT_EPSILON;
+  if (ctx->quant != QUANT_NONE)
+  {
+    /* refill the window to its size, in the order of approximate distance */
+    if (int err= result->rerank(table, std::min(result->found.num,
+                                                result->pos), kept))
+      return err;
+  }
+  else
+  {
+    result->pos= 0;
+    result->ready= result->found.num;
+  }
   return mhnsw_read_next(table);
 }
 
@@ -1762,6 +2392,7 @@ ha_create_table_option mhnsw_index_options[]=
 {
   HA_IOPTION_SYSVAR("m", M, default_m),
   HA_IOPTION_SYSVAR("distance", metric, default_distance),
+  HA_IOPTION_SYSVAR("quantization", quant, default_quantization),
   HA_IOPTION_END
 };
 
@@ -1789,8 +2420,10 @@ static struct st_mysql_storage_engine mhnsw_daemon=
 static struct st_mysql_sys_var *mhnsw_sys_vars[]=
 {
   MYSQL_SYSVAR(max_cache_size),
+  MYSQL_SYSVAR(build_threads),
   MYSQL_SYSVAR(default_m),
   MYSQL_SYSVAR(default_distance),
+  MYSQL_SYSVAR(default_quantization),
   MYSQL_SYSVAR(ef_search),
   NULL
 };
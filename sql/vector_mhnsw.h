@@ -27,7 +27,10 @@
 */
 const LEX_CSTRING mhnsw_hlindex_table_def(THD *thd, uint ref_length);
 int mhnsw_insert(TABLE *table, KEY *keyinfo);
-int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit);
+int mhnsw_bulk_start(TABLE *table, KEY *keyinfo);
+int mhnsw_bulk_end(TABLE *table, bool abort);
+int mhnsw_read_first(TABLE *table, KEY *keyinfo, Item *dist, ulonglong limit,
+                     Item *cond, double cond_selectivity);
 int mhnsw_read_next(TABLE *table);
 int mhnsw_read_end(TABLE *table);
 int mhnsw_invalidate(TABLE *table, const uchar *rec, KEY *keyinfo);
@@ -646,6 +646,7 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   ha_rows max_rows;
   HP_KEYDEF *keydef;
   HA_KEYSEG *seg;
+  HP_BLOB_DESC *blob_descs;
   bool found_real_auto_increment= 0;
 
   bzero(hp_create_info, sizeof(*hp_create_info));
@@ -663,8 +664,16 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
                        MYF(MY_WME | MY_THREAD_SPECIFIC),
                        &keydef, keys * sizeof(HP_KEYDEF),
                        &seg, parts * sizeof(HA_KEYSEG),
+                       &blob_descs, share->blob_fields * sizeof(HP_BLOB_DESC),
                        NULL))
     return my_errno;
+  /* blob_field[] is in field order, so the blobs are sorted by offset */
+  for (uint i= 0; i < share->blob_fields; i++)
+  {
+    Field_blob *blob= (Field_blob*) table_arg->field[share->blob_field[i]];
+    blob_descs[i].offset= (uint) blob->offset(table_arg->record[0]);
+    blob_descs[i].packlength= blob->pack_length_no_ptr();
+  }
   for (key= 0; key < keys; key++)
   {
     KEY *pos= table_arg->key_info+key;
@@ -756,6 +765,14 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->auto_key= auto_key;
   hp_create_info->auto_key_type= auto_key_type;
   hp_create_info->max_table_size= MY_MAX(current_thd->variables.max_heap_table_size, sizeof(HP_PTRS));
+  /*
+    The row limit computed by the server for internal temporary tables
+    does not account for the blob data, so limit the memory as well
+  */
+  if (internal_table && share->blob_fields)
+    set_if_smaller(hp_create_info->max_table_size,
+                   MY_MAX(current_thd->variables.tmp_memory_table_size,
+                          sizeof(HP_PTRS)));
   hp_create_info->with_auto_increment= found_real_auto_increment;
   hp_create_info->internal_table= internal_table;
 
@@ -775,6 +792,8 @@ static int heap_prepare_hp_create_info(TABLE *table_arg, bool internal_table,
   hp_create_info->keys= share->keys;
   hp_create_info->reclength= share->reclength;
   hp_create_info->keydef= keydef;
+  hp_create_info->blobs= share->blob_fields;
+  hp_create_info->blob_descs= blob_descs;
   return 0;
 }
 
@@ -869,7 +888,8 @@ int ha_heap::find_unique_row(uchar *record, uint unique_idx)
         We compare it only by record in the index, so better to read all
         records.
       */
-      memcpy(record, file->current_ptr, (size_t) share->reclength);
+      if (hp_extract_record(file, record, file->current_ptr))
+        DBUG_RETURN(-1);
 
       DBUG_RETURN(0); // found and position set
     }
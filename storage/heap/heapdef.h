@@ -33,6 +33,24 @@ C_MODE_START
 #define HP_MIN_RECORDS_IN_BLOCK 16
 #define HP_MAX_RECORDS_IN_BLOCK 8192
 
+/*
+  Blob data is stored in HP_SHARE::blob_block, which is an array of
+  HP_BLOB_CHUNK_SIZE chunks. A blob is a chain of runs of adjacent chunks,
+  each run starting with a HP_BLOB_RUN header. The record points to the
+  data of the first run.
+*/
+
+#define HP_BLOB_CHUNK_SIZE 64
+
+typedef struct st_hp_blob_run
+{
+  uchar *next;				/* Data of the next run or 0 */
+  uint32 length;			/* Blob bytes in this run */
+  uint32 chunks;			/* Chunks used by this run */
+} HP_BLOB_RUN;
+
+#define hp_blob_run(data) (((HP_BLOB_RUN*) (data)) - 1)
+
 	/* Some extern variables */
 
 extern LIST *heap_open_list,*heap_share_list;
@@ -103,6 +121,13 @@ extern uint hp_rb_pack_key(HP_KEYDEF *keydef, uchar *key, const uchar *old,
 extern ha_rows hp_rows_in_memory(size_t reclength, size_t index_size,
                           size_t memory_limit);
 extern size_t hp_memory_needed_per_row(size_t reclength);
+extern int hp_write_blobs(HP_INFO *info, const uchar *record);
+extern void hp_store_blobs(HP_INFO *info, uchar *pos);
+extern void hp_free_blob_ptrs(HP_INFO *info);
+extern void hp_free_blobs(HP_SHARE *share, uchar *pos);
+extern int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos);
+extern int hp_blob_rec_cmp(HP_SHARE *share, const uchar *pos,
+                           const uchar *record);
 
 extern mysql_mutex_t THR_LOCK_heap;
 
@@ -110,6 +135,7 @@ extern PSI_memory_key hp_key_memory_HP_SHARE;
 extern PSI_memory_key hp_key_memory_HP_INFO;
 extern PSI_memory_key hp_key_memory_HP_PTRS;
 extern PSI_memory_key hp_key_memory_HP_KEYDEF;
+extern PSI_memory_key hp_key_memory_HP_BLOB;
 
 #ifdef HAVE_PSI_INTERFACE
 void init_heap_psi_keys();
@@ -0,0 +1,369 @@
+/* Copyright (c) 2026, MariaDB Corporation.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Storage of BLOB/TEXT columns
+
+  The fixed size record keeps the blob length and a pointer, like the
+  record of the server does. The pointer refers to the data of the first
+  run of a chain of runs in share->blob_block (see HP_BLOB_RUN).
+
+  The runs of deleted blobs are kept whole in a list of free runs
+  (share->blob_del_link), which are linked through HP_BLOB_RUN::next and
+  keep their HP_BLOB_RUN::chunks. A new run is cut from the first free run
+  that is long enough, so that a blob of the same size gets a freed run
+  again. If there is none, the longest free run that was looked at is
+  used when it covers at least half of the blob, and otherwise the run is
+  taken from the end of the last allocated block, so that a fragmented
+  free list does not split large blobs into many short runs. The memory
+  is only given back to the system by hp_clear().
+
+  Blobs are always copied to info->blob_buff when a record is read, which
+  is valid until the next read through the same handle. The chunks of a
+  deleted or updated record are reused for the free list at once, while
+  the server may still use the row images, e.g. for the before image of
+  row based replication or OLD values in AFTER triggers.
+*/
+
+#include "heapdef.h"
+
+static ulong hp_calc_blob_length(uint packlength, const uchar *pos)
+{
+  switch (packlength) {
+  case 1:
+    return (uint) (uchar) *pos;
+  case 2:
+    return (uint) uint2korr(pos);
+  case 3:
+    return uint3korr(pos);
+  case 4:
+    return uint4korr(pos);
+  default:
+    break;
+  }
+  return 0; /* Impossible */
+}
+
+
+static inline uchar *hp_get_blob_ptr(HP_BLOB_DESC *desc, const uchar *record)
+{
+  uchar *data;
+  memcpy(&data, record + desc->offset + desc->packlength, sizeof(data));
+  return data;
+}
+
+
+static inline void hp_set_blob_ptr(HP_BLOB_DESC *desc, uchar *record,
+                                   const uchar *data)
+{
+  memcpy(record + desc->offset + desc->packlength, &data, sizeof(data));
+}
+
+
+/* The number of free runs that are looked at for a new run */
+#define HP_BLOB_FREE_SEARCH 64
+
+/*
+  Get up to *chunks adjacent chunks for a new run
+
+  RETURN
+    0   Out of memory, my_errno is set
+    #   Start of the run, *chunks is set to the number of chunks got
+*/
+
+static uchar *hp_alloc_chunks(HP_SHARE *share, ulong *chunks)
+{
+  HP_BLOCK *block= &share->blob_block;
+  uchar **link, **best= 0;
+  HP_BLOB_RUN *run;
+  ulong block_pos;
+  uint n;
+
+  for (link= &share->blob_del_link, n= 0;
+       *link && n < HP_BLOB_FREE_SEARCH;
+       link= &run->next, n++)
+  {
+    run= (HP_BLOB_RUN*) *link;
+    if (run->chunks > *chunks)
+    {
+      /* Take the end of the free run, which stays in the list */
+      run->chunks-= (uint32) *chunks;
+      return (uchar*) run + (size_t) run->chunks * HP_BLOB_CHUNK_SIZE;
+    }
+    if (run->chunks == *chunks)
+    {
+      *link= run->next;
+      return (uchar*) run;
+    }
+    if (!best || run->chunks > ((HP_BLOB_RUN*) *best)->chunks)
+      best= link;
+  }
+
+  block_pos= share->blob_chunks % block->records_in_block;
+  if (best &&
+      (((HP_BLOB_RUN*) *best)->chunks * 2 >= *chunks ||
+       (!block_pos &&
+        share->data_length + share->index_length >= share->max_table_size)))
+  {
+    /* Use the whole free run; the rest of the blob gets another run */
+    run= (HP_BLOB_RUN*) *best;
+    *best= run->next;
+    *chunks= run->chunks;
+    return (uchar*) run;
+  }
+
+  if (!block_pos)
+  {
+    size_t length;
+    if (share->data_length + share->index_length >= share->max_table_size)
+    {
+      DBUG_PRINT("error",
+                 ("blob file full. data_length: %llu  index_length: %llu  "
+                  "max_table_size: %llu",
+                  share->data_length, share->index_length,
+                  share->max_table_size));
+      my_errno= HA_ERR_RECORD_FILE_FULL;
+      return 0;
+    }
+    if (hp_get_new_block(share, block, &length))
+      return 0;
+    share->data_length+= length;
+  }
+  set_if_smaller(*chunks, block->records_in_block - block_pos);
+  share->blob_chunks+= *chunks;
+  return (uchar*) block->level_info[0].last_blocks +
+    block_pos * block->recbuffer;
+}
+
+
+/* Put the runs of a blob into the list of free runs */
+
+static void hp_free_blob(HP_SHARE *share, uchar *data)
+{
+  while (data)
+  {
+    HP_BLOB_RUN *run= hp_blob_run(data);
+    data= run->next;
+    run->next= share->blob_del_link;
+    share->blob_del_link= (uchar*) run;
+  }
+}
+
+
+/*
+  Copy a blob into a new chain of runs
+
+  RETURN
+    0   ok, *first is set to the data of the first run
+    #   error, nothing is allocated
+*/
+
+static int hp_write_blob(HP_SHARE *share, const uchar *data, ulong length,
+                         uchar **first)
+{
+  uchar **link= first;
+  *first= 0;
+  while (length)
+  {
+    ulong chunks= (ulong) ((length + sizeof(HP_BLOB_RUN) +
+                            HP_BLOB_CHUNK_SIZE - 1) / HP_BLOB_CHUNK_SIZE);
+    ulong run_length;
+    HP_BLOB_RUN *run;
+
+    if (!(run= (HP_BLOB_RUN*) hp_alloc_chunks(share, &chunks)))
+    {
+      hp_free_blob(share, *first);
+      *first= 0;
+      return my_errno;
+    }
+    run_length= MY_MIN(length,
+                       chunks * HP_BLOB_CHUNK_SIZE - sizeof(HP_BLOB_RUN));
+    run->next= 0;
+    run->length= (uint32) run_length;
+    run->chunks= (uint32) chunks;
+    memcpy(run + 1, data, run_length);
+    *link= (uchar*) (run + 1);
+    link= &run->next;
+    data+= run_length;
+    length-= run_length;
+  }
+  return 0;
+}
+
+
+/*
+  Store the blobs of a record that is going to be written
+
+  NOTES
+    The data pointers are saved in info->blob_ptrs until they are put
+    into the stored record by hp_store_blobs() or freed by
+    hp_free_blob_ptrs(). The old blobs of an updated record are still
+    readable while the new ones are written.
+
+  RETURN
+    0   ok
+    #   error number, no blob data is allocated
+*/
+
+int hp_write_blobs(HP_INFO *info, const uchar *record)
+{
+  HP_SHARE *share= info->s;
+  uint i;
+  DBUG_ENTER("hp_write_blobs");
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    HP_BLOB_DESC *desc= share->blob_descs + i;
+    ulong length= hp_calc_blob_length(desc->packlength,
+                                      record + desc->offset);
+    if (hp_write_blob(share, hp_get_blob_ptr(desc, record), length,
+                      info->blob_ptrs + i))
+    {
+      while (i--)
+        hp_free_blob(share, info->blob_ptrs[i]);
+      DBUG_RETURN(my_errno);
+    }
+  }
+  DBUG_RETURN(0);
+}
+
+
+/* Put the blobs written by hp_write_blobs() into the stored record */
+
+void hp_store_blobs(HP_INFO *info, uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  uint i;
+  for (i= 0; i < share->blobs; i++)
+    hp_set_blob_ptr(share->blob_descs + i, pos, info->blob_ptrs[i]);
+}
+
+
+/* Free the blobs written by hp_write_blobs() when the write failed */
+
+void hp_free_blob_ptrs(HP_INFO *info)
+{
+  HP_SHARE *share= info->s;
+  uint i;
+  for (i= 0; i < share->blobs; i++)
+    hp_free_blob(share, info->blob_ptrs[i]);
+}
+
+
+/* Free the blobs of a stored record */
+
+void hp_free_blobs(HP_SHARE *share, uchar *pos)
+{
+  uint i;
+  for (i= 0; i < share->blobs; i++)
+  {
+    hp_free_blob(share, hp_get_blob_ptr(share->blob_descs + i, pos));
+    hp_set_blob_ptr(share->blob_descs + i, pos, 0);
+  }
+}
+
+
+/*
+  Copy a stored record to the caller
+
+  RETURN
+    0   ok
+    #   error number (out of memory)
+*/
+
+int hp_extract_record(HP_INFO *info, uchar *record, const uchar *pos)
+{
+  HP_SHARE *share= info->s;
+  size_t length= 0;
+  uchar *buff;
+  uint i;
+
+  memcpy(record, pos, (size_t) share->reclength);
+  if (!share->blobs)
+    return 0;
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    HP_BLOB_DESC *desc= share->blob_descs + i;
+    if (hp_get_blob_ptr(desc, record))
+      length+= hp_calc_blob_length(desc->packlength, record + desc->offset);
+  }
+  if (!length)
+    return 0;
+
+  if (length > info->blob_buff_length)
+  {
+    my_free(info->blob_buff);
+    if (!(info->blob_buff= (uchar*) my_malloc(hp_key_memory_HP_BLOB, length,
+                                              MYF(MY_WME |
+                                                  (share->internal ?
+                                                   MY_THREAD_SPECIFIC : 0)))))
+    {
+      info->blob_buff_length= 0;
+      return my_errno;
+    }
+    info->blob_buff_length= length;
+  }
+
+  for (i= 0, buff= info->blob_buff; i < share->blobs; i++)
+  {
+    HP_BLOB_DESC *desc= share->blob_descs + i;
+    uchar *data= hp_get_blob_ptr(desc, record);
+    if (!data)
+      continue;
+    hp_set_blob_ptr(desc, record, buff);
+    for (; data; data= hp_blob_run(data)->next)
+    {
+      memcpy(buff, data, hp_blob_run(data)->length);
+      buff+= hp_blob_run(data)->length;
+    }
+  }
+  return 0;
+}
+
+
+/*
+  Compare a stored record with a record read from it
+
+  RETURN
+    0   The records are equal
+    1   The records differ
+*/
+
+int hp_blob_rec_cmp(HP_SHARE *share, const uchar *pos, const uchar *record)
+{
+  uint i, start= 0;
+
+  for (i= 0; i < share->blobs; i++)
+  {
+    HP_BLOB_DESC *desc= share->blob_descs + i;
+    uint end= desc->offset + desc->packlength;
+    const uchar *data, *rec_data;
+
+    if (memcmp(pos + start, record + start, end - start))
+      return 1;
+    data= hp_get_blob_ptr(desc, pos);
+    rec_data= hp_get_blob_ptr(desc, record);
+    for (; data; data= hp_blob_run(data)->next)
+    {
+      if (memcmp(data, rec_data, hp_blob_run(data)->length))
+        return 1;
+      rec_data+= hp_blob_run(data)->length;
+    }
+    start= end + sizeof(uchar*);
+  }
+  return MY_TEST(memcmp(pos + start, record + start,
+                        share->reclength - start));
+}
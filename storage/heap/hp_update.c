@@ -32,6 +32,8 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
 
   if (info->opt_flag & READ_CHECK_USED && hp_rectest(info,old))
     DBUG_RETURN(my_errno);				/* Record changed */
+  if (share->blobs && hp_write_blobs(info, heap_new))
+    DBUG_RETURN(my_errno);
   if (--(share->records) < share->blength >> 1) share->blength>>= 1;
   share->changed=1;
 
@@ -52,7 +54,11 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
     }
   }
 
+  if (share->blobs)
+    hp_free_blobs(share, pos);
   memcpy(pos,heap_new,(size_t) share->reclength);
+  if (share->blobs)
+    hp_store_blobs(info, pos);
   if (++(share->records) == share->blength) share->blength+= share->blength;
 
 #if !defined(DBUG_OFF) && defined(EXTRA_HEAP_DEBUG)
@@ -92,6 +98,8 @@ int heap_update(HP_INFO *info, const uchar *old, const uchar *heap_new)
     info->current_ptr= recovery_ptr;
     info->current_hash_ptr= recovery_hash_ptr;
   }
+  if (share->blobs)
+    hp_free_blob_ptrs(info);
   if (++(share->records) == share->blength)
     share->blength+= share->blength;
   DBUG_RETURN(my_errno);
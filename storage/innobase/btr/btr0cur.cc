@@ -1522,6 +1522,8 @@ dberr_t btr_cur_t::search_leaf(const dtuple_t *tuple, page_cur_mode_t mode,
   if (!--height)
   {
     /* We are about to access the leaf level. */
+    parent_page_no= block->page.id().page_no();
+    ra_window= 0;
 
     switch (latch_mode) {
     case BTR_MODIFY_ROOT_AND_LEAF:
@@ -2037,8 +2039,13 @@ dberr_t btr_cur_t::open_leaf(bool first, dict_index_t *index,
 
     if (latch_mode != BTR_MODIFY_TREE)
     {
-      if (!height && first && first_access)
-        buf_read_ahead_linear(page_id_t(block->page.id().space(), page));
+      if (!height)
+      {
+        parent_page_no= block->page.id().page_no();
+        ra_window= 0;
+        if (first && first_access && !srv_read_ahead_logical)
+          buf_read_ahead_linear(page_id_t(block->page.id().space(), page));
+      }
     }
     else if (btr_cur_need_opposite_intention(block->page, index->is_clust(),
                                              lock_intention,
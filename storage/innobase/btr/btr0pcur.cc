@@ -476,6 +476,114 @@ btr_pcur_t::restore_position(btr_latch_mode restore_latch_mode, mtr_t *mtr)
 	return ret_val;
 }
 
+/** Find the node pointer to a leaf page in a parent page, without
+waiting for a page latch.
+@param index    index tree
+@param id       identifier of the parent page
+@param leaf     leaf page number
+@param mtr      mini-transaction
+@param offsets  record offsets
+@param heap     memory heap for offsets
+@return the node pointer to leaf
+@retval nullptr if not found */
+static const rec_t *btr_pcur_find_node_ptr(const dict_index_t &index,
+                                           const page_id_t id,
+                                           uint32_t leaf, mtr_t *mtr,
+                                           rec_offs *&offsets,
+                                           mem_heap_t *&heap) noexcept
+{
+  const buf_block_t *parent= buf_page_try_get(id, mtr);
+  if (!parent)
+    return nullptr;
+  const page_t *page= parent->page.frame;
+  if (!fil_page_index_page_check(page) || btr_page_get_level(page) != 1 ||
+      btr_page_get_index_id(page) != index.id)
+    return nullptr;
+  for (const rec_t *rec= page_rec_get_next_const(page_get_infimum_rec(page));
+       rec && !page_rec_is_supremum(rec); rec= page_rec_get_next_const(rec))
+  {
+    offsets= rec_get_offsets(rec, &index, offsets, 0, ULINT_UNDEFINED, &heap);
+    if (btr_node_ptr_get_child_page_no(rec, offsets) == leaf)
+      return rec;
+  }
+  return nullptr;
+}
+
+/** Submit asynchronous reads for the innodb_read_ahead_logical leaf
+pages that follow a leaf page in the key order, based on the node
+pointers in the parent page. Unlike buf_read_ahead_linear(), this
+works also when the leaf pages are not allocated in the key order.
+@param cursor  persistent cursor
+@param block   leaf page that the cursor was moved to
+@param mtr     mini-transaction */
+static void btr_pcur_read_ahead_logical(btr_pcur_t *cursor,
+                                        const buf_block_t &block,
+                                        const mtr_t &mtr) noexcept
+{
+  btr_cur_t &cur= cursor->btr_cur;
+  const uint32_t n_pages= uint32_t(srv_read_ahead_logical);
+
+  if (!cur.parent_page_no)
+    return;
+  /* Look for more pages after half of the window was consumed. */
+  if (cur.ra_window > n_pages / 2)
+  {
+    cur.ra_window--;
+    return;
+  }
+
+  const dict_index_t &index= *cursor->index();
+  fil_space_t *const space= index.table->space;
+  const uint32_t leaf= block.page.id().page_no();
+  page_id_t id{space->id, cur.parent_page_no};
+  mem_heap_t *heap= nullptr;
+  rec_offs offsets_[REC_OFFS_NORMAL_SIZE];
+  rec_offs *offsets= offsets_;
+  rec_offs_init(offsets_);
+
+  mtr_t parent_mtr{mtr.trx};
+  parent_mtr.start();
+
+  /* We are holding a latch on the leaf page. Therefore, we must not
+  wait for a latch on the parent page. If the cursor has moved past
+  the last child of the parent page, try the right sibling. */
+  const rec_t *rec= btr_pcur_find_node_ptr(index, id, leaf, &parent_mtr,
+                                           offsets, heap);
+  if (!rec && parent_mtr.get_savepoint())
+  {
+    id.set_page_no(btr_page_get_next(parent_mtr.at_savepoint(0)->
+                                     page.frame));
+    rec= id.page_no() == FIL_NULL
+      ? nullptr
+      : btr_pcur_find_node_ptr(index, id, leaf, &parent_mtr, offsets, heap);
+    if (!rec && parent_mtr.get_savepoint() > 1)
+      /* The parent is not known; stop the read-ahead. */
+      cur.parent_page_no= 0;
+  }
+
+  if (rec)
+  {
+    cur.parent_page_no= id.page_no();
+    cur.ra_window= 0;
+    while ((rec= page_rec_get_next_const(rec)) && !page_rec_is_supremum(rec) &&
+           cur.ra_window < n_pages)
+    {
+      offsets= rec_get_offsets(rec, &index, offsets, 0, ULINT_UNDEFINED,
+                               &heap);
+      cur.ra_window++;
+      if (space->acquire())
+        buf_read_page_background(page_id_t{space->id,
+                                           btr_node_ptr_get_child_page_no
+                                           (rec, offsets)},
+                                 space, mtr.trx);
+    }
+  }
+
+  parent_mtr.commit();
+  if (heap)
+    mem_heap_free(heap);
+}
+
 /*********************************************************//**
 Moves the persistent cursor to the first record on the next page. Releases the
 latch on the current page, and bufferunfixes it. Note that there must not be
@@ -533,7 +641,16 @@ btr_pcur_move_to_next_page(
 
 	const auto s = mtr->get_savepoint();
 	mtr->rollback_to_savepoint(s - 2, s - 1);
-	if (first_access) {
+	if (srv_read_ahead_logical) {
+		if (!first_access) {
+			if (cursor->btr_cur.ra_window) {
+				cursor->btr_cur.ra_window--;
+			}
+		} else {
+			btr_pcur_read_ahead_logical(cursor, *next_block,
+						    *mtr);
+		}
+	} else if (first_access) {
 		buf_read_ahead_linear(next_block->page.id());
 	}
 	return DB_SUCCESS;
@@ -1490,8 +1490,13 @@ bool buf_pool_t::create() noexcept
   pthread_cond_init(&done_free, nullptr);
 
   try_LRU_scan= true;
+  n_flush_task_hp= 0;
 
   ut_d(flush_hp.m_mutex= &flush_list_mutex;);
+#ifdef UNIV_DEBUG
+  for (FlushHp &hp : flush_task_hp)
+    hp.m_mutex= &flush_list_mutex;
+#endif
   ut_d(lru_hp.m_mutex= &mutex);
   ut_d(lru_scan_itr.m_mutex= &mutex);
 
@@ -40,6 +40,7 @@ Created April 08, 2011 Vasil Dimov
 #include "ut0byte.h"
 
 #include <algorithm>
+#include <thread>
 
 #include "mysql/service_wsrep.h" /* wsrep_recovery */
 #include <my_service_manager.h>
@@ -47,6 +48,7 @@ Created April 08, 2011 Vasil Dimov
 static void buf_do_load_dump();
 
 enum status_severity {
+	STATUS_VERBOSE,
 	STATUS_INFO,
 	STATUS_ERR
 };
@@ -102,6 +104,9 @@ buf_dump_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_dump_status;
 		break;
@@ -141,6 +146,9 @@ buf_load_status(
 		fmt, ap);
 
 	switch (severity) {
+	case STATUS_VERBOSE:
+		break;
+
 	case STATUS_INFO:
 		ib::info() << export_vars.innodb_buffer_pool_load_status;
 		break;
@@ -326,6 +334,9 @@ buf_dump(
 		return;
 	}
 
+	/* Dump the pages from the most recently used to the least
+	recently used. buf_load() will read the pages in this order of
+	hotness. */
 	for (bpage = UT_LIST_GET_FIRST(buf_pool.LRU), j = 0;
 	     bpage != NULL && j < n_pages;
 	     bpage = UT_LIST_GET_NEXT(LRU, bpage)) {
@@ -415,6 +426,40 @@ buf_dump(
 	export_vars.innodb_buffer_pool_load_incomplete = 0;
 }
 
+/** Number of pages that buf_load() will submit in the order of the
+file offset. A larger batch allows more adjacent reads to be merged,
+at the cost of reading some less recently used pages earlier. */
+static constexpr ulint BUF_LOAD_BATCH = 4096;
+
+/** Wait while buf_load() would occupy too many of the asynchronous
+read slots, so that user reads do not have to wait for the load. */
+static void buf_load_throttle()
+{
+	const size_t	max_pending = srv_n_read_io_threads
+		* OS_AIO_N_PENDING_IOS_PER_THREAD / 2;
+
+	while (os_aio_pending_reads_approx() >= max_pending
+	       && !SHUTTING_DOWN() && !buf_load_abort_flag) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+/** Report the progress of buf_load() in innodb_buffer_pool_load_status.
+@param i	number of pages submitted so far
+@param n	total number of pages to load
+@param start	time when the reads were started */
+static void buf_load_progress(ulint i, ulint n, time_t start)
+{
+	ut_ad(i > 0);
+	ut_ad(i <= n);
+	const double	elapsed = difftime(time(NULL), start);
+
+	buf_load_status(STATUS_VERBOSE,
+			"Loaded " ULINTPF "/" ULINTPF " pages,"
+			" estimated %.0f seconds remaining",
+			i, n, elapsed * double(n - i) / double(i));
+}
+
 /*****************************************************************//**
 Perform a buffer pool load from the file specified by
 innodb_buffer_pool_filename. If any errors occur then the value of
@@ -561,7 +606,6 @@ buf_load()
 	}
 
 	if (!SHUTTING_DOWN()) {
-		std::sort(dump, dump + dump_n);
 		std::set<uint32_t> missing;
 		for (const page_id_t id : st_::span<const page_id_t>
 		       (dump, dump_n)) {
@@ -581,10 +625,12 @@ buf_load()
 	}
 
 	/* Avoid calling the expensive fil_space_t::get() for each
-	page within the same tablespace. dump[] is sorted by (space, page),
-	so all pages from a given tablespace are consecutive. */
-	uint32_t	cur_space_id = dump[0].space();
-	fil_space_t*	space = fil_space_t::get(cur_space_id);
+	page within the same tablespace. Each batch of dump[] will be
+	sorted by (space, page), so that the pages of a tablespace are
+	consecutive and will be read in the order of the file offset. */
+	uint32_t	cur_space_id = SRV_SPACE_ID_UPPER_BOUND;
+	fil_space_t*	space = nullptr;
+	const time_t	start = time(NULL);
 
 	PSI_stage_progress*	pfs_stage_progress __attribute__((unused))
 		= mysql_set_stage(srv_stage_buffer_pool_load.m_key);
@@ -593,6 +639,18 @@ buf_load()
 
 	for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
 
+		if (!(i % BUF_LOAD_BATCH)) {
+			/* dump[] is ordered from the hottest page to the
+			coldest. Read the hottest batch first. */
+			std::sort(dump + i,
+				  dump + std::min(i + BUF_LOAD_BATCH, dump_n));
+			if (i) {
+				buf_load_progress(i, dump_n, start);
+				mysql_stage_set_work_completed(
+					pfs_stage_progress, i);
+			}
+		}
+
 		/* space_id for this iteration of the loop */
 		const uint32_t this_space_id = dump[i].space();
 
@@ -624,6 +682,7 @@ buf_load()
 			continue;
 		}
 
+		buf_load_throttle();
 		space->reacquire();
 		buf_read_page_background(dump[i], space, nullptr);
 
@@ -764,6 +823,33 @@ static void buf_do_load_dump()
     srv_thread_pool->submit_task(&buf_dump_load_task);
 }
 
+/** Start a buffer pool dump every innodb_buffer_pool_dump_interval
+seconds, if any pages were read into or created in the buffer pool
+since the previous periodic dump. */
+void buf_dump_periodic()
+{
+  static time_t last_time;
+  static ulint last_n_pages;
+
+  if (!srv_buf_dump_interval || !load_dump_enabled ||
+      export_vars.innodb_buffer_pool_load_incomplete)
+    return;
+
+  const time_t now= time(nullptr);
+  if (!last_time)
+    last_time= now;
+  if (difftime(now, last_time) < double(srv_buf_dump_interval))
+    return;
+  last_time= now;
+
+  const ulint n_pages= buf_pool.stat.n_pages_read +
+    buf_pool.stat.n_pages_created;
+  if (n_pages == last_n_pages)
+    return;
+  last_n_pages= n_pages;
+  buf_dump_start();
+}
+
 /** Wait for currently running load/dumps to finish*/
 void buf_load_dump_end()
 {
@@ -39,6 +39,7 @@ Created 11/11/1995 Heikki Tuuri
 #include "page0zip.h"
 #include "fil0fil.h"
 #include "log0crypt.h"
+#include "log0arch.h"
 #include "srv0mon.h"
 #include "fil0pagecompress.h"
 #include "lzo/lzo1x.h"
@@ -165,7 +166,7 @@ void buf_pool_t::delete_from_flush_list(buf_page_t *bpage) noexcept
 {
   ut_ad(!fsp_is_system_temporary(bpage->id().space()));
   mysql_mutex_assert_owner(&flush_list_mutex);
-  flush_hp.adjust(bpage);
+  flush_hp_adjust(bpage);
   UT_LIST_REMOVE(flush_list, bpage);
   flush_list_bytes-= bpage->physical_size();
   bpage->clear_oldest_modification();
@@ -254,7 +255,7 @@ buf_flush_relocate_on_flush_list(
 
 	/* Important that we adjust the hazard pointer before removing
 	the bpage from the flush list. */
-	buf_pool.flush_hp.adjust(bpage);
+	buf_pool.flush_hp_adjust(bpage);
 
 	prev = UT_LIST_GET_PREV(list, bpage);
 	UT_LIST_REMOVE(buf_pool.flush_list, bpage);
@@ -1424,8 +1425,13 @@ static void buf_do_LRU_batch(ulint max, flush_counters_t *n) noexcept
 The calling thread is not allowed to own any latches on pages!
 @param max_n    maximum mumber of blocks to flush
 @param lsn      once an oldest_modification>=lsn is found, terminate the batch
+@param hp       hazard pointer of the scan
+@param len      ULINT_UNDEFINED to scan from the end of buf_pool.flush_list,
+                or the number of blocks to scan, starting from hp.get()
 @return number of blocks for which the write request was queued */
-static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
+static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn,
+                                     FlushHp &hp= buf_pool.flush_hp,
+                                     ulint len= ULINT_UNDEFINED) noexcept
 {
   ulint count= 0;
   ulint scanned= 0;
@@ -1440,12 +1446,20 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
   static_assert(FIL_NULL > SRV_TMP_SPACE_ID, "consistency");
   static_assert(FIL_NULL > SRV_SPACE_ID_UPPER_BOUND, "consistency");
 
-  /* Start from the end of the list looking for a suitable block to be
-  flushed. */
-  ulint len= UT_LIST_GET_LEN(buf_pool.flush_list);
+  buf_page_t *bpage;
 
-  for (buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
-       bpage && len && count < max_n; ++scanned, len--)
+  if (len == ULINT_UNDEFINED)
+  {
+    /* Start from the end of the list looking for a suitable block to be
+    flushed. */
+    len= UT_LIST_GET_LEN(buf_pool.flush_list);
+    bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
+  }
+  else
+    /* Start from where buf_flush_list_batch() positioned us. */
+    bpage= hp.get();
+
+  for (; bpage && len && count < max_n; ++scanned, len--)
   {
     const lsn_t oldest_modification= bpage->oldest_modification();
     if (oldest_modification >= lsn)
@@ -1484,9 +1498,10 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
       Note: A concurrent execution of buf_flush_list_space() may
       terminate this scan prematurely. The buf_pool.flush_list_active
       should prevent multiple threads from executing
-      buf_do_flush_list_batch() concurrently,
+      buf_do_flush_list_batch() concurrently, except for the tasks of
+      buf_flush_list_batch() that use buf_pool.flush_task_hp,
       but buf_flush_list_space() is ignoring that. */
-      buf_pool.flush_hp.set(prev);
+      hp.set(prev);
     }
 
     const page_id_t page_id(bpage->id());
@@ -1535,10 +1550,10 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
     }
 
     mysql_mutex_lock(&buf_pool.flush_list_mutex);
-    bpage= buf_pool.flush_hp.get();
+    bpage= hp.get();
   }
 
-  buf_pool.flush_hp.set(nullptr);
+  hp.set(nullptr);
 
   if (space)
     space->release();
@@ -1554,6 +1569,122 @@ static ulint buf_do_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
   return count;
 }
 
+namespace
+{
+/** An additional task of buf_flush_list_batch() */
+struct buf_flush_list_task
+{
+  /** parameters of buf_do_flush_list_batch() */
+  ulint max_n, len;
+  /** parameter of buf_do_flush_list_batch() */
+  lsn_t lsn;
+  /** parameter of buf_do_flush_list_batch(); an element of
+  buf_pool.flush_task_hp */
+  FlushHp *hp;
+  /** the result of buf_do_flush_list_batch() */
+  ulint n_flushed;
+  /** the task that is submitted to srv_thread_pool */
+  tpool::waitable_task submitted;
+
+  buf_flush_list_task() : submitted(execute, this) {}
+
+  static void execute(void *arg) noexcept
+  {
+    buf_flush_list_task *t= static_cast<buf_flush_list_task*>(arg);
+    mysql_mutex_lock(&buf_pool.mutex);
+    mysql_mutex_lock(&buf_pool.flush_list_mutex);
+    t->n_flushed= buf_do_flush_list_batch(t->max_n, t->lsn, *t->hp, t->len);
+    mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+    mysql_mutex_unlock(&buf_pool.mutex);
+  }
+};
+
+/** The additional tasks of buf_flush_list_batch(); only accessed by the
+thread that set buf_pool.flush_list_active() */
+buf_flush_list_task buf_flush_list_tasks[buf_pool_t::FLUSH_TASKS_MAX - 1];
+}
+
+/** Flush dirty blocks from the end of the flush_list, in up to
+innodb_page_cleaner_tasks concurrent tasks. The end of the flush_list
+is divided into contiguous parts, and each task will only scan its own
+part, so that the checksum computation, encryption and submission of
+the writes can proceed in parallel.
+@param max_n    maximum mumber of blocks to flush
+@param lsn      once an oldest_modification>=lsn is found, terminate the batch
+@return number of blocks for which the write request was queued */
+static ulint buf_flush_list_batch(ulint max_n, lsn_t lsn) noexcept
+{
+  mysql_mutex_assert_owner(&buf_pool.mutex);
+  mysql_mutex_assert_owner(&buf_pool.flush_list_mutex);
+  ut_ad(buf_pool.flush_list_active());
+
+  /* Do not bother with small batches. */
+  constexpr ulint min_pages_per_task= 32;
+  const ulint n_tasks=
+    std::min<ulint>(buf_pool.flush_tasks,
+                    std::min<ulint>(max_n,
+                                    UT_LIST_GET_LEN(buf_pool.flush_list)) /
+                    min_pages_per_task);
+
+  if (n_tasks <= 1 || !srv_thread_pool)
+    return buf_do_flush_list_batch(max_n, lsn);
+
+  ut_ad(n_tasks <= buf_pool_t::FLUSH_TASKS_MAX);
+  ut_ad(!buf_pool.n_flush_task_hp);
+
+  /* Find the blocks that a single-threaded batch would scan at most. */
+  ulint len= 0;
+  for (const buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
+       bpage && len < max_n && bpage->oldest_modification() < lsn;
+       bpage= UT_LIST_GET_PREV(list, bpage))
+    len++;
+
+  const ulint n= max_n / n_tasks + 1;
+  const ulint part= len / n_tasks;
+  if (!part)
+    return buf_do_flush_list_batch(max_n, lsn);
+
+  /* Position the hazard pointers of the tasks at the start of their
+  parts. Any block that is removed from the flush_list while the
+  tasks are running will adjust them. */
+  buf_page_t *bpage= UT_LIST_GET_LAST(buf_pool.flush_list);
+  buf_pool.n_flush_task_hp= n_tasks - 1;
+  for (ulint i= 1; i < n_tasks; i++)
+  {
+    for (ulint j= part; j--; )
+      bpage= UT_LIST_GET_PREV(list, bpage);
+    buf_flush_list_task &t= buf_flush_list_tasks[i - 1];
+    t.hp= &buf_pool.flush_task_hp[i - 1];
+    t.hp->set(bpage);
+    t.max_n= n;
+    t.len= i == n_tasks - 1 ? len - i * part : part;
+    t.lsn= lsn;
+    t.n_flushed= 0;
+  }
+
+  for (ulint i= 1; i < n_tasks; i++)
+    srv_thread_pool->submit_task(&buf_flush_list_tasks[i - 1].submitted);
+
+  buf_pool.flush_hp.set(UT_LIST_GET_LAST(buf_pool.flush_list));
+  ulint count= buf_do_flush_list_batch(n, lsn, buf_pool.flush_hp, part);
+  mysql_mutex_unlock(&buf_pool.flush_list_mutex);
+  mysql_mutex_unlock(&buf_pool.mutex);
+
+  tpool::tpool_wait_begin();
+  for (ulint i= 1; i < n_tasks; i++)
+  {
+    buf_flush_list_task &t= buf_flush_list_tasks[i - 1];
+    t.submitted.wait();
+    count+= t.n_flushed;
+  }
+  tpool::tpool_wait_end();
+
+  mysql_mutex_lock(&buf_pool.mutex);
+  mysql_mutex_lock(&buf_pool.flush_list_mutex);
+  buf_pool.n_flush_task_hp= 0;
+  return count;
+}
+
 /** Wait until a LRU flush batch ends. */
 void buf_flush_wait_LRU_batch_end() noexcept
 {
@@ -1599,7 +1730,7 @@ static ulint buf_flush_list_holding_mutex(ulint max_n= ULINT_UNDEFINED,
     goto nothing_to_do;
   }
   buf_pool.flush_list_set_active();
-  const ulint n_flushed= buf_do_flush_list_batch(max_n, lsn);
+  const ulint n_flushed= buf_flush_list_batch(max_n, lsn);
   if (n_flushed)
     buf_pool.stat.n_pages_written+= n_flushed;
   buf_pool.flush_list_set_inactive();
@@ -1985,6 +2116,17 @@ static bool log_checkpoint_low(lsn_t oldest_lsn, lsn_t end_lsn) noexcept
   ut_ad(oldest_lsn <= end_lsn);
   ut_ad(end_lsn == log_sys.get_lsn());
 
+  if (const lsn_t archived_lsn= log_sys.archived_lsn)
+  {
+    ut_ad(archived_lsn >= log_sys.last_checkpoint_lsn);
+    if (oldest_lsn > archived_lsn)
+    {
+      /* Do not discard any log that has not been archived yet. */
+      log_archive_wake();
+      oldest_lsn= archived_lsn;
+    }
+  }
+
   if (oldest_lsn == log_sys.last_checkpoint_lsn ||
       (oldest_lsn == end_lsn &&
        !log_sys.resize_in_progress() &&
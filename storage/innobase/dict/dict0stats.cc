@@ -2590,7 +2590,73 @@ static index_stats_t dict_stats_analyze_index(trx_t *trx, dict_index_t* index)
 	DBUG_RETURN(result);
 }
 
-dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept
+namespace
+{
+/** A batch of indexes that are being analyzed by concurrent tasks */
+struct dict_stats_analyze_batch
+{
+  /** the indexes to analyze */
+  const std::vector<dict_index_t*> &indexes;
+  /** the statistics of indexes[] */
+  std::vector<index_stats_t> &stats;
+  /** the next element of indexes[] to analyze */
+  std::atomic<size_t> next{0};
+
+  dict_stats_analyze_batch(const std::vector<dict_index_t*> &indexes,
+                           std::vector<index_stats_t> &stats) :
+    indexes(indexes), stats(stats) {}
+
+  void work(trx_t *trx) noexcept
+  {
+    for (size_t i; (i= next.fetch_add(1, std::memory_order_relaxed)) <
+           indexes.size(); )
+      stats[i]= dict_stats_analyze_index(trx, indexes[i]);
+  }
+
+  static void task_func(void *arg) noexcept
+  {
+    /* The handler statistics of trx are not thread-safe. */
+    static_cast<dict_stats_analyze_batch*>(arg)->work(nullptr);
+  }
+};
+}
+
+/** Analyze indexes, in up to innodb_stats_persistent_threads concurrent
+tasks.
+@param trx      transaction
+@param indexes  indexes to analyze
+@param stats    the statistics of indexes[] */
+static void dict_stats_analyze_indexes(trx_t *trx,
+                                       const std::vector<dict_index_t*>
+                                       &indexes,
+                                       std::vector<index_stats_t> &stats)
+{
+  ut_ad(stats.size() == indexes.size());
+  dict_stats_analyze_batch batch(indexes, stats);
+  std::vector<tpool::waitable_task*> tasks;
+
+  if (srv_thread_pool)
+  {
+    const size_t n_tasks= std::min<size_t>(srv_stats_persistent_threads,
+                                           indexes.size());
+    for (size_t i= 1; i < n_tasks; i++)
+    {
+      tasks.push_back(new tpool::waitable_task(batch.task_func, &batch));
+      srv_thread_pool->submit_task(tasks.back());
+    }
+  }
+
+  batch.work(trx);
+
+  for (tpool::waitable_task *task : tasks)
+  {
+    task->wait();
+    delete task;
+  }
+}
+
+dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table,
+                                     bool incremental) noexcept
 {
 	dict_index_t*	index;
 
@@ -2620,6 +2686,9 @@ dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept
 	}
 
 	table->stats_mutex_lock();
+	/* The statistics of a secondary index can only be kept if
+	they have been calculated or loaded before. */
+	incremental = incremental && table->stat_initialized();
 	dict_stats_empty_index(index);
 	table->stats_mutex_unlock();
 
@@ -2649,6 +2718,9 @@ dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept
 
 	table->stat_sum_of_other_index_sizes = 0;
 
+	std::vector<dict_index_t*> indexes;
+	std::vector<index_stats_t> index_stats;
+
 	for (index = dict_table_get_next_index(index);
 	     index != NULL;
 	     index = dict_table_get_next_index(index)) {
@@ -2657,15 +2729,35 @@ dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept
 			continue;
 		}
 
+		/* Like dict_stats_update_if_needed(), keep the
+		statistics of an index in which less than 10% of
+		the records were modified. */
+		if (incremental
+		    && index->stat_modified_counter
+		    <= table->stat_n_rows / 10) {
+			table->stat_sum_of_other_index_sizes
+				+= index->stat_index_size;
+			continue;
+		}
+
 		dict_stats_empty_index(index);
 
 		if (dict_stats_should_ignore_index(index)) {
 			continue;
 		}
 
-		table->stats_mutex_unlock();
-		stats = dict_stats_analyze_index(trx, index);
-		table->stats_mutex_lock();
+		index->stat_modified_counter = 0;
+		indexes.push_back(index);
+		index_stats.emplace_back(dict_index_get_n_unique(index));
+	}
+
+	table->stats_mutex_unlock();
+	dict_stats_analyze_indexes(trx, indexes, index_stats);
+	table->stats_mutex_lock();
+
+	for (size_t i = 0; i < indexes.size(); i++) {
+		index = indexes[i];
+		stats = std::move(index_stats[i]);
 
 		if (stats.is_bulk_operation()) {
 			table->stats_mutex_unlock();
@@ -2702,13 +2794,13 @@ dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept
 	return(DB_SUCCESS);
 }
 
-dberr_t dict_stats_update_persistent_try(trx_t *trx, dict_table_t *table)
-  noexcept
+dberr_t dict_stats_update_persistent_try(trx_t *trx, dict_table_t *table,
+                                         bool incremental) noexcept
 {
   if (table->stats_is_persistent() &&
       dict_stats_persistent_storage_check(false) == SCHEMA_OK)
   {
-    if (dberr_t err= dict_stats_update_persistent(trx, table))
+    if (dberr_t err= dict_stats_update_persistent(trx, table, incremental))
       return err;
     return dict_stats_save(table);
   }
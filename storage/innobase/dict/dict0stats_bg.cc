@@ -330,7 +330,7 @@ static bool dict_stats_process_entry_from_recalc_pool(THD *thd)
     difftime(time(nullptr), table->stats_last_recalc) >= MIN_RECALC_INTERVAL;
 
   const dberr_t err= update_now
-    ? dict_stats_update_persistent_try(nullptr, table)
+    ? dict_stats_update_persistent_try(nullptr, table, true)
     : DB_SUCCESS_LOCKED_REC;
 
   dict_table_close(table, thd, mdl);
@@ -92,6 +92,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0ins.h"
 #include "row0log.h"
 #include "row0merge.h"
+#include "row0pread.h"
 #include "row0mysql.h"
 #include "row0quiesce.h"
 #include "row0sel.h"
@@ -887,6 +888,16 @@ static MYSQL_THDVAR_STR(tmpdir,
   "Directory for temporary non-tablespace files",
   innodb_tmpdir_validate, NULL, NULL);
 
+static MYSQL_THDVAR_UINT(ddl_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read the clustered index and sort and load"
+  " the secondary indexes that ALTER TABLE creates",
+  NULL, NULL, 1, 1, 64, 0);
+
+static MYSQL_THDVAR_UINT(parallel_read_threads, PLUGIN_VAR_RQCMDARG,
+  "Number of threads that read the clustered index for SELECT COUNT(*)"
+  " and CHECK TABLE; 1 disables the parallel read",
+  NULL, NULL, 1, 1, 256, 0);
+
 static size_t truncated_status_writes;
 
 static SHOW_VAR innodb_status_variables[]= {
@@ -978,6 +989,8 @@ static SHOW_VAR innodb_status_variables[]= {
   {"dblwr_writes", &export_vars.innodb_dblwr_writes, SHOW_SIZE_T},
   {"deadlocks", &lock_sys.deadlocks, SHOW_SIZE_T},
   {"history_list_length", &export_vars.innodb_history_list_length,SHOW_SIZE_T},
+  {"log_archive_status", &export_vars.innodb_log_archive_status,
+   SHOW_CHAR_PTR},
   {"log_waits", &log_sys.waits, SHOW_SIZE_T},
   {"log_write_requests", &log_sys.write_to_buf, SHOW_SIZE_T},
   {"log_writes", &log_sys.write_to_log, SHOW_SIZE_T},
@@ -985,6 +998,7 @@ static SHOW_VAR innodb_status_variables[]= {
   {"lsn_flushed", &export_vars.innodb_lsn_flushed, SHOW_ULONGLONG},
   {"lsn_last_checkpoint", &export_vars.innodb_lsn_last_checkpoint,
    SHOW_ULONGLONG},
+  {"lsn_archived", &export_vars.innodb_lsn_archived, SHOW_ULONGLONG},
   {"master_thread_active_loops", &srv_main_active_loops, SHOW_SIZE_T},
   {"master_thread_idle_loops", &srv_main_idle_loops, SHOW_SIZE_T},
   {"max_trx_id", &export_vars.innodb_max_trx_id, SHOW_ULONGLONG},
@@ -1003,6 +1017,8 @@ static SHOW_VAR innodb_status_variables[]= {
   {"row_lock_time_avg", &export_vars.innodb_row_lock_time_avg, SHOW_ULONGLONG},
   {"row_lock_time_max", &export_vars.innodb_row_lock_time_max, SHOW_ULONGLONG},
   {"row_lock_waits", &export_vars.innodb_row_lock_waits, SHOW_SIZE_T},
+  {"rows_prefetched", &export_vars.innodb_rows_prefetched, SHOW_SIZE_T},
+  {"scan_batches", &export_vars.innodb_scan_batches, SHOW_SIZE_T},
   {"num_open_files", &fil_system.n_open, SHOW_SIZE_T},
   {"truncated_status_writes", &truncated_status_writes, SHOW_SIZE_T},
   {"available_undo_logs", &srv_available_undo_logs, SHOW_ULONG},
@@ -1751,6 +1767,14 @@ const char *thd_innodb_tmpdir(THD *thd)
 	return(tmp_dir);
 }
 
+/** Get the value of innodb_ddl_threads.
+@param[in]	thd	thread handle
+@return number of threads for creating secondary indexes */
+uint thd_ddl_threads(THD *thd)
+{
+	return(THDVAR(thd, ddl_threads));
+}
+
 /** Obtain the InnoDB transaction of a MariaDB thread handle.
 @param thd   current_thd
 @return InnoDB transaction */
@@ -3003,6 +3027,7 @@ ha_innobase::ha_innobase(
                           | HA_CAN_ONLINE_BACKUPS
 			  | HA_CONCURRENT_OPTIMIZE
 			  | HA_CAN_SKIP_LOCKED
+			  | HA_CAN_RND_NEXT_BATCH
 		  ),
 	m_start_of_scan(),
         m_mysql_has_locked()
@@ -4971,6 +4996,11 @@ ha_innobase::table_flags() const
 	/* Need to use tx_isolation here since table flags is (also)
 	called before prebuilt is inited. */
 
+	/* COUNT(*) may be computed by records() */
+	if (THDVAR(thd, parallel_read_threads) > 1) {
+		flags |= HA_HAS_RECORDS;
+	}
+
 	if (thd_tx_isolation(thd) <= ISO_READ_COMMITTED) {
 		return(flags | HA_CHECK_UNIQUE_AFTER_WRITE);
 	}
@@ -8776,6 +8806,8 @@ ha_innobase::index_end(void)
 
 	in_range_check_pushed_down = FALSE;
 
+	m_prebuilt->fetch_batch = false;
+
 	m_ds_mrr.dsmrr_close();
 
 	DBUG_RETURN(0);
@@ -9452,6 +9484,56 @@ ha_innobase::rnd_next(
 	DBUG_RETURN(error);
 }
 
+/*****************************************************************//**
+Reads the next rows in a table scan. Rows are read ahead only when
+row_search_mvcc() can cache them; then the cache grows while the scan
+continues, and the rows are copied from it without searching the index,
+so that row_search_mvcc() is called once per cache fill, not per row.
+@return 0, HA_ERR_END_OF_FILE, or error number */
+
+int
+ha_innobase::rnd_next_batch(
+/*========================*/
+	uchar*	buf,		/*!< out: rows in MySQL format, each
+				table->s->rec_buff_length bytes apart */
+	uint	max_rows,	/*!< in: maximum number of rows to read */
+	uint*	n_rows)		/*!< out: number of rows that were read */
+{
+	const size_t	rec_length = table->s->rec_buff_length;
+	int		error = 0;
+	DBUG_ENTER("rnd_next_batch");
+
+	export_vars.innodb_scan_batches++;
+
+	/* A pushed down condition would be evaluated on
+	table->record[0] instead of buf. */
+	if (!m_prebuilt->can_prefetch()
+	    || m_prebuilt->idx_cond || m_prebuilt->pk_filter) {
+		max_rows = 1;
+	} else {
+		m_prebuilt->fetch_batch = true;
+	}
+
+	*n_rows = 0;
+
+	do {
+		if (m_start_of_scan || !m_prebuilt->n_fetch_cached) {
+			error = ha_innobase::rnd_next(
+				buf + *n_rows * rec_length);
+			if (error) {
+				break;
+			}
+			++*n_rows;
+		}
+
+		*n_rows += uint(row_sel_dequeue_cached_rows(
+					buf + *n_rows * rec_length, rec_length,
+					max_rows - *n_rows, m_prebuilt));
+	} while (*n_rows < max_rows);
+
+	DBUG_RETURN(error);
+}
+
 /**********************************************************************//**
 Fetches a row from the table based on a row reference.
 @return 0, HA_ERR_KEY_NOT_FOUND, or error code */
@@ -14446,6 +14528,57 @@ ha_innobase::estimate_rows_upper_bound()
 	DBUG_RETURN((ha_rows) estimate);
 }
 
+/** Count the rows of the table in the read view of the statement, by
+reading the clustered index with innodb_parallel_read_threads threads.
+@return number of rows
+@retval HA_POS_ERROR if the rows cannot be counted this way */
+ha_rows ha_innobase::records()
+{
+	DBUG_ENTER("ha_innobase::records");
+
+	update_thd(ha_thd());
+
+	const uint	n_threads = THDVAR(m_user_thd, parallel_read_threads);
+
+	if (n_threads <= 1) {
+		/* HA_HAS_RECORDS is not set. */
+		DBUG_RETURN(handler::records());
+	}
+
+	dict_table_t*	table = m_prebuilt->table;
+	dict_index_t*	index = dict_table_get_first_index(table);
+	trx_t*		trx = m_prebuilt->trx;
+
+	/* Locking reads must visit the records one by one, and there
+	is no MVCC for temporary or NO_ROLLBACK tables. */
+	if (m_prebuilt->select_lock_type != LOCK_NONE
+	    || table->is_temporary() || table->no_rollback()
+	    || !table->space || !table->is_readable()
+	    || index->is_corrupted()
+	    || !row_merge_is_index_usable(trx, index)) {
+		DBUG_RETURN(HA_POS_ERROR);
+	}
+
+	trx_start_if_not_started(trx, false);
+
+	const bool	consistent
+		= trx->isolation_level > TRX_ISO_READ_UNCOMMITTED;
+
+	if (consistent) {
+		trx->read_view.open(trx);
+	}
+
+	trx->op_info = "counting rows";
+
+	ulint	n_rows;
+	dberr_t	err = row_pread_count(trx, index, consistent, n_threads,
+				      &n_rows);
+
+	trx->op_info = "";
+
+	DBUG_RETURN(err == DB_SUCCESS ? ha_rows(n_rows) : HA_POS_ERROR);
+}
+
 
 /*********************************************************************//**
 How many seeks it will take to read through the table. This is to be
@@ -15302,6 +15435,8 @@ ha_innobase::check(
 	bool		is_ok		= true;
 	dberr_t		ret;
         uint handler_flags= check_opt->handler_flags;
+	const uint	parallel_read_threads
+		= THDVAR(thd, parallel_read_threads);
 
 	DBUG_ENTER("ha_innobase::check");
 	DBUG_ASSERT(thd == ha_thd());
@@ -15467,6 +15602,14 @@ ha_innobase::check(
 			ret = row_count_rtree_recs(m_prebuilt, &n_rows);
 		} else if (index->type & DICT_FTS) {
 			ret = DB_SUCCESS;
+		} else if (index->is_primary() && parallel_read_threads > 1
+			   && !(check_opt->flags & T_EXTEND)
+			   && !m_prebuilt->table->is_temporary()) {
+			/* CHECK TABLE...EXTENDED looks for unpurged
+			records, and that is only done by
+			row_check_index(). */
+			ret = row_check_index_parallel(
+				m_prebuilt, parallel_read_threads, &n_rows);
 		} else {
 			ret = row_check_index(m_prebuilt, &n_rows);
 		}
@@ -19144,6 +19287,13 @@ static MYSQL_SYSVAR_ULONG(purge_batch_size, srv_purge_batch_size,
   1,			/* Minimum value */
   innodb_purge_batch_size_MAX, 0);
 
+static MYSQL_SYSVAR_BOOL(purge_batch_size_adaptive,
+  srv_purge_batch_size_adaptive,
+  PLUGIN_VAR_OPCMDARG,
+  "Increase the purge batch size up to 5000 pages when the history list"
+  " is long",
+  NULL, NULL, FALSE);
+
 extern void srv_update_purge_thread_count(uint n);
 
 static
@@ -19208,6 +19358,25 @@ static MYSQL_SYSVAR_STR(log_group_home_dir, srv_log_group_home_dir,
   PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
   "Path to ib_logfile0", NULL, NULL, NULL);
 
+static MYSQL_SYSVAR_STR(log_archive_dir, srv_log_archive_dir,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "Directory where to copy the redo log before it is overwritten;"
+  " empty for no archiving", NULL, NULL, NULL);
+
+static MYSQL_SYSVAR_ULONGLONG(log_archive_recovery_lsn,
+  srv_log_archive_recovery_lsn,
+  PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+  "On startup of a restored backup, replay the redo log from"
+  " innodb_log_archive_dir up to this LSN (0=disable)",
+  nullptr, nullptr, 0, 0, std::numeric_limits<ulonglong>::max(), 0);
+
+static MYSQL_SYSVAR_UINT(log_archive_retry_limit, srv_log_archive_retry_limit,
+  PLUGIN_VAR_RQCMDARG,
+  "How many times to retry archiving the log after an error, once per"
+  " second, while holding back log checkpoints, before archiving is"
+  " stopped (0=stop on the first error)",
+  nullptr, nullptr, 60, 0, UINT_MAX, 0);
+
 static MYSQL_SYSVAR_DOUBLE(max_dirty_pages_pct, srv_max_buf_pool_modified_pct,
   PLUGIN_VAR_RQCMDARG,
   "Percentage of dirty pages allowed in bufferpool",
@@ -19304,6 +19473,13 @@ static MYSQL_SYSVAR_UINT(stats_persistent_sample_pages,
   " statistics (by ANALYZE, default 20)",
   NULL, NULL, 20, 1, ~0U, 0);
 
+static MYSQL_SYSVAR_UINT(stats_persistent_threads,
+  srv_stats_persistent_threads,
+  PLUGIN_VAR_RQCMDARG,
+  "The number of indexes of a table that are analyzed concurrently when"
+  " calculating persistent statistics",
+  NULL, NULL, 1, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONGLONG(stats_modified_counter, srv_stats_modified_counter,
   PLUGIN_VAR_RQCMDARG,
   "The number of rows modified before we calculate new statistics (default 0 = current limits)",
@@ -19367,6 +19543,12 @@ static MYSQL_SYSVAR_ULONG(buffer_pool_dump_pct, srv_buf_pool_dump_pct,
   "Dump only the hottest N% of each buffer pool, defaults to 25",
   NULL, NULL, 25, 1, 100, 0);
 
+static MYSQL_SYSVAR_ULONG(buffer_pool_dump_interval, srv_buf_dump_interval,
+  PLUGIN_VAR_RQCMDARG,
+  "Dump the buffer pool every N seconds if pages were read into it"
+  " since the previous dump; 0 (the default) disables periodic dumps",
+  NULL, NULL, 0, 0, 86400, 0);
+
 #ifdef UNIV_DEBUG
 /* Added to test the innodb_buffer_pool_load_incomplete status variable. */
 static MYSQL_SYSVAR_ULONG(buffer_pool_load_pages_abort, srv_buf_pool_load_pages_abort,
@@ -19409,6 +19591,12 @@ static MYSQL_SYSVAR_ULONG(flush_neighbors, buf_pool.flush_neighbors,
   " when flushing a block",
   NULL, innodb_buf_pool_update<ulong>, 1, 0, 2, 0);
 
+static MYSQL_SYSVAR_ULONG(page_cleaner_tasks, buf_pool.flush_tasks,
+  PLUGIN_VAR_RQCMDARG,
+  "Maximum number of concurrent tasks that write pages"
+  " in a page cleaner flush_list batch",
+  NULL, innodb_buf_pool_update<ulong>, 1, 1, buf_pool_t::FLUSH_TASKS_MAX, 0);
+
 static MYSQL_SYSVAR_BOOL(deadlock_detect, innodb_deadlock_detect,
   PLUGIN_VAR_NOCMDARG,
   "Enable/disable InnoDB deadlock detector (default ON)."
@@ -19759,6 +19947,13 @@ static MYSQL_SYSVAR_ULONG(read_ahead_threshold, srv_read_ahead_threshold,
   " trigger a readahead",
   NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(read_ahead_logical, srv_read_ahead_logical,
+  PLUGIN_VAR_RQCMDARG,
+  "Number of leaf pages to read ahead in the key order when an index scan"
+  " moves to the next page, based on the node pointers in the parent page;"
+  " 0 (the default) uses the linear read-ahead within an extent",
+  NULL, NULL, 0, 0, 256, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
   PLUGIN_VAR_RQCMDARG,
   "Turn on a monitor counter",
@@ -19981,6 +20176,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(buffer_pool_dump_now),
   MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
   MYSQL_SYSVAR(buffer_pool_dump_pct),
+  MYSQL_SYSVAR(buffer_pool_dump_interval),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
@@ -19993,6 +20189,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(lru_scan_depth),
   MYSQL_SYSVAR(lru_flush_size),
   MYSQL_SYSVAR(flush_neighbors),
+  MYSQL_SYSVAR(page_cleaner_tasks),
   MYSQL_SYSVAR(checksum_algorithm),
   MYSQL_SYSVAR(compression_level),
   MYSQL_SYSVAR(data_file_path),
@@ -20034,6 +20231,9 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(log_write_ahead_size),
   MYSQL_SYSVAR(log_spin_wait_delay),
   MYSQL_SYSVAR(log_group_home_dir),
+  MYSQL_SYSVAR(log_archive_dir),
+  MYSQL_SYSVAR(log_archive_recovery_lsn),
+  MYSQL_SYSVAR(log_archive_retry_limit),
   MYSQL_SYSVAR(max_dirty_pages_pct),
   MYSQL_SYSVAR(max_dirty_pages_pct_lwm),
   MYSQL_SYSVAR(adaptive_flushing_lwm),
@@ -20058,6 +20258,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(stats_transient_sample_pages),
   MYSQL_SYSVAR(stats_persistent),
   MYSQL_SYSVAR(stats_persistent_sample_pages),
+  MYSQL_SYSVAR(stats_persistent_threads),
   MYSQL_SYSVAR(stats_auto_recalc),
   MYSQL_SYSVAR(stats_modified_counter),
   MYSQL_SYSVAR(stats_traditional),
@@ -20076,6 +20277,8 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(table_locks),
   MYSQL_SYSVAR(prefix_index_cluster_optimization),
   MYSQL_SYSVAR(tmpdir),
+  MYSQL_SYSVAR(ddl_threads),
+  MYSQL_SYSVAR(parallel_read_threads),
   MYSQL_SYSVAR(autoinc_lock_mode),
   MYSQL_SYSVAR(use_native_aio),
 #ifdef __linux__
@@ -20086,6 +20289,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
 #endif /* HAVE_LIBNUMA */
   MYSQL_SYSVAR(random_read_ahead),
   MYSQL_SYSVAR(read_ahead_threshold),
+  MYSQL_SYSVAR(read_ahead_logical),
   MYSQL_SYSVAR(read_only),
   MYSQL_SYSVAR(read_only_compressed),
   MYSQL_SYSVAR(instant_alter_column_allowed),
@@ -20097,6 +20301,7 @@ static struct st_mysql_sys_var* innobase_system_variables[]= {
   MYSQL_SYSVAR(monitor_reset_all),
   MYSQL_SYSVAR(purge_threads),
   MYSQL_SYSVAR(purge_batch_size),
+  MYSQL_SYSVAR(purge_batch_size_adaptive),
   MYSQL_SYSVAR(log_checkpoint_now),
 #ifdef UNIV_DEBUG
   MYSQL_SYSVAR(buf_flush_list_now),
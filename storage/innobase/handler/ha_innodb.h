@@ -152,6 +152,8 @@ class ha_innobase final : public handler
 
 	int rnd_next(uchar *buf) override;
 
+	int rnd_next_batch(uchar *buf, uint max_rows, uint *n_rows) override;
+
 	int rnd_pos(uchar * buf, uchar *pos) override;
 
 	int ft_init() override;
@@ -185,6 +187,8 @@ class ha_innobase final : public handler
 
 	ha_rows estimate_rows_upper_bound() override;
 
+	ha_rows records() override;
+
 	void update_create_info(HA_CREATE_INFO* create_info) override;
 
 	int create(
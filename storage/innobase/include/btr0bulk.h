@@ -51,17 +51,21 @@ class PageBulk
 public:
 	/** Constructor
 	@param[in]	index		B-tree index
-	@param[in,out]	trx		trnsaction
+	@param[in]	trx_id		transaction identifier
+	@param[in,out]	trx		transaction for the statistics,
+					or nullptr
 	@param[in]	page_no		page number
 	@param[in]	level		page level */
 	PageBulk(
 		dict_index_t*	index,
+		trx_id_t	trx_id,
 		trx_t*		trx,
 		uint32_t	page_no,
 		ulint		level)
 		:
 		m_heap(NULL),
 		m_index(index),
+		m_trx_id(trx_id),
 		m_mtr(trx),
 		m_block(NULL),
 		m_page(NULL),
@@ -218,6 +222,9 @@ class PageBulk
 	/** The index B-tree */
 	dict_index_t*	m_index;
 
+	/** The transaction identifier for PAGE_MAX_TRX_ID */
+	const trx_id_t	m_trx_id;
+
 	/** The mini-transaction */
 	mtr_t		m_mtr;
 
@@ -278,12 +285,16 @@ class BtrBulk
 public:
 	/** Constructor
 	@param[in]	index		B-tree index
-	@param[in]	trx		transaction */
+	@param[in]	trx		transaction
+	@param[in]	stats		whether to update the handler statistics
+					of trx; false when loading in a task
+					that runs in parallel with others */
 	BtrBulk(
-		dict_index_t*	index, trx_t*	trx)
+		dict_index_t*	index, trx_t*	trx, bool stats = true)
 		:
 		m_index(index),
-		m_trx(trx)
+		m_trx(trx),
+		m_mtr_trx(stats ? trx : nullptr)
 	{
 		ut_ad(!dict_index_is_spatial(index));
 	}
@@ -356,6 +367,9 @@ class BtrBulk
 	/** Transaction */
 	trx_t*const		m_trx;
 
+	/** Transaction of the mini-transactions, or nullptr */
+	trx_t*const		m_mtr_trx;
+
 	/** Root page level */
 	ulint			m_root_level;
 
@@ -711,6 +711,13 @@ struct btr_cur_t {
 #endif
 	/* @} */
 	rtr_info_t*	rtr_info;	/*!< rtree search info */
+	/** page number of the parent of the leaf page, as determined by
+	search_leaf() or open_leaf(), or 0 if not known; used by the
+	logical read-ahead of btr_pcur_move_to_next_page() */
+	uint32_t	parent_page_no;
+	/** number of leaf pages for which the logical read-ahead
+	was submitted ahead of the cursor */
+	uint32_t	ra_window;
   btr_cur_t() { memset((void*) this, 0, sizeof *this); }
 
   dict_index_t *index() const { return page_cur.index; }
@@ -1471,6 +1471,9 @@ class buf_pool_t
   /** innodb_flush_neighbors; whether or not to flush neighbors of a block;
   protected by buf_pool_t::mutex */
   ulong flush_neighbors;
+  /** innodb_page_cleaner_tasks; maximum number of concurrent tasks
+  in a flush_list batch; protected by buf_pool_t::mutex */
+  ulong flush_tasks;
 
   /** Hash table of file pages (buf_page_t::in_file() holds),
   indexed by page_id_t. Protected by both mutex and page_hash.lock_get(). */
@@ -1499,6 +1502,24 @@ class buf_pool_t
   alignas(CPU_LEVEL1_DCACHE_LINESIZE) mysql_mutex_t flush_list_mutex;
   /** "hazard pointer" for flush_list scans; protected by flush_list_mutex */
   FlushHp flush_hp;
+  /** maximum value of innodb_page_cleaner_tasks */
+  static constexpr unsigned FLUSH_TASKS_MAX= 16;
+  /** "hazard pointers" of the additional page cleaner tasks of
+  buf_do_flush_list_batch(); protected by flush_list_mutex */
+  FlushHp flush_task_hp[FLUSH_TASKS_MAX - 1];
+  /** number of flush_task_hp[] that are in use by running tasks;
+  protected by flush_list_mutex */
+  ulint n_flush_task_hp;
+
+  /** Adjust the flush_list hazard pointers when a block is being removed
+  from or inserted after bpage.
+  @param bpage  buffer block */
+  void flush_hp_adjust(const buf_page_t *bpage) noexcept
+  {
+    flush_hp.adjust(bpage);
+    for (ulint i= n_flush_task_hp; i--; )
+      flush_task_hp[i].adjust(bpage);
+  }
   /** flush_list size in bytes; protected by flush_list_mutex */
   ulint flush_list_bytes;
   /** possibly modified persistent pages (a subset of LRU);
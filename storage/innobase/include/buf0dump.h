@@ -38,6 +38,11 @@ void buf_load_abort();
 /** Start async buffer pool load, if srv_buffer_pool_load_at_startup was set.*/
 void buf_load_at_startup();
 
+/** Start a buffer pool dump every innodb_buffer_pool_dump_interval
+seconds, if any pages were read into or created in the buffer pool
+since the previous periodic dump. */
+void buf_dump_periodic();
+
 /** Wait for currently running load/dumps to finish*/
 void buf_load_dump_end();
 
@@ -1139,7 +1139,27 @@ struct dict_index_t {
 	uint32_t	stat_n_leaf_pages;
 				/*!< approximate number of leaf pages in the
 				index tree */
+	ib_uint64_t	stat_modified_counter;
+				/*!< approximate number of records of
+				a secondary index that were inserted,
+				updated or deleted since the statistics
+				were last calculated; see
+				dict_stats_update_persistent() */
 	/* @} */
+
+  /** Initial value of stat_modified_counter. The counter is not
+  persisted, so we must assume that an index that was loaded to
+  the cache had been modified since its statistics were calculated. */
+  static constexpr ib_uint64_t STAT_MODIFIED_UNKNOWN= ~0ULL >> 1;
+
+  /** Note that an insert, update or delete of a secondary index
+  record was rolled back. */
+  void stat_modified_rollback() noexcept
+  {
+    /* We do not care about the race condition here. */
+    if (stat_modified_counter)
+      stat_modified_counter--;
+  }
 private:
   /** R-tree split sequence number */
   Atomic_relaxed<node_seq_t> rtr_ssn;
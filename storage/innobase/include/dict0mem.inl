@@ -57,6 +57,7 @@ dict_mem_fill_index_struct(
 	index->type = type & ((1U << DICT_IT_BITS) - 1);
 	index->page = FIL_NULL;
 	index->merge_threshold = DICT_INDEX_MERGE_THRESHOLD_DEFAULT;
+	index->stat_modified_counter = index->STAT_MODIFIED_UNKNOWN;
 	index->n_fields = static_cast<unsigned>(n_fields)
 		& index->MAX_N_FIELDS;
 	index->n_core_fields = static_cast<unsigned>(n_fields)
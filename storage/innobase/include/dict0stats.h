@@ -104,18 +104,25 @@ dberr_t dict_stats_update_transient(trx_t *trx, dict_table_t *table) noexcept;
 /**
 Calculate new estimates for table and index statistics. This function
 is slower than dict_stats_update_transient().
-@param trx      transaction
-@param table    table for which the persistent statistics are being updated
+@param trx          transaction
+@param table        table for which the persistent statistics are being updated
+@param incremental  whether to keep the statistics of secondary indexes
+                    that were not modified much since they were calculated
 @return DB_SUCCESS or error code
 @retval DB_SUCCESS_LOCKED_REC if the table under bulk insert operation */
-dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table) noexcept;
+dberr_t dict_stats_update_persistent(trx_t *trx, dict_table_t *table,
+                                     bool incremental= false) noexcept;
 
 /**
 Try to calculate and save new estimates for persistent statistics.
 If persistent statistics are not enabled for the table or not available,
-this does nothing. */
-dberr_t dict_stats_update_persistent_try(trx_t *trx, dict_table_t *table)
-  noexcept;
+this does nothing.
+@param trx          transaction
+@param table        table for which the persistent statistics are being updated
+@param incremental  whether to keep the statistics of secondary indexes
+                    that were not modified much since they were calculated */
+dberr_t dict_stats_update_persistent_try(trx_t *trx, dict_table_t *table,
+                                         bool incremental= false) noexcept;
 
 /** Rename a table in InnoDB persistent stats storage.
 @param old_name  old table name
@@ -0,0 +1,92 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/log0arch.h
+Archiving of the redo log
+
+When innodb_log_archive_dir is set, the circular ib_logfile0 is copied to
+a sequence of files in that directory before it is overwritten. Each file
+covers a contiguous range of LSN, starting where the previous file ended.
+A checkpoint will not discard any log that has not been durably archived.
+After an I/O error, archiving is retried every second, up to
+innodb_log_archive_retry_limit times, before it is stopped.
+
+An archive file consists of a log file header that is like the first
+block of ib_logfile0, with LOG_HEADER_START_LSN pointing to the start of
+the archived range. At log_t::CHECKPOINT_1 and log_t::CHECKPOINT_2 there
+are alternating blocks that record the end of the durably archived range
+(8 bytes) and a CRC-32C of the first 60 bytes. The log follows at
+log_t::START_OFFSET, with the original sequence bits.
+*******************************************************/
+
+#pragma once
+
+#include "log0log.h"
+
+/** Prefix of archive file names; the suffix is the start LSN */
+static const char LOG_ARCHIVE_PREFIX[]= "ib_archive_";
+/** Name of the original ib_logfile0 while the log archive is recovered */
+static const char LOG_ARCHIVE_ORIGINAL[]= "ib_logfile0.orig";
+
+/** Start archiving the log, if innodb_log_archive_dir is set.
+@param lsn    the latest checkpoint, or the start of a new ib_logfile0
+@param fresh  whether ib_logfile0 is being created at lsn
+@return DB_SUCCESS or error code */
+dberr_t log_archive_init(lsn_t lsn, bool fresh) noexcept;
+
+/** Start archiving in srv_thread_pool after log_archive_init(). */
+void log_archive_start() noexcept;
+
+/** Submit an archiving task, because a checkpoint is being
+held back by log_sys.archived_lsn. */
+void log_archive_wake() noexcept;
+
+/** Archive all durably written log before ib_logfile0 is replaced,
+before log_archive_start(). */
+void log_archive_sync() noexcept;
+
+/** Archive all durably written log and stop archiving. */
+void log_archive_close() noexcept;
+
+/** @return the state of log archiving: OFF, ON, RETRYING after an error
+while log checkpoints are being held back, or STOPPED after errors */
+const char *log_archive_status() noexcept;
+
+/** @return the end of the durably archived log, also after archiving
+was stopped because of errors; 0 if the log was not archived */
+lsn_t log_archive_lsn() noexcept;
+
+/** On startup, create ib_logfile101 from the archived log, from the
+latest checkpoint of ib_logfile0 up to innodb_log_archive_recovery_lsn.
+@return DB_SUCCESS or error code */
+dberr_t log_archive_restore() noexcept;
+
+/** Replace ib_logfile0 with the ib_logfile101 that log_archive_restore()
+created. The original ib_logfile0 is kept as LOG_ARCHIVE_ORIGINAL
+until log_archive_restored().
+@return DB_SUCCESS or error code */
+dberr_t log_archive_replace() noexcept;
+
+/** Put back the original ib_logfile0 after log_archive_replace(),
+because the log archive could not be recovered. */
+void log_archive_replace_rollback() noexcept;
+
+/** Delete the original ib_logfile0 after the log archive was recovered
+and the log was rebuilt. */
+void log_archive_restored() noexcept;
@@ -247,6 +247,10 @@ struct log_t
   lsn_t (*writer)() noexcept;
   /** next checkpoint LSN (protected by latch.wr_lock()) */
   lsn_t next_checkpoint_lsn;
+  /** end of the log that has been durably copied to innodb_log_archive_dir,
+  or 0 if the log is not being archived; checkpoints will not advance
+  beyond this (see log0arch.cc) */
+  Atomic_relaxed<lsn_t> archived_lsn;
 
   /** Log file */
   log_file_t log;
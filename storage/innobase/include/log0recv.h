@@ -54,6 +54,16 @@ of first system tablespace page
 @return error code or DB_SUCCESS */
 dberr_t recv_recovery_from_checkpoint_start();
 
+/** Determine the length of a log_t::FORMAT_10_8 mini-transaction,
+without checking its sequence bit.
+@param begin      start of the mini-transaction
+@param end        end of the buffer
+@param encrypted  whether the log is encrypted
+@return length of the mini-transaction, including the checksum
+@retval 0 if the mini-transaction is incomplete or corrupted */
+size_t log_mtr_length(const byte *begin, const byte *end, bool encrypted)
+  noexcept;
+
 /** Report an operation to create, delete, or rename a file during backup.
 @param[in]	space_id	tablespace identifier
 @param[in]	type		file operation redo log type
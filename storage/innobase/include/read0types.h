@@ -31,6 +31,38 @@ Created 2/16/1997 Heikki Tuuri
 #include "srw_lock.h"
 #include <algorithm>
 
+/**
+  Identifiers of the read-write transactions that were active when a
+  snapshot was taken, shared by all read views that are created while
+  trx_sys.rw_trx_hash remains unchanged.
+
+  The object is immutable while ref_count is nonzero. It is published in
+  trx_sys_t::m_snapshot and reused by trx_sys_t::create_snapshot() after
+  the last reference was released; it is freed by trx_sys_t::close().
+
+  @sa trx_sys_t::snapshot_ids()
+*/
+struct ReadViewSnapshot
+{
+  /** 1 while published in trx_sys_t::m_snapshot, plus 1 for each read view
+  that refers to this; 0 if the object is free */
+  std::atomic<uint32_t> ref_count;
+  /** trx_sys.get_max_trx_id() at the time of the snapshot */
+  trx_id_t max_trx_id;
+  /** trx_sys_t::m_rw_trx_hash_epoch at the time of the snapshot */
+  uint64_t epoch;
+  /** the smallest transaction serialisation number */
+  trx_id_t min_trx_no;
+  /** identifiers of active transactions, in ascending order */
+  trx_ids_t ids;
+  /** next element in trx_sys_t::m_snapshots */
+  ReadViewSnapshot *next;
+
+  /** Release a reference */
+  void release() { ref_count.fetch_sub(1, std::memory_order_release); }
+};
+
+
 /**
   Read view lists the trx ids of those transactions for which a consistent read
   should not see the modifications to the database.
@@ -50,7 +82,13 @@ class ReadViewBase
   */
   trx_id_t m_up_limit_id;
 
-  /** Set of RW transactions that was active when this snapshot was taken */
+  /** Set of RW transactions that was active when this snapshot was taken,
+  if it is shared with other read views; otherwise nullptr, and m_ids
+  is the set */
+  ReadViewSnapshot *m_snapshot= nullptr;
+
+  /** Set of RW transactions that was active when this snapshot was taken,
+  if m_snapshot is nullptr */
   trx_ids_t m_ids;
 
   /**
@@ -60,13 +98,45 @@ class ReadViewBase
   */
   trx_id_t m_low_limit_no;
 
+  /** @return the set of RW transactions that was active */
+  const trx_ids_t &ids() const { return m_snapshot ? m_snapshot->ids : m_ids; }
+
 protected:
-  bool empty() { return m_ids.empty(); }
+  bool empty() { return ids().empty(); }
 
   /** @return the up limit id */
   trx_id_t up_limit_id() const { return m_up_limit_id; }
 
 public:
+  ReadViewBase()= default;
+  ReadViewBase(const ReadViewBase &)= delete;
+
+  /** Copy another view, without sharing its m_snapshot */
+  ReadViewBase &operator=(const ReadViewBase &other)
+  {
+    if (&other != this)
+    {
+      m_low_limit_id= other.m_low_limit_id;
+      m_up_limit_id= other.m_up_limit_id;
+      m_low_limit_no= other.m_low_limit_no;
+      const trx_ids_t &ids= other.ids();
+      m_ids.assign(ids.begin(), ids.end());
+      release_snapshot();
+    }
+    return *this;
+  }
+
+  /** Release the reference to a shared snapshot.
+  The caller must ensure that no other thread is accessing ids(). */
+  void release_snapshot()
+  {
+    if (m_snapshot)
+    {
+      m_snapshot->release();
+      m_snapshot= nullptr;
+    }
+  }
+
   /**
     Append state from another view.
 
@@ -84,8 +154,15 @@ class ReadViewBase
     if (m_low_limit_id > other.m_low_limit_id)
       m_low_limit_id= other.m_low_limit_id;
 
+    if (m_snapshot)
+    {
+      /* Copy on write */
+      m_ids.assign(m_snapshot->ids.begin(), m_snapshot->ids.end());
+      release_snapshot();
+    }
+
     trx_ids_t::iterator dst= m_ids.begin();
-    for (const trx_id_t id : other.m_ids)
+    for (const trx_id_t id : other.ids())
     {
       if (id >= m_low_limit_id)
         break;
@@ -131,9 +208,10 @@ class ReadViewBase
   {
     if (id >= m_low_limit_id)
       return false;
-    return id < m_up_limit_id ||
-           m_ids.empty() ||
-           !std::binary_search(m_ids.begin(), m_ids.end(), id);
+    if (id < m_up_limit_id)
+      return true;
+    const trx_ids_t &ids= this->ids();
+    return ids.empty() || !std::binary_search(ids.begin(), ids.end(), id);
   }
 
   /**
@@ -452,6 +452,10 @@ struct mysql_row_templ_t {
 #define MYSQL_FETCH_CACHE_SIZE		8
 /* After fetching this many rows, we start caching them in fetch_cache */
 #define MYSQL_FETCH_CACHE_THRESHOLD	4
+/* The fetch cache of ha_innobase::rnd_next_batch() grows up to this many
+rows, or up to MYSQL_FETCH_CACHE_MAX_BYTES */
+#define MYSQL_FETCH_CACHE_MAX_SIZE	256
+#define MYSQL_FETCH_CACHE_MAX_BYTES	(128 << 10)
 
 #define ROW_PREBUILT_ALLOCATED	78540783
 #define ROW_PREBUILT_FREED	26423527
@@ -625,7 +629,7 @@ struct row_prebuilt_t {
 	ulint		n_rows_fetched;	/*!< number of rows fetched after
 					positioning the current cursor */
 	ulint		fetch_direction;/*!< ROW_SEL_NEXT or ROW_SEL_PREV */
-	byte*		fetch_cache[MYSQL_FETCH_CACHE_SIZE];
+	byte*		fetch_cache[MYSQL_FETCH_CACHE_MAX_SIZE];
 					/*!< a cache for fetched rows if we
 					fetch many rows from the same cursor:
 					it saves CPU time to fetch them in a
@@ -643,6 +647,15 @@ struct row_prebuilt_t {
 					fetched row in fetch_cache */
 	ulint		n_fetch_cached;	/*!< number of not yet fetched rows
 					in fetch_cache */
+	ulint		fetch_cache_size;/*!< number of allocated rows
+					in fetch_cache */
+	ulint		fetch_cache_limit;/*!< number of rows to fetch
+					into fetch_cache at a time; grows
+					from MYSQL_FETCH_CACHE_SIZE
+					when fetch_batch is set */
+	bool		fetch_batch;	/*!< whether ha_innobase::rnd_next_batch()
+					is reading rows, so that fetch_cache
+					is to be filled from the first row */
 	mem_heap_t*	blob_heap;	/*!< in SELECTS BLOB fields are copied
 					to this heap */
 	mem_heap_t*	old_vers_heap;	/*!< memory heap where a previous
@@ -695,6 +708,17 @@ struct row_prebuilt_t {
 	/** The MySQL table object */
 	TABLE*		m_mysql_table;
 
+	/** @return whether row_search_mvcc() may fetch rows into
+	fetch_cache ahead of time */
+	bool can_prefetch() const
+	{
+		return select_lock_type == LOCK_NONE
+			&& !templ_contains_blob
+			&& !clust_index_was_generated
+			&& !used_in_HANDLER
+			&& !in_fts_query;
+	}
+
 	/** Get template by dict_table_t::cols[] number */
 	const mysql_row_templ_t* get_template_by_col(ulint col) const
 	{
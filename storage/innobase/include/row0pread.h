@@ -0,0 +1,158 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file include/row0pread.h
+Reading a clustered index with several threads
+*******************************************************/
+
+#pragma once
+
+#include "trx0trx.h"
+#include "srw_lock.h"
+#include "ut0new.h"
+#include <tpool.h>
+#include <vector>
+
+/** Reader of a clustered index by several threads.
+
+The index is divided into key ranges that are bounded by node pointer
+records on the root page, or on the level below it if the root page has
+few node pointers. Each thread takes key ranges until none are left.
+Within a key range, the records are passed to the worker of the thread
+in ascending order, but the key ranges are read in any order.
+
+All threads read the records in the read view of the transaction, or the
+latest version of the records if there is no read view. Delete-marked
+records are skipped. */
+class row_pread_t
+{
+public:
+  /** A thread of the reader */
+  class worker
+  {
+  public:
+    virtual ~worker()= default;
+
+    /** Process a record.
+    @param rec      clustered index record, not delete-marked
+    @param offsets  rec_get_offsets(rec)
+    @return DB_SUCCESS or error code */
+    virtual dberr_t process(const rec_t *rec, rec_offs *offsets)= 0;
+
+    /** Note that a leaf page has been read to the end. */
+    virtual void page_done() {}
+
+    /** Note that a key range has been read to the end. */
+    virtual void range_done() {}
+
+    /** Invoked when no key ranges are left, unless a thread failed.
+    @return DB_SUCCESS or error code */
+    virtual dberr_t finish() { return DB_SUCCESS; }
+
+    /** @return whether this is the thread that invoked run() */
+    bool is_caller() const { return !task; }
+
+  private:
+    friend class row_pread_t;
+    /** the reader */
+    row_pread_t *reader= nullptr;
+    /** the task of the thread, or nullptr in the thread that invoked run() */
+    tpool::waitable_task *task= nullptr;
+  };
+
+  /** Constructor.
+  @param trx         transaction
+  @param index       clustered index
+  @param consistent  whether to read in trx->read_view, which must be open */
+  row_pread_t(trx_t *trx, dict_index_t *index, bool consistent);
+  ~row_pread_t();
+
+  /** Divide the index into key ranges.
+  @param n_threads  number of threads that will read the index
+  @param empty      set to whether the index is empty in the read view
+  @return DB_SUCCESS or error code */
+  dberr_t split(ulint n_threads, bool *empty);
+
+  /** @return the number of key ranges after split() */
+  ulint n_ranges() const { return bounds.size() + 1; }
+
+  /** Read the key ranges. workers[0] runs in the calling thread, and
+  the others run in srv_thread_pool.
+  @param workers    the threads; at most n_ranges()
+  @param n_workers  number of threads
+  @return the first error that was reported, or DB_SUCCESS */
+  dberr_t run(worker *const *workers, ulint n_workers);
+
+  /** Note that a thread failed, and make all threads stop.
+  @param error  error code
+  @return whether this was the first error */
+  bool report(dberr_t error);
+
+  /** @return whether a thread failed */
+  bool is_aborted() const { return aborted.load(std::memory_order_relaxed); }
+
+  /** the transaction */
+  trx_t *const trx;
+  /** the clustered index */
+  dict_index_t *const index;
+
+private:
+  /** Add bounds from the node pointer records of a page.
+  @param block  non-leaf page
+  @param step   take every step-th node pointer */
+  void add_bounds(const buf_block_t *block, ulint step);
+
+  /** Read a key range.
+  @param w      the thread
+  @param range  key range
+  @return DB_SUCCESS or error code */
+  dberr_t read_range(worker *w, ulint range);
+
+  /** Read key ranges until none are left.
+  @param w      the thread */
+  void work(worker *w);
+
+  /** tpool callback for work() */
+  static void task_func(void *w);
+
+  /** the read view, or nullptr */
+  ReadView *const view;
+  /** memory heap for bounds */
+  mem_heap_t *const heap;
+  /** lower bounds of the key ranges, except the first one */
+  std::vector<const dtuple_t*, ut_allocator<const dtuple_t*>> bounds;
+  /** next key range to read */
+  std::atomic<ulint> next_range;
+  /** whether a thread failed and the others should stop */
+  std::atomic<bool> aborted;
+  /** protects err */
+  srw_mutex mutex;
+  /** the first error */
+  dberr_t err;
+};
+
+/** Count the records of a clustered index with several threads.
+@param trx         transaction
+@param index       clustered index
+@param consistent  whether to count in trx->read_view, which must be open
+@param n_threads   number of threads
+@param n_rows      number of records
+@return DB_SUCCESS or error code */
+dberr_t row_pread_count(trx_t *trx, dict_index_t *index, bool consistent,
+                        ulint n_threads, ulint *n_rows);
@@ -147,6 +147,20 @@ row_search_mvcc(
 	ulint		direction)
 	MY_ATTRIBUTE((warn_unused_result));
 
+/** Copy rows that row_search_mvcc() has read ahead into the fetch cache,
+without searching the index again.
+@param[out]	buf		buffer for the rows in MySQL format
+@param[in]	stride		distance of the rows in buf, in bytes
+@param[in]	max_rows	maximum number of rows to copy
+@param[in,out]	prebuilt	prebuilt struct for the table handler
+@return number of rows that were copied */
+ulint
+row_sel_dequeue_cached_rows(
+	byte*		buf,
+	ulint		stride,
+	ulint		max_rows,
+	row_prebuilt_t*	prebuilt);
+
 /********************************************************************//**
 Count rows in a R-Tree leaf level.
 @return DB_SUCCESS if successful */
@@ -178,6 +192,22 @@ current read view.
 dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
   MY_ATTRIBUTE((nonnull, warn_unused_result));
 
+/**
+Check the clustered index records in CHECK TABLE with several threads,
+like row_check_index() does when CHECK TABLE is not EXTENDED.
+The threads read key ranges of the index by row_pread_t, and the
+order of the records is only checked within each key range.
+
+@param prebuilt    clustered index and transaction
+@param n_threads   number of threads
+@param n_rows      number of records counted
+
+@return error code
+@retval DB_SUCCESS  if no error was found */
+dberr_t row_check_index_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                                 ulint *n_rows)
+  MY_ATTRIBUTE((nonnull, warn_unused_result));
+
 /** Read the max AUTOINC value from an index.
 @param[in] index	index starting with an AUTO_INCREMENT column
 @return	the largest AUTO_INCREMENT value
@@ -134,6 +134,9 @@ extern char*		srv_buf_dump_filename;
 and/or load it during startup. */
 extern char		srv_buffer_pool_dump_at_shutdown;
 extern char		srv_buffer_pool_load_at_startup;
+/** innodb_buffer_pool_dump_interval: seconds between periodic
+buffer pool dumps, or 0 to disable periodic dumps */
+extern ulong		srv_buf_dump_interval;
 
 /* Whether to disable file system cache if it is defined */
 extern char		srv_disable_sort_file_cache;
@@ -220,6 +223,15 @@ constexpr uint32_t SRV_UNDO_TABLESPACE_SIZE_IN_PAGES= (10U << 20) /
   UNIV_PAGE_SIZE_DEF;
 
 extern char*	srv_log_group_home_dir;
+/** innodb_log_archive_dir: where to copy the redo log before it is
+overwritten, or NULL if the log is not being archived */
+extern char*	srv_log_archive_dir;
+/** innodb_log_archive_recovery_lsn: replay the log from
+innodb_log_archive_dir up to this LSN on startup, or 0 */
+extern ulonglong	srv_log_archive_recovery_lsn;
+/** innodb_log_archive_retry_limit: how many times to retry archiving
+the log after an error, once per second, before archiving is stopped */
+extern uint	srv_log_archive_retry_limit;
 
 /** The InnoDB redo log file size, or 0 when changing the redo log format
 at startup (while disallowing writes to the redo log). */
@@ -242,6 +254,9 @@ extern ulint	srv_lock_table_size;
 extern ulong	srv_checksum_algorithm;
 extern my_bool	srv_random_read_ahead;
 extern ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_logical: number of leaf pages to read ahead
+in the key order of an index range scan, or 0 to use linear read-ahead */
+extern ulong	srv_read_ahead_logical;
 extern uint	srv_n_read_io_threads;
 extern uint	srv_n_write_io_threads;
 
@@ -280,6 +295,8 @@ extern ibool	srv_innodb_status;
 extern uint32_t			srv_stats_transient_sample_pages;
 extern my_bool			srv_stats_persistent;
 extern uint32_t			srv_stats_persistent_sample_pages;
+/** innodb_stats_persistent_threads */
+extern uint			srv_stats_persistent_threads;
 extern my_bool			srv_stats_auto_recalc;
 extern my_bool			srv_stats_include_delete_marked;
 extern unsigned long long	srv_stats_modified_counter;
@@ -360,6 +377,9 @@ extern uint srv_n_purge_threads;
 
 /* the number of pages to purge in one batch */
 extern ulong srv_purge_batch_size;
+/** innodb_purge_batch_size_adaptive: whether to increase the purge
+batch size when the history list is long */
+extern my_bool srv_purge_batch_size_adaptive;
 
 /* print all user-level transactions deadlocks to mysqld stderr */
 extern my_bool srv_print_all_deadlocks;
@@ -597,6 +617,10 @@ struct export_var_t{
 	lsn_t innodb_lsn_current;
 	lsn_t innodb_lsn_flushed;
 	lsn_t innodb_lsn_last_checkpoint;
+	/** log_archive_lsn() */
+	lsn_t innodb_lsn_archived;
+	/** log_archive_status() */
+	const char* innodb_log_archive_status;
 	trx_id_t innodb_max_trx_id;
 #ifdef BTR_CUR_HASH_ADAPT
 	ulint innodb_mem_adaptive_hash;
@@ -621,6 +645,13 @@ struct export_var_t{
 	/* Number of InnoDB bulk operations */
 	Atomic_counter<ulint> innodb_bulk_operations;
 
+	/** Number of rows that batched table scans read ahead
+	into the fetch cache */
+	Atomic_counter<ulint> innodb_rows_prefetched;
+
+	/** Number of ha_innobase::rnd_next_batch() calls */
+	Atomic_counter<ulint> innodb_scan_batches;
+
 	ulint innodb_onlineddl_rowlog_rows;	/*!< Online alter rows */
 	ulint innodb_onlineddl_rowlog_pct_used; /*!< Online alter percentage
 						of used row log buffer */
@@ -870,6 +870,24 @@ class trx_sys_t
   alignas(CPU_LEVEL1_DCACHE_LINESIZE)
   std::atomic<trx_id_t> m_rw_trx_hash_version;
 
+  /**
+    Incremented by deregister_rw(). Together with m_max_trx_id, identifies
+    the contents of rw_trx_hash for the cached snapshot.
+
+    @sa deregister_rw()
+    @sa snapshot_ids()
+  */
+  std::atomic<uint64_t> m_rw_trx_hash_epoch;
+
+
+  /** The latest snapshot created by create_snapshot(), or nullptr */
+  alignas(CPU_LEVEL1_DCACHE_LINESIZE)
+  std::atomic<ReadViewSnapshot*> m_snapshot;
+
+  /** All snapshots that have been allocated; elements are only added
+  until close() */
+  std::atomic<ReadViewSnapshot*> m_snapshots;
+
 
   bool m_initialised;
 
@@ -1078,27 +1096,45 @@ class trx_sys_t
     of rw_trx_hash.iterate_no_dups(). It means that some transaction
     identifiers may appear multiple times in ids.
 
+    The contents of rw_trx_hash can only change by register_rw() or
+    assign_new_trx_no(), which increment m_max_trx_id, or by deregister_rw(),
+    which increments m_rw_trx_hash_epoch. If neither changed since the
+    latest snapshot was published in m_snapshot, a reference to it is
+    returned, without acquiring any latch and without copying the
+    identifiers. Otherwise, create_snapshot() iterates rw_trx_hash.
+
+    A snapshot is acquired by incrementing its reference count and then
+    checking that it is still published. ReadViewSnapshot objects are only
+    freed by close(), and create_snapshot() will only reuse one whose
+    reference count is 0, so the increment is always safe, and a snapshot
+    that was republished in the meantime is complete.
+
+    m_rw_trx_hash_epoch must be loaded before rw_trx_hash is iterated,
+    so that a snapshot that might miss a concurrently deregistered
+    transaction will not be mistaken for a newer one.
+
     @param[in,out] caller_trx used to get access to rw_trx_hash_pins
-    @param[out]    ids        array to store registered transaction identifiers
-    @param[out]    max_trx_id variable to store m_max_trx_id value
-    @param[out]    mix_trx_no variable to store min(no) value
+    @return a snapshot, to be released by ReadViewSnapshot::release()
   */
 
-  void snapshot_ids(trx_t *caller_trx, trx_ids_t *ids, trx_id_t *max_trx_id,
-                    trx_id_t *min_trx_no)
+  ReadViewSnapshot *snapshot_ids(trx_t *caller_trx)
   {
-    snapshot_ids_arg arg(ids);
+    const uint64_t epoch= m_rw_trx_hash_epoch.load(std::memory_order_acquire);
+    trx_id_t max_trx_id;
 
-    while ((arg.m_id= get_rw_trx_hash_version()) != get_max_trx_id())
+    while ((max_trx_id= get_rw_trx_hash_version()) != get_max_trx_id())
       ut_delay(1);
-    arg.m_no= arg.m_id;
 
-    ids->clear();
-    ids->reserve(rw_trx_hash.size() + 32);
-    rw_trx_hash.iterate(caller_trx, copy_one_id, &arg);
+    if (ReadViewSnapshot *s= m_snapshot.load(std::memory_order_acquire))
+    {
+      s->ref_count.fetch_add(1, std::memory_order_acquire);
+      if (s == m_snapshot.load(std::memory_order_acquire) &&
+          s->max_trx_id == max_trx_id && s->epoch == epoch)
+        return s;
+      s->release();
+    }
 
-    *max_trx_id= arg.m_id;
-    *min_trx_no= arg.m_no;
+    return create_snapshot(caller_trx, max_trx_id, epoch);
   }
 
 
@@ -1107,6 +1143,8 @@ class trx_sys_t
   {
     m_max_trx_id= value;
     m_rw_trx_hash_version.store(value, std::memory_order_relaxed);
+    if (ReadViewSnapshot *s= m_snapshot.exchange(nullptr))
+      s->release();
   }
 
 
@@ -1176,11 +1214,15 @@ class trx_sys_t
 
     Transaction is removed from rw_trx_hash, which releases all implicit locks.
     MVCC snapshot won't see this transaction anymore.
+
+    We rely on the RELEASE memory barrier of the m_rw_trx_hash_epoch
+    increment to invalidate m_snapshot after the transaction was removed.
   */
 
   void deregister_rw(trx_t *trx)
   {
     rw_trx_hash.erase(trx);
+    m_rw_trx_hash_epoch.fetch_add(1, std::memory_order_release);
   }
 
 
@@ -1276,6 +1318,17 @@ class trx_sys_t
   };
 
 
+  /**
+    Create and publish a snapshot of rw_trx_hash.
+    @param caller_trx  used to get access to rw_trx_hash_pins
+    @param max_trx_id  get_max_trx_id() == get_rw_trx_hash_version()
+    @param epoch       m_rw_trx_hash_epoch before max_trx_id was loaded
+    @return the snapshot, to be released by ReadViewSnapshot::release()
+  */
+  ReadViewSnapshot *create_snapshot(trx_t *caller_trx, trx_id_t max_trx_id,
+                                    uint64_t epoch);
+
+
   static my_bool copy_one_id(void* el, void *a)
   {
     auto element= static_cast<const rw_trx_hash_element_t *>(el);
@@ -869,6 +869,7 @@ constexpr const char* const auto_event_names[] =
   "mem0mem",
   "os0file",
   "pars0lex",
+  "read0read",
   "rem0rec",
   "row0ftsort",
   "row0import",
@@ -0,0 +1,908 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file log/log0arch.cc
+Archiving of the redo log
+*******************************************************/
+
+#include "log0arch.h"
+#include "log0recv.h"
+#include "mach0data.h"
+#include "srv0srv.h"
+#include "log.h"
+#include <my_dir.h>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+/** An archive file */
+struct log_archive_file
+{
+  /** the first LSN in the file */
+  lsn_t start;
+  /** the end of the durably archived log in the file */
+  lsn_t end;
+
+  bool operator<(const log_archive_file &other) const
+  { return start < other.start; }
+};
+
+/** The log archiver */
+struct log_archiver
+{
+  /** size of buf */
+  static constexpr size_t buf_size= 1U << 20;
+
+  /** protects timer and the submission of log_archive_task */
+  mysql_mutex_t mutex;
+  /** periodically submits log_archive_task; nullptr if not started */
+  std::unique_ptr<tpool::timer> timer;
+
+  /** handle for reading ib_logfile0 */
+  os_file_t log_file= OS_FILE_CLOSED;
+  /** log_sys.get_first_lsn() when log_file was opened */
+  lsn_t log_first_lsn;
+  /** log_sys.file_size when log_file was opened */
+  lsn_t log_file_size;
+
+  /** the archive file that is being written */
+  os_file_t file= OS_FILE_CLOSED;
+  /** name of file */
+  std::string name;
+  /** the first LSN in file */
+  lsn_t start;
+  /** number of times the end LSN has been written to file */
+  size_t end_no;
+  /** buffer for copying the log; nullptr if not initialized */
+  byte *buf= nullptr;
+  /** number of consecutive attempts to archive the log that failed */
+  Atomic_relaxed<uint> failures{0};
+  /** the end of the archived log when fail() stopped archiving, or 0 */
+  Atomic_relaxed<lsn_t> stopped_lsn{0};
+
+  /** Durably write the end of the archived log to file.
+  @param end  end of the archived log
+  @return whether the write succeeded */
+  bool write_end(lsn_t end);
+  /** Create an archive file.
+  @param lsn  the first LSN of the file
+  @return whether the file was created */
+  bool create(lsn_t lsn);
+  /** Open ib_logfile0 for reading, unless log_file is current.
+  The caller must hold log_sys.latch.
+  @return whether log_file is open */
+  bool open_log();
+  /** Copy the durably written log to the archive.
+  @retval DB_SUCCESS   if the log was archived
+  @retval DB_IO_ERROR  if the copying may be retried
+  @retval DB_CORRUPTION if the log was lost before it was archived */
+  dberr_t copy();
+  /** Copy the durably written log to the archive, and handle errors.
+  @param retry  whether to retry later after an I/O error, while
+                log_sys.archived_lsn holds back log checkpoints */
+  void archive(bool retry);
+  /** Stop archiving after an error. */
+  void fail();
+  /** Close the files. */
+  void close_files();
+};
+
+/** The log archiver */
+log_archiver log_arch;
+}
+
+/** @return whether innodb_log_archive_dir is set */
+static bool log_archive_configured()
+{
+  return srv_log_archive_dir && *srv_log_archive_dir;
+}
+
+/** @return the path of an archive file
+@param lsn  the first LSN in the file */
+static std::string log_archive_path(lsn_t lsn)
+{
+  char name[sizeof LOG_ARCHIVE_PREFIX + 20];
+  snprintf(name, sizeof name, "%s%020" PRIu64, LOG_ARCHIVE_PREFIX, lsn);
+  std::string path{srv_log_archive_dir};
+
+  switch (path.back()) {
+#ifdef _WIN32
+  case '\\':
+#endif
+  case '/':
+    break;
+  default:
+    path.push_back('/');
+  }
+  return path.append(name);
+}
+
+/** Read the header of an archive file.
+@param file   archive file
+@param start  the expected first LSN of the file
+@param hdr    buffer of log_t::START_OFFSET bytes
+@return the end of the durably archived log in the file
+@retval 0 if the file is not valid */
+static lsn_t log_archive_read_header(os_file_t file, lsn_t start, byte *hdr)
+{
+  if (os_file_read_func(IORequestRead, file, hdr, 0, log_t::START_OFFSET,
+                        nullptr) != DB_SUCCESS ||
+      mach_read_from_8(hdr + LOG_HEADER_START_LSN) != start ||
+      my_crc32c(0, hdr, 508) != mach_read_from_4(hdr + 508))
+    return 0;
+
+  lsn_t end= 0;
+  for (size_t field= log_t::CHECKPOINT_1; field <= log_t::CHECKPOINT_2;
+       field+= log_t::CHECKPOINT_2 - log_t::CHECKPOINT_1)
+  {
+    const byte *b= hdr + field;
+    const lsn_t e{mach_read_from_8(b)};
+    if (e >= start && e > end && my_crc32c(0, b, 60) == mach_read_from_4(b + 60))
+      end= e;
+  }
+  return end;
+}
+
+/** @return whether an archive file was written in the current log format
+@param hdr  header of the archive file */
+static bool log_archive_compatible(const byte *hdr)
+{
+  alignas(8) byte b[512];
+  memset(b, 0, sizeof b);
+  log_t::header_write(b, mach_read_from_8(hdr + LOG_HEADER_START_LSN),
+                      log_sys.is_encrypted());
+  /* Ignore the LOG_HEADER_CREATOR, which includes the server version. */
+  return !memcmp(b, hdr, LOG_HEADER_CREATOR) &&
+    !memcmp(b + LOG_HEADER_CREATOR_END, hdr + LOG_HEADER_CREATOR_END,
+            508 - LOG_HEADER_CREATOR_END);
+}
+
+/** Collect the archive files in ascending order of LSN.
+@param files  the valid archive files
+@return whether innodb_log_archive_dir could be read */
+static bool log_archive_list(std::vector<log_archive_file> &files)
+{
+  MY_DIR *dir= my_dir(srv_log_archive_dir, MYF(MY_DONT_SORT));
+  if (!dir)
+    return false;
+
+  byte *hdr= static_cast<byte*>(aligned_malloc(log_t::START_OFFSET, 4096));
+
+  for (size_t i= 0; i < dir->number_of_files; i++)
+  {
+    const char *n= dir->dir_entry[i].name;
+    if (strncmp(n, LOG_ARCHIVE_PREFIX, sizeof LOG_ARCHIVE_PREFIX - 1))
+      continue;
+    char *end;
+    const lsn_t start{strtoull(n + sizeof LOG_ARCHIVE_PREFIX - 1, &end, 10)};
+    const std::string path{log_archive_path(start)};
+    if (*end || start < log_t::FIRST_LSN ||
+        strcmp(path.c_str() + path.size() - strlen(n), n))
+      continue;
+    bool success;
+    os_file_t file= os_file_create_simple_no_error_handling_func(
+      path.c_str(), OS_FILE_OPEN, OS_FILE_READ_ONLY, true, &success);
+    if (!success)
+      continue;
+    if (const lsn_t e= log_archive_read_header(file, start, hdr))
+      files.push_back({start, e});
+    else
+      sql_print_warning("InnoDB: Ignoring invalid log archive %s",
+                        path.c_str());
+    os_file_close(file);
+  }
+
+  aligned_free(hdr);
+  my_dirend(dir);
+  std::sort(files.begin(), files.end());
+  return true;
+}
+
+bool log_archiver::write_end(lsn_t end)
+{
+  byte b[64];
+  memset(b, 0, sizeof b);
+  mach_write_to_8(b, end);
+  mach_write_to_4(b + 60, my_crc32c(0, b, 60));
+  const os_offset_t offset= (end_no++ & 1)
+    ? log_t::CHECKPOINT_2 : log_t::CHECKPOINT_1;
+  return os_file_write_func(IORequestWrite, name.c_str(), file, b, offset,
+                            sizeof b) == DB_SUCCESS &&
+    os_file_flush_func(file);
+}
+
+bool log_archiver::create(lsn_t lsn)
+{
+  if (file != OS_FILE_CLOSED)
+  {
+    os_file_close(file);
+    file= OS_FILE_CLOSED;
+  }
+
+  name= log_archive_path(lsn);
+  bool success;
+  file= os_file_create_simple_no_error_handling_func(
+    name.c_str(), OS_FILE_CREATE, OS_FILE_READ_WRITE, false, &success);
+  if (!success)
+  {
+    file= OS_FILE_CLOSED;
+    if (!failures)
+      sql_print_error("InnoDB: Cannot create %s", name.c_str());
+    return false;
+  }
+
+  start= lsn;
+  end_no= 0;
+  memset_aligned<4096>(buf, 0, log_t::START_OFFSET);
+  log_t::header_write(buf, lsn, log_sys.is_encrypted());
+  if (os_file_write_func(IORequestWrite, name.c_str(), file, buf, 0,
+                         log_t::START_OFFSET) == DB_SUCCESS && write_end(lsn))
+    return true;
+  sql_print_error("InnoDB: Cannot write %s", name.c_str());
+  /* Let a retry create the file again. */
+  os_file_close(file);
+  file= OS_FILE_CLOSED;
+  os_file_delete_if_exists_func(name.c_str(), nullptr);
+  return false;
+}
+
+bool log_archiver::open_log()
+{
+  ut_ad(log_sys.latch_have_rd());
+  /* log_sys.get_first_lsn() and log_sys.file_size change when
+  log_t::write_checkpoint() adopts a resized ib_logfile0, while
+  holding exclusive log_sys.latch. */
+  if (log_file != OS_FILE_CLOSED &&
+      log_first_lsn == log_sys.get_first_lsn() &&
+      log_file_size == log_sys.file_size)
+    return true;
+  if (log_file != OS_FILE_CLOSED)
+    os_file_close(log_file);
+  bool success;
+  log_file= os_file_create_simple_no_error_handling_func(
+    get_log_file_path().c_str(), OS_FILE_OPEN, OS_FILE_READ_ONLY, true,
+    &success);
+  if (!success)
+  {
+    log_file= OS_FILE_CLOSED;
+    return false;
+  }
+  log_first_lsn= log_sys.get_first_lsn();
+  log_file_size= log_sys.file_size;
+  return true;
+}
+
+dberr_t log_archiver::copy()
+{
+  for (;;)
+  {
+    lsn_t lsn{log_sys.archived_lsn};
+    if (!lsn)
+      return DB_SUCCESS;
+
+    log_sys.latch.rd_lock(SRW_LOCK_CALL);
+    const lsn_t end{log_sys.get_flushed_lsn()};
+    const lsn_t first_lsn{log_sys.get_first_lsn()};
+    const lsn_t capacity{log_sys.capacity()};
+    const bool opened{lsn >= end || open_log()};
+    log_sys.latch.rd_unlock();
+
+    if (!opened)
+    {
+      if (!failures)
+        sql_print_error("InnoDB: Cannot open ib_logfile0 for archiving");
+      return DB_IO_ERROR;
+    }
+    if (lsn >= end)
+      return DB_SUCCESS;
+    if (lsn < first_lsn)
+    {
+      sql_print_error("InnoDB: The log between LSN=" LSN_PF " and " LSN_PF
+                      " was discarded before it was archived",
+                      lsn, first_lsn);
+      return DB_CORRUPTION;
+    }
+    /* An earlier attempt may have failed to create the file. */
+    if (file == OS_FILE_CLOSED && !create(lsn))
+      return DB_IO_ERROR;
+
+    while (lsn < end)
+    {
+      if (lsn - start >= capacity)
+      {
+        /* Start a new file after archiving the size of ib_logfile0. */
+        if (!os_file_flush_func(file) || !write_end(lsn))
+        {
+          if (!failures)
+            sql_print_error("InnoDB: Cannot write %s", name.c_str());
+          return DB_IO_ERROR;
+        }
+        log_sys.archived_lsn= lsn;
+        if (!create(lsn))
+          return DB_IO_ERROR;
+      }
+
+      const size_t len= size_t(std::min({end - lsn, lsn_t{buf_size},
+                                         start + capacity - lsn}));
+      const os_offset_t offset= log_t::START_OFFSET +
+        (lsn - first_lsn) % capacity;
+      const size_t first_len= size_t(std::min<lsn_t>(len, log_t::START_OFFSET +
+                                                     capacity - offset));
+      if (os_file_read_func(IORequestRead, log_file, buf, offset, first_len,
+                            nullptr) != DB_SUCCESS ||
+          (len > first_len &&
+           os_file_read_func(IORequestRead, log_file, buf + first_len,
+                             log_t::START_OFFSET, len - first_len,
+                             nullptr) != DB_SUCCESS))
+      {
+        if (!failures)
+          sql_print_error("InnoDB: Cannot read ib_logfile0 for archiving");
+        return DB_IO_ERROR;
+      }
+
+      /* The log is written in blocks of log_sys.write_size. If the
+      writer got ahead by a full lap, what we read may be garbage. */
+      if (log_sys.get_lsn() + log_sys.write_size > lsn + capacity)
+      {
+        sql_print_error("InnoDB: The log at LSN=" LSN_PF
+                        " was overwritten before it was archived", lsn);
+        return DB_CORRUPTION;
+      }
+
+      if (DBUG_IF("log_archive_write_fail") ||
+          os_file_write_func(IORequestWrite, name.c_str(), file, buf,
+                             log_t::START_OFFSET + (lsn - start),
+                             len) != DB_SUCCESS)
+      {
+        if (!failures)
+          sql_print_error("InnoDB: Cannot write %s", name.c_str());
+        return DB_IO_ERROR;
+      }
+      lsn+= len;
+    }
+
+    if (!os_file_flush_func(file) || !write_end(lsn))
+    {
+      if (!failures)
+        sql_print_error("InnoDB: Cannot write %s", name.c_str());
+      return DB_IO_ERROR;
+    }
+
+    /* Now log_checkpoint_low() may discard the log up to lsn. */
+    log_sys.archived_lsn= lsn;
+  }
+}
+
+void log_archiver::archive(bool retry)
+{
+  switch (copy()) {
+  case DB_SUCCESS:
+    if (failures)
+    {
+      sql_print_information("InnoDB: Resumed archiving the log");
+      failures= 0;
+    }
+    return;
+  case DB_IO_ERROR:
+    if (retry && failures < srv_log_archive_retry_limit)
+    {
+      /* Keep holding back log checkpoints. Once the log is full,
+      writes will wait for the archive to catch up. */
+      if (!failures.fetch_add(1))
+        sql_print_warning("InnoDB: Retrying to archive the log from LSN="
+                          LSN_PF " every second, up to %u times",
+                          lsn_t{log_sys.archived_lsn},
+                          srv_log_archive_retry_limit);
+      return;
+    }
+    /* fall through */
+  default:
+    fail();
+  }
+}
+
+void log_archiver::fail()
+{
+  if (const lsn_t lsn= log_sys.archived_lsn)
+  {
+    /* Rather than blocking log checkpoints forever, give up. */
+    sql_print_error("InnoDB: Stopped archiving the log at LSN=" LSN_PF, lsn);
+    stopped_lsn= lsn;
+    log_sys.archived_lsn= 0;
+  }
+  failures= 0;
+}
+
+void log_archiver::close_files()
+{
+  if (file != OS_FILE_CLOSED)
+  {
+    os_file_close(file);
+    file= OS_FILE_CLOSED;
+  }
+  if (log_file != OS_FILE_CLOSED)
+  {
+    os_file_close(log_file);
+    log_file= OS_FILE_CLOSED;
+  }
+}
+
+/** Copy the durably written log to the archive. */
+static void log_archive_callback(void *)
+{
+  if (log_sys.archived_lsn)
+    log_arch.archive(true);
+}
+
+/** Archive the log in srv_thread_pool, one task at a time */
+static tpool::task_group log_archive_group(1);
+static tpool::waitable_task log_archive_task(log_archive_callback, nullptr,
+                                             &log_archive_group);
+
+/** Submit log_archive_task, unless it is already running.
+The caller must hold log_arch.mutex. */
+static void log_archive_submit()
+{
+  mysql_mutex_assert_owner(&log_arch.mutex);
+  if (log_arch.timer && !log_archive_task.is_running())
+    srv_thread_pool->submit_task(&log_archive_task);
+}
+
+/** Archive the log every second, in case log_archive_wake() is not
+being invoked. */
+static void log_archive_timer_callback(void *)
+{
+  mysql_mutex_lock(&log_arch.mutex);
+  log_archive_submit();
+  mysql_mutex_unlock(&log_arch.mutex);
+}
+
+dberr_t log_archive_init(lsn_t lsn, bool fresh) noexcept
+{
+  if (!log_archive_configured() || srv_read_only_mode ||
+      srv_operation != SRV_OPERATION_NORMAL ||
+      srv_force_recovery >= SRV_FORCE_NO_LOG_REDO || !log_sys.is_latest())
+    return DB_SUCCESS;
+
+  if (srv_log_archive_recovery_lsn)
+  {
+    /* The archive is from an earlier timeline than this data directory. */
+    if (!fresh)
+      sql_print_information("InnoDB: Not archiving the log,"
+                            " because innodb_log_archive_recovery_lsn"
+                            " is set");
+    return DB_SUCCESS;
+  }
+
+  log_arch.failures= 0;
+  log_arch.stopped_lsn= 0;
+
+  if (log_arch.buf)
+  {
+    if (!fresh)
+      return DB_SUCCESS;
+    /* ib_logfile0 is being rebuilt, possibly in a different format. */
+    log_arch.close_files();
+  }
+  else
+  {
+    mysql_mutex_init(0, &log_arch.mutex, nullptr);
+    log_arch.buf= static_cast<byte*>(aligned_malloc(log_arch.buf_size, 4096));
+  }
+
+  if (!fresh)
+  {
+    std::vector<log_archive_file> files;
+    if (!log_archive_list(files))
+    {
+      sql_print_error("InnoDB: Cannot read innodb_log_archive_dir=%s",
+                      srv_log_archive_dir);
+      return DB_ERROR;
+    }
+
+    if (!files.empty())
+    {
+      const log_archive_file &last= files.back();
+      if (last.end >= lsn && last.end <= log_sys.get_lsn())
+      {
+        log_arch.name= log_archive_path(last.start);
+        bool success;
+        log_arch.file= os_file_create_simple_no_error_handling_func(
+          log_arch.name.c_str(), OS_FILE_OPEN, OS_FILE_READ_WRITE, false,
+          &success);
+        if (!success)
+          log_arch.file= OS_FILE_CLOSED;
+        else if (log_archive_read_header(log_arch.file, last.start,
+                                         log_arch.buf) == last.end &&
+                 log_archive_compatible(log_arch.buf))
+        {
+          log_arch.start= last.start;
+          log_arch.end_no= 0;
+          log_sys.archived_lsn= last.end;
+          sql_print_information("InnoDB: Archiving the log from LSN=" LSN_PF
+                                " to %s", last.end, log_arch.name.c_str());
+          return DB_SUCCESS;
+        }
+      }
+      else
+        sql_print_warning("InnoDB: The log archive ends at LSN=" LSN_PF
+                          ", outside the recovered log from LSN=" LSN_PF
+                          " to LSN=" LSN_PF "; starting a new archive file",
+                          last.end, lsn, log_sys.get_lsn());
+    }
+  }
+
+  if (!log_arch.create(lsn))
+    return DB_ERROR;
+  log_sys.archived_lsn= lsn;
+  return DB_SUCCESS;
+}
+
+void log_archive_start() noexcept
+{
+  if (!log_sys.archived_lsn)
+    return;
+  mysql_mutex_lock(&log_arch.mutex);
+  if (!log_arch.timer)
+    srv_start_periodic_timer(log_arch.timer, log_archive_timer_callback, 1000);
+  mysql_mutex_unlock(&log_arch.mutex);
+}
+
+void log_archive_wake() noexcept
+{
+  ut_ad(log_arch.buf);
+  /* After an error, only log_archive_timer_callback() retries. */
+  if (log_arch.failures)
+    return;
+  mysql_mutex_lock(&log_arch.mutex);
+  log_archive_submit();
+  mysql_mutex_unlock(&log_arch.mutex);
+}
+
+void log_archive_sync() noexcept
+{
+  ut_ad(!log_arch.timer);
+  if (log_sys.archived_lsn)
+  {
+    log_buffer_flush_to_disk();
+    log_arch.archive(false);
+  }
+}
+
+void log_archive_close() noexcept
+{
+  if (!log_arch.buf)
+    return;
+
+  mysql_mutex_lock(&log_arch.mutex);
+  std::unique_ptr<tpool::timer> timer{std::move(log_arch.timer)};
+  mysql_mutex_unlock(&log_arch.mutex);
+  /* Wait for any pending log_archive_timer_callback() */
+  timer.reset();
+  log_archive_task.wait();
+
+  if (log_sys.archived_lsn && log_sys.is_opened())
+    log_arch.archive(false);
+
+  log_sys.archived_lsn= 0;
+  log_arch.close_files();
+  aligned_free(log_arch.buf);
+  log_arch.buf= nullptr;
+  mysql_mutex_destroy(&log_arch.mutex);
+}
+
+const char *log_archive_status() noexcept
+{
+  if (log_sys.archived_lsn)
+    return log_arch.failures ? "RETRYING" : "ON";
+  return log_arch.stopped_lsn ? "STOPPED" : "OFF";
+}
+
+lsn_t log_archive_lsn() noexcept
+{
+  if (const lsn_t lsn= log_sys.archived_lsn)
+    return lsn;
+  return log_arch.stopped_lsn;
+}
+
+/** Read a part of the recovered ib_logfile0.
+@param lsn  the first LSN to read
+@param b    output buffer
+@param len  number of bytes to read
+@return DB_SUCCESS or error code */
+static dberr_t log_archive_read_recovered(lsn_t lsn, byte *b, size_t len)
+{
+  byte *block= static_cast<byte*>(aligned_malloc(4096, 4096));
+  dberr_t err= DB_SUCCESS;
+
+  for (size_t i= 0; i < len; )
+  {
+    const os_offset_t offset= log_t::START_OFFSET +
+      (lsn + i - log_sys.get_first_lsn()) % log_sys.capacity();
+    const size_t o= size_t(offset & 4095);
+    const size_t n= std::min(len - i, 4096 - o);
+    if (log_sys.is_mmap())
+      memcpy(b + i, log_sys.buf + offset, n);
+    else if ((err= log_sys.log.read(offset - o, {block, 4096})))
+      break;
+    else
+      memcpy(b + i, block + o, n);
+    i+= n;
+  }
+
+  aligned_free(block);
+  return err;
+}
+
+dberr_t log_archive_restore() noexcept
+{
+  ut_ad(log_sys.is_latest());
+  ut_ad(srv_operation == SRV_OPERATION_NORMAL);
+  const lsn_t checkpoint{log_sys.next_checkpoint_lsn};
+  const lsn_t end_lsn{recv_sys.lsn};
+  const lsn_t target{srv_log_archive_recovery_lsn};
+  const bool encrypted{log_sys.is_encrypted()};
+  const size_t nonce{encrypted ? 8U : 0U};
+  const size_t checkpoint_size{SIZE_OF_FILE_CHECKPOINT + nonce};
+
+  if (!log_archive_configured())
+  {
+    sql_print_error("InnoDB: innodb_log_archive_recovery_lsn"
+                    " requires innodb_log_archive_dir");
+    return DB_ERROR;
+  }
+
+  if (target < end_lsn + checkpoint_size)
+  {
+    sql_print_error("InnoDB: innodb_log_archive_recovery_lsn=" LSN_PF
+                    " precedes the checkpoint at LSN=" LSN_PF,
+                    target, checkpoint);
+    return DB_ERROR;
+  }
+
+  std::vector<log_archive_file> files;
+  if (!log_archive_list(files))
+  {
+    sql_print_error("InnoDB: Cannot read innodb_log_archive_dir=%s",
+                    srv_log_archive_dir);
+    return DB_ERROR;
+  }
+
+  auto f= std::upper_bound(files.begin(), files.end(),
+                           log_archive_file{checkpoint, 0});
+  if (f == files.begin() || (--f)->end <= checkpoint)
+  {
+    sql_print_error("InnoDB: The log archive does not contain the"
+                    " checkpoint LSN=" LSN_PF, checkpoint);
+    return DB_ERROR;
+  }
+
+  const std::string path{get_log_file_path("ib_logfile101")};
+  delete_log_file("101");
+  bool success;
+  os_file_t out= os_file_create_simple_no_error_handling_func(
+    path.c_str(), OS_FILE_CREATE, OS_FILE_READ_WRITE, false, &success);
+  if (!success)
+  {
+    sql_print_error("InnoDB: Cannot create %s", path.c_str());
+    return DB_ERROR;
+  }
+
+  byte *hdr= static_cast<byte*>(aligned_malloc(log_t::START_OFFSET, 4096));
+  /* A partial mini-transaction, followed by the next read */
+  constexpr size_t buf_size{2 * recv_sys_t::MTR_SIZE_MAX};
+  byte *buf= static_cast<byte*>(aligned_malloc(buf_size, 4096));
+  dberr_t err= DB_SUCCESS;
+  bool checkpoint_found= false;
+
+  /* The log will be recovered as a non-wrapping ib_logfile0, like the
+  one that mariadb-backup creates. */
+  memset_aligned<4096>(hdr, 0, log_t::START_OFFSET);
+  log_t::header_write(hdr, checkpoint, encrypted);
+  mach_write_to_8(hdr + log_t::CHECKPOINT_1, checkpoint);
+  mach_write_to_8(hdr + log_t::CHECKPOINT_1 + 8, end_lsn);
+  mach_write_to_4(hdr + log_t::CHECKPOINT_1 + 60,
+                  my_crc32c(0, hdr + log_t::CHECKPOINT_1, 60));
+  if (os_file_write_func(IORequestWrite, path.c_str(), out, hdr, 0,
+                         log_t::START_OFFSET) != DB_SUCCESS)
+    err= DB_ERROR;
+
+  /* the LSN of buf[0] */
+  lsn_t lsn{checkpoint};
+  /* the number of bytes in buf */
+  size_t n= 0;
+
+  for (bool stop= false;
+       !stop && err == DB_SUCCESS && f != files.end() && f->start <= lsn + n &&
+         lsn + n < f->end; f++)
+  {
+    const std::string name{log_archive_path(f->start)};
+    os_file_t file= os_file_create_simple_no_error_handling_func(
+      name.c_str(), OS_FILE_OPEN, OS_FILE_READ_ONLY, true, &success);
+    if (!success)
+      break;
+    if (log_archive_read_header(file, f->start, hdr) != f->end ||
+        !log_archive_compatible(hdr))
+    {
+      /* The log was rebuilt in a different format. */
+      sql_print_warning("InnoDB: Not replaying the log archive %s",
+                        name.c_str());
+      os_file_close(file);
+      break;
+    }
+
+    while (lsn + n < f->end)
+    {
+      const size_t len= size_t(std::min<lsn_t>(buf_size - n,
+                                               f->end - (lsn + n)));
+      if (os_file_read_func(IORequestRead, file, buf + n,
+                            log_t::START_OFFSET + (lsn + n - f->start), len,
+                            nullptr) != DB_SUCCESS)
+      {
+        sql_print_error("InnoDB: Cannot read %s", name.c_str());
+        err= DB_ERROR;
+        break;
+      }
+      n+= len;
+
+      size_t done= 0;
+      while (size_t m= log_mtr_length(buf + done, buf + n, encrypted))
+      {
+        if (lsn + done + m > target)
+        {
+          stop= true;
+          break;
+        }
+        if (lsn + done == end_lsn)
+        {
+          /* The FILE_CHECKPOINT record must be the same as in ib_logfile0,
+          except for the sequence bit. */
+          byte b[SIZE_OF_FILE_CHECKPOINT + 8];
+          if (m != checkpoint_size ||
+              log_archive_read_recovered(end_lsn, b, m) != DB_SUCCESS ||
+              memcmp(b, buf + done, m - 5 - nonce) ||
+              memcmp(b + m - 4 - nonce, buf + done + m - 4 - nonce, 4 + nonce))
+          {
+            sql_print_error("InnoDB: The log archive does not match"
+                            " ib_logfile0 at LSN=" LSN_PF, end_lsn);
+            err= DB_ERROR;
+            stop= true;
+            break;
+          }
+          checkpoint_found= true;
+        }
+        /* Every mini-transaction is followed by a sequence bit of 1
+        in the first lap of a log file. */
+        buf[done + m - 5 - nonce]= 1;
+        done+= m;
+      }
+
+      if (err != DB_SUCCESS)
+        break;
+      if (done &&
+          os_file_write_func(IORequestWrite, path.c_str(), out, buf,
+                             log_t::START_OFFSET + (lsn - checkpoint),
+                             done) != DB_SUCCESS)
+      {
+        err= DB_ERROR;
+        break;
+      }
+      lsn+= done;
+      n-= done;
+      memmove(buf, buf + done, n);
+      if (stop || n == buf_size)
+      {
+        /* We reached the target, or the archive is corrupted. */
+        stop= true;
+        break;
+      }
+    }
+
+    os_file_close(file);
+  }
+
+  if (err == DB_SUCCESS && !checkpoint_found)
+  {
+    sql_print_error("InnoDB: The log archive does not contain"
+                    " the FILE_CHECKPOINT record at LSN=" LSN_PF, end_lsn);
+    err= DB_ERROR;
+  }
+
+  if (err == DB_SUCCESS &&
+      (!os_file_set_size(path.c_str(), out,
+                         ut_calc_align<lsn_t>(log_t::START_OFFSET +
+                                              lsn - checkpoint, 4096) + 4096) ||
+       !os_file_flush_func(out)))
+    err= DB_ERROR;
+
+  os_file_close(out);
+  aligned_free(buf);
+  aligned_free(hdr);
+
+  if (err != DB_SUCCESS)
+  {
+    delete_log_file("101");
+    return err;
+  }
+
+  sql_print_information("InnoDB: Replaying the log archive from LSN=" LSN_PF
+                        " to LSN=" LSN_PF, checkpoint, lsn);
+  return DB_SUCCESS;
+}
+
+/** Rename a log file.
+@param from  the current name
+@param to    the new name
+@return whether the file was renamed */
+static bool log_archive_rename(const std::string &from, const std::string &to)
+{
+  if (IF_WIN(MoveFileEx(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING),
+             !rename(from.c_str(), to.c_str())))
+    return true;
+  sql_print_error("InnoDB: Failed to rename %s to %s (error %d)",
+                  from.c_str(), to.c_str(), IF_WIN(int(GetLastError()), errno));
+  return false;
+}
+
+dberr_t log_archive_replace() noexcept
+{
+  const std::string log0{get_log_file_path()};
+  const std::string orig{get_log_file_path(LOG_ARCHIVE_ORIGINAL)};
+
+  bool exists;
+  os_file_type_t type;
+  if (!os_file_status(orig.c_str(), &exists, &type))
+    return DB_ERROR;
+  if (exists)
+  {
+    /* An earlier attempt was interrupted; ib_logfile0 is a copy
+    of the log archive. */
+    sql_print_information("InnoDB: Keeping the original ib_logfile0 as %s",
+                          orig.c_str());
+    return log_archive_rename(get_log_file_path("ib_logfile101"), log0)
+      ? DB_SUCCESS : DB_ERROR;
+  }
+
+  if (!log_archive_rename(log0, orig))
+    return DB_ERROR;
+  if (log_archive_rename(get_log_file_path("ib_logfile101"), log0))
+  {
+    sql_print_information("InnoDB: Renamed the original ib_logfile0 to %s"
+                          " until the log archive has been recovered",
+                          orig.c_str());
+    return DB_SUCCESS;
+  }
+  log_archive_rename(orig, log0);
+  return DB_ERROR;
+}
+
+void log_archive_replace_rollback() noexcept
+{
+  const std::string log0{get_log_file_path()};
+  if (log_archive_rename(get_log_file_path(LOG_ARCHIVE_ORIGINAL), log0))
+    sql_print_information("InnoDB: Restored the original %s", log0.c_str());
+}
+
+void log_archive_restored() noexcept
+{
+  if (srv_log_archive_recovery_lsn && !srv_read_only_mode)
+    os_file_delete_if_exists_func(get_log_file_path(LOG_ARCHIVE_ORIGINAL)
+                                  .c_str(), nullptr);
+}
@@ -109,6 +109,7 @@ void log_t::create() noexcept
 #endif
 
   last_checkpoint_lsn= FIRST_LSN;
+  archived_lsn= 0;
   log_capacity= 0;
   max_modified_age_async= 0;
   max_checkpoint_age= 0;
@@ -36,6 +36,7 @@ Created 9/20/1997 Heikki Tuuri
 #include <my_aes.h>
 #endif
 
+#include "log0arch.h"
 #include "log0crypt.h"
 #include "mem0mem.h"
 #include "buf0buf.h"
@@ -2438,6 +2439,45 @@ recv_sys_t::parse_mtr_result log_parse_start(source &l, unsigned nonce)
   return crc32c == stored_crc32c ? recv_sys_t::OK : recv_sys_t::GOT_EOF;
 }
 
+size_t log_mtr_length(const byte *begin, const byte *end, bool encrypted)
+  noexcept
+{
+  const byte *l= begin;
+
+  if (l == end || *l <= 1)
+    return 0;
+
+  do
+  {
+    if (size_t(l - begin) >= recv_sys_t::MTR_SIZE_MAX)
+      return 0;
+    uint32_t rlen= *l++ & 0xf;
+    if (!rlen)
+    {
+      if (l == end || uint32_t(end - l) < mlog_decode_varint_length(*l))
+        return 0;
+      const uint32_t addlen= mlog_decode_varint(l);
+      if (addlen >= recv_sys_t::MTR_SIZE_MAX)
+        return 0;
+      rlen= addlen + 15;
+    }
+    if (size_t(end - l) <= rlen)
+      return 0;
+    l+= rlen;
+  }
+  while (*l > 1);
+
+  const size_t nonce= encrypted ? 8 : 0;
+  if (size_t(end - l) < 5 + nonce)
+    return 0;
+  uint32_t crc32c= my_crc32c(0, begin, size_t(l - begin));
+  if (nonce)
+    crc32c= my_crc32c(crc32c, l + 1, nonce);
+  if (crc32c != mach_read_from_4(l + 1 + nonce))
+    return 0;
+  return size_t(l - begin) + 5 + nonce;
+}
+
 /** Parse and register one log_t::FORMAT_10_8 mini-transaction.
 @tparam source    type of log data source
 @tparam storing   whether to store the records
@@ -4696,6 +4736,31 @@ dberr_t recv_recovery_read_checkpoint()
 
   log_sys.latch.wr_lock(SRW_LOCK_CALL);
   dberr_t err= recv_sys.find_checkpoint();
+  if (err == DB_SUCCESS && srv_log_archive_recovery_lsn &&
+      srv_operation == SRV_OPERATION_NORMAL && !srv_read_only_mode &&
+      log_sys.is_latest())
+  {
+    /* Replace ib_logfile0 with the log archive, starting from the
+    checkpoint of a restored backup. */
+    err= log_archive_restore();
+    if (err == DB_SUCCESS)
+    {
+      log_sys.close_file();
+      recv_sys.close_files();
+      err= log_archive_replace();
+      if (err == DB_SUCCESS)
+      {
+        err= recv_sys.find_checkpoint();
+        DBUG_EXECUTE_IF("log_archive_replace_fail", err= DB_ERROR;);
+        if (err != DB_SUCCESS)
+        {
+          log_sys.close_file();
+          recv_sys.close_files();
+          log_archive_replace_rollback();
+        }
+      }
+    }
+  }
   log_sys.latch.wr_unlock();
   return err;
 }
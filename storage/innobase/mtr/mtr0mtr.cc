@@ -134,7 +134,7 @@ inline buf_page_t *buf_pool_t::prepare_insert_into_flush_list(lsn_t lsn)
         break;
       prev= next;
     }
-    flush_hp.adjust(prev);
+    flush_hp_adjust(prev);
   }
   return prev;
 }
@@ -158,7 +158,7 @@ inline void buf_pool_t::insert_into_flush_list(buf_page_t *prev,
   {
     if (old > 1)
       return;
-    flush_hp.adjust(&block->page);
+    flush_hp_adjust(&block->page);
     UT_LIST_REMOVE(flush_list, &block->page);
   }
   else
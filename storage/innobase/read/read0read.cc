@@ -172,23 +172,86 @@ For details see: row_undo_mod_sec_is_unsafe() and row_purge_poss_sec()
 */
 inline void ReadViewBase::snapshot(trx_t *trx)
 {
-  trx_sys.snapshot_ids(trx, &m_ids, &m_low_limit_id, &m_low_limit_no);
-  if (m_ids.empty())
+  ReadViewSnapshot *s= trx_sys.snapshot_ids(trx);
+  release_snapshot();
+  m_ids.clear();
+  m_low_limit_id= s->max_trx_id;
+  m_low_limit_no= s->min_trx_no;
+
+  if (s->ids.empty())
   {
+    s->release();
     m_up_limit_id= m_low_limit_id;
     return;
   }
 
-  std::sort(m_ids.begin(), m_ids.end());
-  m_up_limit_id= m_ids.front();
+  m_up_limit_id= s->ids.front();
   ut_ad(m_up_limit_id <= m_low_limit_id);
 
   if (m_low_limit_no == m_low_limit_id &&
-      m_low_limit_id == m_up_limit_id + m_ids.size())
+      m_low_limit_id == m_up_limit_id + s->ids.size())
   {
-    m_ids.clear();
+    s->release();
     m_low_limit_id= m_low_limit_no= m_up_limit_id;
+    return;
   }
+
+  m_snapshot= s;
+}
+
+
+/**
+  Create and publish a snapshot of rw_trx_hash.
+
+  The snapshot is built in a ReadViewSnapshot object that no read view
+  refers to, or in a new one. It replaces the published one even if
+  another thread concurrently published a newer snapshot; snapshot_ids()
+  will not use a snapshot that does not match the current state.
+
+  @param caller_trx  used to get access to rw_trx_hash_pins
+  @param max_trx_id  get_max_trx_id() == get_rw_trx_hash_version()
+  @param epoch       m_rw_trx_hash_epoch before max_trx_id was loaded
+  @return the snapshot, to be released by ReadViewSnapshot::release()
+*/
+ReadViewSnapshot *trx_sys_t::create_snapshot(trx_t *caller_trx,
+                                             trx_id_t max_trx_id,
+                                             uint64_t epoch)
+{
+  ReadViewSnapshot *s= m_snapshots.load(std::memory_order_acquire);
+  for (; s; s= s->next)
+  {
+    uint32_t unused= 0;
+    if (s->ref_count.compare_exchange_strong(unused, 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed))
+      break;
+  }
+
+  if (!s)
+  {
+    s= UT_NEW_NOKEY(ReadViewSnapshot());
+    s->ref_count.store(1, std::memory_order_relaxed);
+    s->next= m_snapshots.load(std::memory_order_relaxed);
+    while (!m_snapshots.compare_exchange_weak(s->next, s,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+  }
+
+  snapshot_ids_arg arg(&s->ids);
+  arg.m_id= arg.m_no= max_trx_id;
+  s->ids.clear();
+  s->ids.reserve(rw_trx_hash.size() + 32);
+  rw_trx_hash.iterate(caller_trx, copy_one_id, &arg);
+  std::sort(s->ids.begin(), s->ids.end());
+  s->max_trx_id= max_trx_id;
+  s->epoch= epoch;
+  s->min_trx_no= arg.m_no;
+
+  /* One reference for the caller, another for m_snapshot */
+  s->ref_count.fetch_add(1, std::memory_order_relaxed);
+  if (ReadViewSnapshot *old= m_snapshot.exchange(s, std::memory_order_acq_rel))
+    old->release();
+  return s;
 }
 
 
@@ -3465,6 +3465,9 @@ row_ins_index_entry(
 	if (index->is_primary()) {
 		return row_ins_clust_index_entry(index, entry, thr, 0);
 	} else {
+		/* We do not care about the race condition here.
+		Updates are counted in row_upd_sec_index_entry(). */
+		index->stat_modified_counter++;
 		return row_ins_sec_index_entry(index, entry, thr);
 	}
 }
@@ -27,6 +27,7 @@ Completed by Sunny Bains and Marko Makela
 #include <my_global.h>
 #include <log.h>
 #include <sql_class.h>
+#include <debug_sync.h>
 #include <math.h>
 
 #include "row0merge.h"
@@ -46,6 +47,7 @@ Completed by Sunny Bains and Marko Makela
 #include "row0vers.h"
 #include "handler0alter.h"
 #include "btr0bulk.h"
+#include "row0pread.h"
 #ifdef BTR_CUR_ADAPT
 # include "btr0sea.h"
 #endif /* BTR_CUR_ADAPT */
@@ -3062,6 +3064,464 @@ row_merge_read_clustered_index(
 	DBUG_RETURN(err);
 }
 
+/** State of a clustered index scan that is divided between threads */
+struct row_merge_scan_t
+{
+	/** reader of the clustered index */
+	row_pread_t*		reader;
+	/** MySQL table, for reporting duplicate keys */
+	struct TABLE*		table;
+	/** the table whose secondary indexes are being created */
+	dict_table_t*		old_table;
+	/** temporary files, one per index */
+	merge_file_t*		files;
+	/** MySQL key numbers */
+	const ulint*		key_numbers;
+	/** number of indexes */
+	ulint			n_index;
+	/** temporary file handle for row_merge_file_create_if_needed() */
+	pfs_os_file_t*		tmpfd;
+	/** location for temporary files */
+	const char*		path;
+	/** columns whose collations changed, or nullptr */
+	const col_collations*	col_collate;
+	/** number of rows read so far */
+	Atomic_counter<ulint>	n_rows;
+	/** estimated number of rows in the table */
+	ib_uint64_t		table_total_rows;
+	/** percent of the ALTER TABLE cost for the scan */
+	double			pct_cost;
+	/** protects files[] and *tmpfd */
+	srw_mutex		mutex;
+	/** trx->error_key_num for the first error */
+	ulint			error_key_num;
+
+	/** Note that a thread failed.
+	@param error		error code
+	@param key_num		value for trx->error_key_num
+	@return whether this was the first error */
+	bool report(dberr_t error, ulint key_num)
+	{
+		if (!reader->report(error)) {
+			return(false);
+		}
+		error_key_num = key_num;
+		return(true);
+	}
+};
+
+/** A thread of a clustered index scan */
+struct row_merge_scan_thread_t : public row_pread_t::worker
+{
+	/** the scan */
+	row_merge_scan_t*	scan = nullptr;
+	/** the performance schema stage, in the thread of the ALTER TABLE */
+	ut_stage_alter_t*	stage = nullptr;
+	/** sort buffers, one per index */
+	row_merge_buf_t**	merge_buf = nullptr;
+	/** buffer for writing a block */
+	row_merge_block_t*	block = nullptr;
+	ut_new_pfx_t		block_pfx;
+	/** buffer for encrypting a block, or NULL */
+	row_merge_block_t*	crypt_block = nullptr;
+	ut_new_pfx_t		crypt_pfx;
+	/** memory heap for the rows */
+	mem_heap_t*		row_heap = nullptr;
+	/** memory heap for virtual column values, or NULL */
+	mem_heap_t*		v_heap = nullptr;
+	/** number of rows that were not yet added to scan->n_rows */
+	ulint			n_rows = 0;
+
+	/** Add a clustered index record to the sort buffers.
+	@param[in]	rec	clustered index record
+	@param[in]	offsets	rec_get_offsets(rec)
+	@return DB_SUCCESS or error code */
+	dberr_t process(const rec_t* rec, rec_offs* offsets) override;
+
+	void page_done() override
+	{
+		if (stage) {
+			stage->inc();
+		}
+	}
+
+	/** Write out what is left in the sort buffers.
+	@return DB_SUCCESS or error code */
+	dberr_t finish() override;
+
+	/** Sort a full buffer and write it to the temporary file
+	of the index.
+	@param[in]	i	index number
+	@return DB_SUCCESS or error code */
+	dberr_t write(ulint i);
+};
+
+dberr_t
+row_merge_scan_thread_t::write(
+	ulint	i)
+{
+	row_merge_buf_t*	buf = merge_buf[i];
+	merge_file_t*		file = &scan->files[i];
+
+	ut_ad(buf->n_tuples);
+
+	if (dict_index_is_unique(buf->index)) {
+		/* Do not write table->record[0] before we know that
+		no other thread is doing that. */
+		row_merge_dup_t	dup = {buf->index, scan->reader->trx,
+				       NULL, NULL, 0};
+
+		row_merge_buf_sort(buf, &dup);
+
+		if (dup.n_dup) {
+			if (scan->report(DB_DUPLICATE_KEY,
+					 scan->key_numbers[i])) {
+				/* Sort again to report the duplicate. */
+				dup.table = scan->table;
+				dup.n_dup = 0;
+				row_merge_buf_sort(buf, &dup);
+				ut_ad(dup.n_dup);
+			}
+			return(DB_DUPLICATE_KEY);
+		}
+	} else {
+		row_merge_buf_sort(buf, NULL);
+	}
+
+	/* Reserve a block in the file. The threads write their
+	blocks in any order, and row_merge_sort() will merge them
+	like the blocks of a single thread. */
+	scan->mutex.wr_lock();
+
+	if (!row_merge_file_create_if_needed(file, scan->tmpfd, 0,
+					     scan->path)) {
+		scan->mutex.wr_unlock();
+		return(DB_OUT_OF_MEMORY);
+	}
+
+	merge_file_t	of = *file;
+	file->offset++;
+	file->n_rec += buf->n_tuples;
+	scan->mutex.wr_unlock();
+
+	row_merge_buf_write(buf,
+#ifndef DBUG_OFF
+			    &of,
+#endif
+			    block);
+
+	if (!row_merge_write(of.fd, of.offset, block, crypt_block,
+			     scan->old_table->space_id)) {
+		return(DB_TEMP_FILE_WRITE_FAIL);
+	}
+
+	MEM_UNDEFINED(&block[0], srv_sort_buf_size);
+	merge_buf[i] = row_merge_buf_empty(buf);
+	return(DB_SUCCESS);
+}
+
+dberr_t
+row_merge_scan_thread_t::process(
+	const rec_t*	rec,
+	rec_offs*	offsets)
+{
+	dict_table_t*	table = scan->old_table;
+	trx_t*		trx = scan->reader->trx;
+	dberr_t		err = DB_SUCCESS;
+	ulint		i;
+
+	if (stage) {
+		stage->n_pk_recs_inc();
+	}
+
+	mem_heap_empty(row_heap);
+
+	ut_ad(!rec_offs_any_null_extern(rec, offsets));
+
+	row_ext_t*	ext;
+	dtuple_t*	row = row_build(
+		ROW_COPY_POINTERS, scan->reader->index, rec, offsets, table,
+		NULL, NULL, &ext, row_heap);
+
+	for (i = 0; i < scan->n_index; i++) {
+		doc_id_t	doc_id = 0;
+
+		if (row_merge_buf_add(merge_buf[i], NULL, table, table, NULL,
+				      row, ext, &doc_id, NULL, &err, &v_heap,
+				      NULL, trx, scan->col_collate)) {
+			if (err != DB_SUCCESS) {
+				ut_ad(err == DB_TOO_BIG_RECORD);
+				break;
+			}
+			continue;
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		/* The buffer is full. Write it out and try again. */
+		err = write(i);
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+
+		if (!row_merge_buf_add(merge_buf[i], NULL, table, table, NULL,
+				       row, ext, &doc_id, NULL, &err, &v_heap,
+				       NULL, trx, scan->col_collate)) {
+			/* An empty buffer should have enough
+			room for at least one record. */
+			ut_ad(err == DB_OUT_OF_MEMORY
+			      || err == DB_TOO_BIG_RECORD);
+			if (err == DB_SUCCESS) {
+				err = DB_TOO_BIG_RECORD;
+			}
+		}
+
+		if (err != DB_SUCCESS) {
+			break;
+		}
+	}
+
+	if (v_heap) {
+		mem_heap_empty(v_heap);
+	}
+
+	if (err == DB_DUPLICATE_KEY) {
+		/* write() reported it. */
+		return(err);
+	} else if (err != DB_SUCCESS) {
+		scan->report(err, i);
+		return(err);
+	}
+
+	/* Update innodb_onlineddl_pct_progress for each 1000 rows */
+	if (++n_rows == 1000) {
+		const ulint	read_rows = scan->n_rows += n_rows;
+
+		n_rows = 0;
+
+		if (is_caller()) {
+			const double	curr_progress
+				= read_rows >= scan->table_total_rows
+				? scan->pct_cost
+				: scan->pct_cost
+				* static_cast<double>(read_rows)
+				/ static_cast<double>(scan->table_total_rows);
+			/* presenting 10.12% as 1012 integer */
+			onlineddl_pct_progress = ulint(curr_progress * 100);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
+dberr_t
+row_merge_scan_thread_t::finish()
+{
+	scan->n_rows += n_rows;
+	n_rows = 0;
+
+	for (ulint i = 0; i < scan->n_index; i++) {
+		if (scan->reader->is_aborted()) {
+			break;
+		}
+
+		if (!merge_buf[i]->n_tuples) {
+			continue;
+		}
+
+		dberr_t	err = write(i);
+
+		if (err == DB_DUPLICATE_KEY) {
+			/* write() reported it. */
+			return(err);
+		} else if (err != DB_SUCCESS) {
+			scan->report(err, i);
+			return(err);
+		}
+	}
+
+	return(DB_SUCCESS);
+}
+
+/** Read the clustered index of the table with several threads, and create
+temporary files containing the index entries for the secondary indexes to
+be built. Each thread scans key ranges of the clustered index into sort
+buffers of its own, and the sorted buffers of all threads are written as
+blocks into one temporary file per index.
+This handles only what row_merge_read_clustered_index() does when the table
+is not being rebuilt, and there are no FULLTEXT or SPATIAL indexes or
+virtual columns among the indexes.
+@param[in]	trx		transaction
+@param[in,out]	table		MySQL table object, for reporting duplicate
+				keys
+@param[in]	old_table	table whose indexes are being created
+@param[in]	online		true if creating indexes online
+@param[in]	index		indexes to be created
+@param[in]	files		temporary files
+@param[in]	key_numbers	MySQL key numbers to create
+@param[in]	n_index		number of indexes to create
+@param[in,out]	tmpfd		temporary file handle
+@param[in,out]	stage		performance schema accounting object
+@param[in]	pct_cost	percent of task weight out of total alter job
+@param[in]	col_collate	columns whose collations changed, or nullptr
+@param[in]	n_threads	number of threads
+@return DB_SUCCESS or error */
+static MY_ATTRIBUTE((warn_unused_result))
+dberr_t
+row_merge_read_clustered_index_parallel(
+	trx_t*			trx,
+	struct TABLE*		table,
+	dict_table_t*		old_table,
+	bool			online,
+	dict_index_t**		index,
+	merge_file_t*		files,
+	const ulint*		key_numbers,
+	ulint			n_index,
+	pfs_os_file_t*		tmpfd,
+	ut_stage_alter_t*	stage,
+	double			pct_cost,
+	const col_collations*	col_collate,
+	ulint			n_threads)
+{
+	/* Like row_merge_read_clustered_index(), perform a
+	REPEATABLE READ when creating the indexes online. */
+	row_pread_t		reader(trx, dict_table_get_first_index(
+					       old_table), online);
+	row_merge_scan_t	scan;
+	bool			empty;
+	dberr_t			err;
+
+	DBUG_ENTER("row_merge_read_clustered_index_parallel");
+
+	ut_ad(trx_state_eq(trx, TRX_STATE_ACTIVE));
+	ut_ad(trx->mysql_thd != NULL);
+	ut_ad(n_threads > 1);
+
+	trx->op_info = "reading clustered index";
+
+	scan.reader = &reader;
+	scan.table = table;
+	scan.old_table = old_table;
+	scan.files = files;
+	scan.key_numbers = key_numbers;
+	scan.n_index = n_index;
+	scan.tmpfd = tmpfd;
+	scan.path = thd_innodb_tmpdir(trx->mysql_thd);
+	scan.col_collate = col_collate;
+	scan.table_total_rows = std::max<ib_uint64_t>(
+		dict_table_get_n_rows(old_table), 1);
+	scan.pct_cost = pct_cost;
+	scan.mutex.init();
+	scan.error_key_num = 0;
+
+	err = reader.split(n_threads, &empty);
+
+	if (err != DB_SUCCESS || empty) {
+		trx->error_key_num = 0;
+		goto func_exit;
+	}
+
+	{
+		const ulint	n_thr = std::min(n_threads, reader.n_ranges());
+		ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+		row_merge_scan_thread_t*	thr = UT_NEW_ARRAY_NOKEY(
+			row_merge_scan_thread_t, n_thr);
+		row_pread_t::worker**		workers
+			= static_cast<row_pread_t::worker**>(
+				ut_malloc_nokey(n_thr * sizeof *workers));
+
+		for (ulint t = 0; t < n_thr; t++) {
+			workers[t] = &thr[t];
+			thr[t].scan = &scan;
+			thr[t].row_heap = mem_heap_create(sizeof(mrec_buf_t));
+			thr[t].merge_buf = static_cast<row_merge_buf_t**>(
+				ut_malloc_nokey(n_index
+						* sizeof *thr[t].merge_buf));
+			for (ulint i = 0; i < n_index; i++) {
+				thr[t].merge_buf[i]
+					= row_merge_buf_create(index[i]);
+			}
+
+			thr[t].block = alloc.allocate_large(
+				srv_sort_buf_size, &thr[t].block_pfx);
+
+			if (srv_encrypt_log && thr[t].block) {
+				thr[t].crypt_block = alloc.allocate_large(
+					srv_sort_buf_size, &thr[t].crypt_pfx);
+			}
+
+			if (!thr[t].block
+			    || (srv_encrypt_log && !thr[t].crypt_block)) {
+				err = DB_OUT_OF_MEMORY;
+			}
+		}
+
+		if (err == DB_SUCCESS) {
+			/* This thread works too, and accounts for
+			the progress of the scan. */
+			thr[0].stage = stage;
+
+			err = reader.run(workers, n_thr);
+
+			if (err != DB_SUCCESS) {
+				trx->error_key_num = scan.error_key_num;
+			}
+		} else {
+			trx->error_key_num = 0;
+		}
+
+		for (ulint t = 0; t < n_thr; t++) {
+			for (ulint i = 0; i < n_index; i++) {
+				row_merge_buf_free(thr[t].merge_buf[i]);
+			}
+			ut_free(thr[t].merge_buf);
+			if (thr[t].block) {
+				alloc.deallocate_large(thr[t].block,
+						       &thr[t].block_pfx);
+			}
+			if (thr[t].crypt_block) {
+				alloc.deallocate_large(thr[t].crypt_block,
+						       &thr[t].crypt_pfx);
+			}
+			mem_heap_free(thr[t].row_heap);
+			if (thr[t].v_heap) {
+				mem_heap_free(thr[t].v_heap);
+			}
+		}
+
+		ut_free(workers);
+		UT_DELETE_ARRAY(thr);
+	}
+
+	if (err == DB_SUCCESS && online) {
+		/* Note the newest transaction that modified each index
+		when the scan was completed. We prevent older readers
+		from accessing the indexes, to ensure read consistency. */
+		for (ulint i = 0; i < n_index; i++) {
+			index[i]->lock.x_lock(SRW_LOCK_CALL);
+			ut_a(dict_index_get_online_status(index[i])
+			     == ONLINE_INDEX_CREATION);
+
+			trx_id_t max_trx_id = row_log_get_max_trx(index[i]);
+
+			if (max_trx_id > index[i]->trx_id) {
+				index[i]->trx_id = max_trx_id;
+			}
+
+			index[i]->lock.x_unlock();
+		}
+	}
+
+func_exit:
+	scan.mutex.destroy();
+	trx->op_info = "";
+
+	DBUG_RETURN(err);
+}
+
 /** Write a record via buffer 2 and read the next record to buffer N.
 @param N number of the buffer (0 or 1)
 @param INDEX record descriptor
@@ -4574,6 +5034,112 @@ row_merge_is_index_usable(
 		   || trx->read_view.changes_visible(index->trx_id)));
 }
 
+/** Merge sort and load of a secondary index in a thread of its own */
+struct row_merge_load_t
+{
+	/** transaction */
+	trx_t*			trx;
+	/** index to load */
+	dict_index_t*		index;
+	/** table where rows are read from */
+	const dict_table_t*	old_table;
+	/** temporary file containing the index entries */
+	merge_file_t*		file;
+	/** location for temporary files */
+	const char*		path;
+	/** total progress percent until the scan ended */
+	double			pct_progress;
+	/** progress percent of loading the index */
+	double			pct_cost;
+	/** the result */
+	dberr_t			err;
+	/** the task, or NULL if this thread loads the index */
+	tpool::waitable_task*	task;
+#ifdef ENABLED_DEBUG_SYNC
+	/** whether the task stops at a debug sync point */
+	bool			debug_sync;
+#endif
+};
+
+/** Sort the temporary file of an index and load the index from it.
+@param[in,out]	arg	row_merge_load_t */
+static
+void
+row_merge_load_index(
+	void*	arg)
+{
+	row_merge_load_t*	load = static_cast<row_merge_load_t*>(arg);
+	ut_allocator<row_merge_block_t>	alloc(mem_key_row_merge_sort);
+	const size_t		block_size = 3 * srv_sort_buf_size;
+	ut_new_pfx_t		block_pfx;
+	ut_new_pfx_t		crypt_pfx;
+	row_merge_block_t*	crypt_block = NULL;
+	pfs_os_file_t		tmpfd = OS_FILE_CLOSED;
+	const ulint		space = load->index->table->space_id;
+	row_merge_block_t*	block = alloc.allocate_large(
+		block_size, &block_pfx);
+
+	if (block == NULL) {
+		load->err = DB_OUT_OF_MEMORY;
+		return;
+	}
+
+#ifdef ENABLED_DEBUG_SYNC
+	/* The thread of the ALTER TABLE is only waiting for the tasks. */
+	if (load->debug_sync) {
+		debug_sync_set_action(load->trx->mysql_thd, STRING_WITH_LEN(
+			"now SIGNAL load_started WAIT_FOR load_resume"));
+	}
+#endif
+
+	if (srv_encrypt_log) {
+		crypt_block = alloc.allocate_large(block_size, &crypt_pfx);
+
+		if (crypt_block == NULL) {
+			load->err = DB_OUT_OF_MEMORY;
+			goto func_exit;
+		}
+	}
+
+	/* Each thread merges into a temporary file of its own. */
+	if (!row_merge_tmpfile_if_needed(&tmpfd, load->path)) {
+		load->err = DB_OUT_OF_MEMORY;
+		goto func_exit;
+	}
+
+	{
+		/* A non-unique index can not have duplicates,
+		so table->record[0] is not needed. */
+		row_merge_dup_t	dup = {load->index, load->trx, NULL, NULL, 0};
+
+		load->err = row_merge_sort(
+			load->trx, &dup, load->file, block, &tmpfd, false,
+			0, 0, crypt_block, space, NULL);
+	}
+
+	if (load->err == DB_SUCCESS) {
+		/* Other tasks use the same transaction, so the
+		mini-transactions must not update its statistics. */
+		BtrBulk	btr_bulk(load->index, load->trx, false);
+
+		load->err = row_merge_insert_index_tuples(
+			load->trx, load->index, load->old_table,
+			load->file->fd, block, NULL, &btr_bulk,
+			load->file->n_rec, load->pct_progress,
+			load->pct_cost, crypt_block, space);
+
+		load->err = btr_bulk.finish(load->err);
+	}
+
+func_exit:
+	row_merge_file_destroy_low(tmpfd);
+	alloc.deallocate_large(block, &block_pfx);
+
+	if (crypt_block) {
+		alloc.deallocate_large(crypt_block, &crypt_pfx);
+	}
+}
+
 /** Build indexes on a table by reading a clustered index, creating a temporary
 file containing index entries, merge sorting these index entries and inserting
 sorted index entries to indexes.
@@ -4639,6 +5205,10 @@ row_merge_build_indexes(
 	fts_psort_t*		psort_info = NULL;
 	fts_psort_t*		merge_info = NULL;
 	bool			fts_psort_initiated = false;
+	const ulint		n_threads = thd_ddl_threads(trx->mysql_thd);
+	bool			parallel_scan;
+	row_merge_load_t*	loads = NULL;
+	tpool::task_group*	load_group = NULL;
 
 	double total_static_cost = 0;
 	double total_dynamic_cost = 0;
@@ -4762,15 +5332,32 @@ row_merge_build_indexes(
 		goto func_exit;
 	}
 
+	/* Only plain secondary indexes can be built from a clustered
+	index scan by several threads. */
+	parallel_scan = n_threads > 1 && old_table == new_table
+		&& !fts_sort_idx && !add_v;
+
+	for (i = 0; parallel_scan && i < n_indexes; i++) {
+		parallel_scan = !indexes[i]->is_spatial()
+			&& !indexes[i]->has_virtual();
+	}
+
 	/* Read clustered index of the table and create files for
 	secondary index entries for merge sort */
-	error = row_merge_read_clustered_index(
-		trx, table, old_table, new_table, online, indexes,
-		fts_sort_idx, psort_info, merge_files, key_numbers,
-		n_indexes, defaults, add_v, col_map, add_autoinc,
-		sequence, block, skip_pk_sort, &tmpfd, stage,
-		pct_cost, crypt_block, eval_table, allow_not_null,
-		col_collate);
+	if (parallel_scan) {
+		error = row_merge_read_clustered_index_parallel(
+			trx, table, old_table, online, indexes,
+			merge_files, key_numbers, n_indexes, &tmpfd, stage,
+			pct_cost, col_collate, n_threads);
+	} else {
+		error = row_merge_read_clustered_index(
+			trx, table, old_table, new_table, online, indexes,
+			fts_sort_idx, psort_info, merge_files, key_numbers,
+			n_indexes, defaults, add_v, col_map, add_autoinc,
+			sequence, block, skip_pk_sort, &tmpfd, stage,
+			pct_cost, crypt_block, eval_table, allow_not_null,
+			col_collate);
+	}
 
 	stage->end_phase_read_pk();
 
@@ -4792,6 +5379,58 @@ row_merge_build_indexes(
 
 	DEBUG_SYNC_C("row_merge_after_scan");
 
+	if (n_threads > 1) {
+		/* Sort and load the non-unique secondary indexes in
+		other threads. Unique indexes are sorted and loaded below,
+		because a duplicate key is reported in table->record[0]. */
+		loads = static_cast<row_merge_load_t*>(
+			ut_zalloc_nokey(n_merge_files * sizeof *loads));
+		load_group = UT_NEW_NOKEY(
+			tpool::task_group(unsigned(n_threads)));
+#ifdef ENABLED_DEBUG_SYNC
+		bool	debug_sync = false;
+		DBUG_EXECUTE_IF("row_merge_load_index_sync",
+				debug_sync = true;);
+#endif
+
+		for (ulint k = 0, i = 0; i < n_indexes; i++) {
+			if (dict_index_is_spatial(indexes[i])) {
+				continue;
+			}
+
+			merge_file_t*	file = &merge_files[k];
+			row_merge_load_t&	load = loads[k++];
+
+			if ((indexes[i]->type & (DICT_FTS | DICT_UNIQUE))
+			    || file->fd == OS_FILE_CLOSED) {
+				continue;
+			}
+
+			load.trx = trx;
+			load.index = indexes[i];
+			load.old_table = old_table;
+			load.file = file;
+			load.path = thd_innodb_tmpdir(trx->mysql_thd);
+			load.pct_progress = pct_progress;
+			load.pct_cost = (COST_BUILD_INDEX_STATIC +
+					 (total_dynamic_cost
+					  * static_cast<double>(file->offset)
+					  / static_cast<double>(
+						  total_index_blocks)))
+				/ (total_static_cost + total_dynamic_cost)
+				* PCT_COST_INSERT_INDEX * 100;
+			load.err = DB_SUCCESS;
+#ifdef ENABLED_DEBUG_SYNC
+			/* Only one task may use the THD of this thread. */
+			load.debug_sync = debug_sync;
+			debug_sync = false;
+#endif
+			load.task = new tpool::waitable_task(
+				row_merge_load_index, &load, load_group);
+			srv_thread_pool->submit_task(load.task);
+		}
+	}
+
 	/* Now we have files containing index entries ready for
 	sorting and inserting. */
 
@@ -4823,6 +5462,13 @@ row_merge_build_indexes(
 #ifdef FTS_INTERNAL_DIAG_PRINT
 			DEBUG_FTS_SORT_PRINT("FTS_SORT: Complete Insert\n");
 #endif
+		} else if (loads && loads[k].task) {
+			/* Another thread sorted and loaded the index. */
+			loads[k].task->wait();
+			delete loads[k].task;
+			loads[k].task = NULL;
+			error = loads[k].err;
+			pct_progress += loads[k].pct_cost;
 		} else if (merge_files[k].fd != OS_FILE_CLOSED) {
 			char	buf[NAME_LEN + 1];
 			row_merge_dup_t	dup = {
@@ -4957,6 +5603,19 @@ row_merge_build_indexes(
 	}
 
 func_exit:
+	if (load_group) {
+		/* Wait for the loads that we did not wait for
+		because of an error. */
+		for (i = 0; i < n_merge_files; i++) {
+			if (loads[i].task) {
+				loads[i].task->wait();
+				delete loads[i].task;
+			}
+		}
+
+		ut_free(loads);
+		UT_DELETE(load_group);
+	}
 
 	DBUG_EXECUTE_IF(
 		"ib_build_indexes_too_many_concurrent_trxs",
@@ -917,6 +917,7 @@ row_create_prebuilt(
 	prebuilt->fts_doc_id = 0;
 
 	prebuilt->mysql_row_len = mysql_row_len;
+	prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 	prebuilt->fts_doc_id_in_read_set = 0;
 	prebuilt->blob_heap = NULL;
@@ -964,7 +965,7 @@ void row_prebuilt_free(row_prebuilt_t *prebuilt)
 		byte*	base = prebuilt->fetch_cache[0] - 4;
 		byte*	ptr = base;
 
-		for (ulint i = 0; i < MYSQL_FETCH_CACHE_SIZE; i++) {
+		for (ulint i = 0; i < prebuilt->fetch_cache_size; i++) {
 			ulint	magic1 = mach_read_from_4(ptr);
 			ut_a(magic1 == ROW_PREBUILT_FETCH_MAGIC_N);
 			ptr += 4;
@@ -0,0 +1,363 @@
+/*****************************************************************************
+
+Copyright (c) 2026, MariaDB Corporation.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; version 2 of the License.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1335 USA
+
+*****************************************************************************/
+
+/**************************************************//**
+@file row/row0pread.cc
+Reading a clustered index with several threads
+*******************************************************/
+
+#include "row0pread.h"
+#include "btr0btr.h"
+#include "btr0pcur.h"
+#include "row0row.h"
+#include "row0vers.h"
+#include "srv0srv.h"
+#include "trx0sys.h"
+
+row_pread_t::row_pread_t(trx_t *trx, dict_index_t *index, bool consistent) :
+  trx(trx), index(index), view(consistent ? &trx->read_view : nullptr),
+  heap(mem_heap_create(1024)), next_range(0), aborted(false),
+  err(DB_SUCCESS)
+{
+  ut_ad(index->is_primary());
+  ut_ad(!consistent || trx->read_view.is_open());
+  mutex.init();
+}
+
+row_pread_t::~row_pread_t()
+{
+  mutex.destroy();
+  mem_heap_free(heap);
+}
+
+void row_pread_t::add_bounds(const buf_block_t *block, ulint step)
+{
+  const page_t *page= block->page.frame;
+  const bool comp= page_is_comp(page);
+  const ulint n_uniq= dict_index_get_n_unique(index);
+  ulint n= 0;
+
+  for (const rec_t *rec= page_rec_get_next_const(page_get_infimum_rec(page));
+       rec && !page_rec_is_supremum(rec);
+       rec= page_rec_get_next_const(rec))
+  {
+    /* The minimum record of the level is no bound. */
+    if ((rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG) || n++ % step)
+      continue;
+
+    dtuple_t *tuple= dtuple_create(heap, uint16_t(n_uniq));
+    dict_index_copy_types(tuple, index, n_uniq);
+    rec_copy_prefix_to_dtuple(tuple, rec, index, 0, n_uniq, heap);
+    tuple->info_bits= 0;
+    bounds.push_back(tuple);
+  }
+}
+
+dberr_t row_pread_t::split(ulint n_threads, bool *empty)
+{
+  /* Enough key ranges for balancing the load between the threads,
+  but not so many that positioning the cursors would matter. */
+  const ulint n_max= 16 * n_threads;
+  mtr_t mtr{trx};
+  dberr_t err;
+
+  *empty= false;
+  bounds.clear();
+  next_range= 0;
+
+  mtr.start();
+  /* Prevent changes of the non-leaf pages. */
+  mtr_s_lock_index(index, &mtr);
+
+  const buf_block_t *root= btr_root_block_get(index, RW_S_LATCH, &mtr, &err);
+  if (!root)
+    goto func_exit;
+
+  /* A table that was empty when a transaction started inserting
+  into it may only contain records of that transaction. An INSERT
+  into an empty table would have to latch the root page. */
+  if (!view);
+  else if (const trx_id_t bulk_trx_id= index->table->bulk_trx_id)
+    if (!view->changes_visible(bulk_trx_id))
+    {
+      *empty= true;
+      goto func_exit;
+    }
+
+  if (!btr_page_get_level(root->page.frame))
+    /* There is only one page. */;
+  else if (page_get_n_recs(root->page.frame) >= 4 * n_threads ||
+           btr_page_get_level(root->page.frame) == 1)
+    add_bounds(root, 1 + page_get_n_recs(root->page.frame) / n_max);
+  else
+  {
+    const page_t *page= root->page.frame;
+    const ulint n_children= page_get_n_recs(page);
+    rec_offs *offsets= nullptr;
+    mem_heap_t *offsets_heap= nullptr;
+
+    for (const rec_t *rec= page_rec_get_next_const(page_get_infimum_rec(page));
+         rec && !page_rec_is_supremum(rec);
+         rec= page_rec_get_next_const(rec))
+    {
+      offsets= rec_get_offsets(rec, index, offsets, 0, ULINT_UNDEFINED,
+                               &offsets_heap);
+      const buf_block_t *child=
+        btr_block_get(*index, btr_node_ptr_get_child_page_no(rec, offsets),
+                      RW_S_LATCH, &mtr, &err);
+      if (!child)
+        break;
+      /* The first node pointer of every child but the leftmost one
+      is a bound, and more are taken evenly from the child. */
+      add_bounds(child, 1 + page_get_n_recs(child->page.frame) * n_children /
+                 n_max);
+      mtr.release_last_page();
+    }
+
+    if (offsets_heap)
+      mem_heap_free(offsets_heap);
+  }
+
+func_exit:
+  mtr.commit();
+  return err;
+}
+
+bool row_pread_t::report(dberr_t error)
+{
+  ut_ad(error != DB_SUCCESS);
+  mutex.wr_lock();
+  const bool first= err == DB_SUCCESS;
+  if (first)
+    err= error;
+  aborted.store(true, std::memory_order_relaxed);
+  mutex.wr_unlock();
+  return first;
+}
+
+dberr_t row_pread_t::read_range(worker *w, ulint range)
+{
+  const dtuple_t *low= range ? bounds[range - 1] : nullptr;
+  const dtuple_t *high= range < bounds.size() ? bounds[range] : nullptr;
+  const bool comp= index->table->not_redundant();
+  mem_heap_t *rec_heap= mem_heap_create(1024);
+  btr_pcur_t pcur;
+  /* The handler statistics of trx are not thread-safe. */
+  mtr_t mtr{w->is_caller() ? trx : nullptr};
+  dberr_t err;
+
+  mtr.start();
+
+  if (low)
+  {
+    /* Position on the last record before the range, so that
+    the loop below moves to the first record of the range. */
+    pcur.btr_cur.page_cur.index= index;
+    err= btr_pcur_open(low, PAGE_CUR_L, BTR_SEARCH_LEAF, &pcur, &mtr);
+  }
+  else
+    err= pcur.open_leaf(true, index, BTR_SEARCH_LEAF, &mtr);
+
+  while (err == DB_SUCCESS)
+  {
+    page_cur_t *cur= btr_pcur_get_page_cur(&pcur);
+
+    if (!page_cur_move_to_next(cur))
+    {
+      err= DB_CORRUPTION;
+      break;
+    }
+
+    if (page_cur_is_after_last(cur))
+    {
+      w->page_done();
+      if (is_aborted())
+        break;
+      if (UNIV_UNLIKELY(trx_is_interrupted(trx)))
+      {
+        err= DB_INTERRUPTED;
+        break;
+      }
+      if (!index->table->is_readable())
+      {
+        err= DB_DECRYPTION_FAILED;
+        break;
+      }
+      if (btr_pcur_is_after_last_in_tree(&pcur))
+      {
+        w->range_done();
+        break;
+      }
+      err= btr_pcur_move_to_next_page(&pcur, &mtr);
+      continue;
+    }
+
+    mem_heap_empty(rec_heap);
+
+    const rec_t *rec= page_cur_get_rec(cur);
+
+    if (rec_get_info_bits(rec, comp) & REC_INFO_MIN_REC_FLAG)
+    {
+      /* Skip the metadata pseudo-record. */
+      if (low || !index->is_instant())
+        err= DB_CORRUPTION;
+      continue;
+    }
+
+    rec_offs *offsets= rec_get_offsets(rec, index, nullptr,
+                                       index->n_core_fields,
+                                       ULINT_UNDEFINED, &rec_heap);
+
+    if (high && cmp_dtuple_rec(high, rec, index, offsets) <= 0)
+    {
+      /* The rest belongs to the next key range. */
+      w->range_done();
+      break;
+    }
+
+    if (view)
+    {
+      const trx_id_t rec_trx_id= row_get_rec_trx_id(rec, index, offsets);
+
+      if (!view->changes_visible(rec_trx_id))
+      {
+        if (rec_trx_id >= view->low_limit_id() &&
+            rec_trx_id >= trx_sys.get_max_trx_id())
+        {
+          err= DB_CORRUPTION;
+          break;
+        }
+
+        rec_t *old_vers;
+        err= row_vers_build_for_consistent_read(rec, &mtr, index, &offsets,
+                                                view, &rec_heap, rec_heap,
+                                                &old_vers, nullptr);
+        if (err != DB_SUCCESS || !old_vers)
+          continue;
+        rec= old_vers;
+      }
+    }
+
+    if (!rec_get_deleted_flag(rec, comp))
+      err= w->process(rec, offsets);
+  }
+
+  mtr.commit();
+  ut_free(pcur.old_rec_buf);
+  mem_heap_free(rec_heap);
+  return err;
+}
+
+void row_pread_t::work(worker *w)
+{
+  dberr_t err= DB_SUCCESS;
+
+  while (!is_aborted())
+  {
+    const ulint range= next_range++;
+    if (range >= n_ranges())
+    {
+      err= w->finish();
+      break;
+    }
+    err= read_range(w, range);
+    if (err != DB_SUCCESS)
+      break;
+  }
+
+  if (err != DB_SUCCESS)
+    report(err);
+}
+
+void row_pread_t::task_func(void *w)
+{
+  worker *thr= static_cast<worker*>(w);
+  thr->reader->work(thr);
+}
+
+dberr_t row_pread_t::run(worker *const *workers, ulint n_workers)
+{
+  ut_ad(n_workers);
+  ut_ad(n_workers <= n_ranges());
+
+  for (ulint t= 0; t < n_workers; t++)
+  {
+    workers[t]->reader= this;
+    workers[t]->task= t
+      ? new tpool::waitable_task(task_func, workers[t])
+      : nullptr;
+  }
+
+  for (ulint t= 1; t < n_workers; t++)
+    srv_thread_pool->submit_task(workers[t]->task);
+
+  work(workers[0]);
+
+  for (ulint t= 1; t < n_workers; t++)
+  {
+    workers[t]->task->wait();
+    delete workers[t]->task;
+    workers[t]->task= nullptr;
+  }
+
+  return err;
+}
+
+namespace
+{
+/** Counts the records of the key ranges that a thread reads */
+struct row_pread_counter : row_pread_t::worker
+{
+  ulint n_rows= 0;
+
+  dberr_t process(const rec_t*, rec_offs*) override
+  {
+    n_rows++;
+    return DB_SUCCESS;
+  }
+};
+}
+
+dberr_t row_pread_count(trx_t *trx, dict_index_t *index, bool consistent,
+                        ulint n_threads, ulint *n_rows)
+{
+  row_pread_t reader(trx, index, consistent);
+  bool empty;
+
+  *n_rows= 0;
+
+  dberr_t err= reader.split(n_threads, &empty);
+  if (err != DB_SUCCESS || empty)
+    return err;
+
+  const ulint n_thr= std::min(n_threads, reader.n_ranges());
+  row_pread_counter *counters= new row_pread_counter[n_thr];
+  row_pread_t::worker **workers= new row_pread_t::worker*[n_thr];
+
+  for (ulint t= 0; t < n_thr; t++)
+    workers[t]= &counters[t];
+
+  err= reader.run(workers, n_thr);
+
+  for (ulint t= 0; t < n_thr; t++)
+    *n_rows+= counters[t].n_rows;
+
+  delete[] workers;
+  delete[] counters;
+  return err;
+}
@@ -47,6 +47,7 @@ Created 12/19/1997 Heikki Tuuri
 #include "pars0sym.h"
 #include "pars0pars.h"
 #include "row0mysql.h"
+#include "row0pread.h"
 #include "buf0lru.h"
 #include "srv0srv.h"
 #include "srv0mon.h"
@@ -3864,6 +3865,33 @@ row_sel_dequeue_cached_row_for_mysql(
 	}
 }
 
+/** Copy rows that row_search_mvcc() has read ahead into the fetch cache,
+without searching the index again.
+@param[out]	buf		buffer for the rows in MySQL format
+@param[in]	stride		distance of the rows in buf, in bytes
+@param[in]	max_rows	maximum number of rows to copy
+@param[in,out]	prebuilt	prebuilt struct for the table handler
+@return number of rows that were copied */
+ulint
+row_sel_dequeue_cached_rows(
+	byte*		buf,
+	ulint		stride,
+	ulint		max_rows,
+	row_prebuilt_t*	prebuilt)
+{
+	const ulint	n = std::min(max_rows, prebuilt->n_fetch_cached);
+
+	ut_ad(!n || prebuilt->fetch_direction == ROW_SEL_NEXT);
+
+	for (ulint i = 0; i < n; i++) {
+		row_sel_dequeue_cached_row_for_mysql(buf + i * stride,
+						     prebuilt);
+	}
+
+	prebuilt->n_rows_fetched += n;
+	return n;
+}
+
 /********************************************************************//**
 Initialise the prefetch cache. */
 UNIV_INLINE
@@ -3876,11 +3904,20 @@ row_sel_prefetch_cache_init(
 	ulint	sz;
 	byte*	ptr;
 
+	ut_ad(prebuilt->fetch_cache_limit <= UT_ARR_SIZE(prebuilt->fetch_cache));
+
+	if (prebuilt->fetch_cache[0]) {
+		/* The cache is growing. */
+		ut_free(prebuilt->fetch_cache[0] - 4);
+	}
+
+	prebuilt->fetch_cache_size = prebuilt->fetch_cache_limit;
+
 	/* Reserve space for the magic number. */
-	sz = UT_ARR_SIZE(prebuilt->fetch_cache) * (prebuilt->mysql_row_len + 8);
+	sz = prebuilt->fetch_cache_size * (prebuilt->mysql_row_len + 8);
 	ptr = static_cast<byte*>(ut_malloc_nokey(sz));
 
-	for (i = 0; i < UT_ARR_SIZE(prebuilt->fetch_cache); i++) {
+	for (i = 0; i < prebuilt->fetch_cache_size; i++) {
 
 		/* A user has reported memory corruption in these
 		buffers in Linux. Put magic numbers there to help
@@ -3907,9 +3944,9 @@ row_sel_fetch_last_buf(
 	row_prebuilt_t*	prebuilt)	/*!< in/out: prebuilt struct */
 {
 	ut_ad(!prebuilt->templ_contains_blob);
-	ut_ad(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+	ut_ad(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
-	if (prebuilt->fetch_cache[0] == NULL) {
+	if (prebuilt->fetch_cache_size < prebuilt->fetch_cache_limit) {
 		/* Allocate memory for the fetch cache */
 		ut_ad(prebuilt->n_fetch_cached == 0);
 
@@ -4425,6 +4462,7 @@ row_search_mvcc(
 		prebuilt->n_rows_fetched = 0;
 		prebuilt->n_fetch_cached = 0;
 		prebuilt->fetch_cache_first = 0;
+		prebuilt->fetch_cache_limit = MYSQL_FETCH_CACHE_SIZE;
 
 		if (prebuilt->sel_graph == NULL) {
 			/* Build a dummy select query graph */
@@ -5633,12 +5671,9 @@ row_search_mvcc(
 	The latch will not be released until mtr.commit(). */
 
 	if ((match_mode == ROW_SEL_EXACT
+	     || prebuilt->fetch_batch
 	     || prebuilt->n_rows_fetched >= MYSQL_FETCH_CACHE_THRESHOLD)
-	    && prebuilt->select_lock_type == LOCK_NONE
-	    && !prebuilt->templ_contains_blob
-	    && !prebuilt->clust_index_was_generated
-	    && !prebuilt->used_in_HANDLER
-	    && !prebuilt->in_fts_query) {
+	    && prebuilt->can_prefetch()) {
 		/* Inside an update, for example, we do not cache rows,
 		since we may use the cursor position to do the actual
 		update, that is why we require ...lock_type == LOCK_NONE.
@@ -5648,7 +5683,7 @@ row_search_mvcc(
 		not cache rows because there the cursor is a scrollable
 		cursor. */
 
-		ut_a(prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE);
+		ut_a(prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit);
 
 		/* We only convert from InnoDB row format to MySQL row
 		format when ICP is disabled. */
@@ -5700,9 +5735,19 @@ row_search_mvcc(
 			row_sel_enqueue_cache_row_for_mysql(buf, prebuilt);
 		}
 
-		if (prebuilt->n_fetch_cached < MYSQL_FETCH_CACHE_SIZE) {
+		if (prebuilt->n_fetch_cached < prebuilt->fetch_cache_limit) {
 			goto next_rec;
 		}
+
+		/* In ha_innobase::rnd_next_batch(), fetch more rows
+		at a time while the scan continues. */
+		if (prebuilt->fetch_batch
+		    && prebuilt->fetch_cache_limit < MYSQL_FETCH_CACHE_MAX_SIZE
+		    && 2 * prebuilt->fetch_cache_limit
+		    * (prebuilt->mysql_row_len + 8)
+		    <= MYSQL_FETCH_CACHE_MAX_BYTES) {
+			prebuilt->fetch_cache_limit *= 2;
+		}
 	} else {
 		if (!prebuilt->pk_filter && !prebuilt->idx_cond) {
 			/* The record was not yet converted to MySQL format. */
@@ -5946,6 +5991,11 @@ row_search_mvcc(
 
 		DEBUG_SYNC_C("row_search_cached_row");
 		err = DB_SUCCESS;
+
+		if (prebuilt->fetch_batch) {
+			export_vars.innodb_rows_prefetched
+				+= prebuilt->n_fetch_cached;
+		}
 	}
 
 #ifdef UNIV_DEBUG
@@ -6847,3 +6897,93 @@ dberr_t row_check_index(row_prebuilt_t *prebuilt, ulint *n_rows)
 
   goto rec_loop;
 }
+
+namespace
+{
+/** Checks the records of the key ranges that a thread reads
+in row_check_index_parallel() */
+struct row_check_clust_worker : row_pread_t::worker
+{
+  /** the clustered index */
+  dict_index_t *index= nullptr;
+  /** number of records counted */
+  ulint n_rows= 0;
+  /** the problem that was found, or DB_SUCCESS */
+  dberr_t problem= DB_SUCCESS;
+  /** memory heap for prev_entry */
+  mem_heap_t *heap= mem_heap_create(100);
+  /** the preceding record in the key range, or nullptr */
+  const dtuple_t *prev_entry= nullptr;
+
+  ~row_check_clust_worker() { mem_heap_free(heap); }
+
+  dberr_t process(const rec_t *rec, rec_offs *offsets) override
+  {
+    ++n_rows;
+
+    if (prev_entry)
+    {
+      /* The clustered index is unique. */
+      const int cmp= cmp_dtuple_rec(prev_entry, rec, index, offsets);
+      if (cmp >= 0)
+      {
+        if (cmp || problem == DB_SUCCESS)
+          problem= cmp ? DB_INDEX_CORRUPT : DB_DUPLICATE_KEY;
+        ib::error() << (cmp ? "index records in a wrong order in "
+                        : "duplicate key in ")
+                    << index->name << " of table " << index->table->name
+                    << ": " << *prev_entry << ", "
+                    << rec_offsets_print(rec, offsets);
+      }
+    }
+
+    mem_heap_empty(heap);
+    prev_entry= row_rec_to_index_entry(rec, index, offsets, heap);
+    return DB_SUCCESS;
+  }
+
+  void range_done() override { prev_entry= nullptr; }
+};
+}
+
+dberr_t row_check_index_parallel(row_prebuilt_t *prebuilt, ulint n_threads,
+                                 ulint *n_rows)
+{
+  dict_index_t *const index= prebuilt->index;
+  trx_t *const trx= prebuilt->trx;
+  row_pread_t reader(trx, index,
+                     trx->isolation_level != TRX_ISO_READ_UNCOMMITTED);
+  bool empty;
+
+  ut_ad(index->is_primary());
+  ut_ad(!prebuilt->table->is_temporary());
+
+  *n_rows= 0;
+
+  dberr_t err= reader.split(n_threads, &empty);
+  if (err != DB_SUCCESS || empty)
+    return err;
+
+  const ulint n_thr= std::min(n_threads, reader.n_ranges());
+  row_check_clust_worker *checkers= new row_check_clust_worker[n_thr];
+  row_pread_t::worker **workers= new row_pread_t::worker*[n_thr];
+
+  for (ulint t= 0; t < n_thr; t++)
+  {
+    checkers[t].index= index;
+    workers[t]= &checkers[t];
+  }
+
+  err= reader.run(workers, n_thr);
+
+  for (ulint t= 0; t < n_thr; t++)
+  {
+    *n_rows+= checkers[t].n_rows;
+    if (prebuilt->autoinc_error == DB_SUCCESS)
+      prebuilt->autoinc_error= checkers[t].problem;
+  }
+
+  delete[] workers;
+  delete[] checkers;
+  return err;
+}
@@ -504,6 +504,8 @@ row_undo_ins_remove_sec_rec(
 			continue;
 		}
 
+		index->stat_modified_rollback();
+
 		/* An insert undo record TRX_UNDO_INSERT_REC will
 		always contain all fields of the index. It does not
 		matter if any indexes were created afterwards; all
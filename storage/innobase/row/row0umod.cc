@@ -964,6 +964,8 @@ row_undo_mod_upd_del_sec(
 			continue;
 		}
 
+		index->stat_modified_rollback();
+
 		/* During online index creation,
 		HA_ALTER_INPLACE_COPY_NO_LOCK or HA_ALTER_INPLACE_NOCOPY_NO_LOCk
 		should guarantee that any active transaction has not modified
@@ -1028,6 +1030,8 @@ row_undo_mod_del_mark_sec(
 			continue;
 		}
 
+		index->stat_modified_rollback();
+
 		/* During online index creation,
 		HA_ALTER_INPLACE_COPY_NO_LOCK or HA_ALTER_INPLACE_NOCOPY_NO_LOCK
 		should guarantee that any active transaction has not modified
@@ -1102,6 +1106,8 @@ row_undo_mod_upd_exist_sec(
 			continue;
 		}
 
+		index->stat_modified_rollback();
+
 		/* Build the newest version of the index entry */
 		dtuple_t* entry = row_build_index_entry(
 			node->row, node->ext, index, heap);
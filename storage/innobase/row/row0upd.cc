@@ -1841,6 +1841,9 @@ row_upd_sec_index_entry(
 	if index->is_committed(). */
 	ut_ad(!dict_index_is_online_ddl(index));
 
+	/* We do not care about the race condition here. */
+	index->stat_modified_counter++;
+
 	const bool referenced = row_upd_index_is_referenced(index, mtr.trx);
 #ifdef WITH_WSREP
 	const bool foreign = wsrep_row_upd_index_is_foreign(index, mtr.trx);
@@ -44,12 +44,14 @@ Created 10/8/1995 Heikki Tuuri
 #include "mysql/psi/psi.h"
 
 #include "btr0sea.h"
+#include "buf0dump.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
 #include "dict0boot.h"
 #include "dict0load.h"
 #include "lock0lock.h"
 #include "log0recv.h"
+#include "log0arch.h"
 #include "mem0mem.h"
 #include "pars0pars.h"
 #include "que0que.h"
@@ -148,6 +150,12 @@ ulong	innodb_compression_algorithm;
 
 /*------------------------- LOG FILES ------------------------ */
 char*	srv_log_group_home_dir;
+/** innodb_log_archive_dir */
+char*	srv_log_archive_dir;
+/** innodb_log_archive_recovery_lsn */
+ulonglong	srv_log_archive_recovery_lsn;
+/** innodb_log_archive_retry_limit */
+uint	srv_log_archive_retry_limit;
 
 /** The InnoDB redo log file size, or 0 when changing the redo log format
 at startup (while disallowing writes to the redo log). */
@@ -204,6 +212,8 @@ my_bool	srv_random_read_ahead;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong	srv_read_ahead_threshold;
+/** innodb_read_ahead_logical */
+ulong	srv_read_ahead_logical;
 
 /** copy of innodb_open_files; @see innodb_init_params() */
 ulint	srv_max_n_open_files;
@@ -236,6 +246,8 @@ uint srv_n_purge_threads;
 
 /** innodb_purge_batch_size, in pages */
 ulong	srv_purge_batch_size;
+/** innodb_purge_batch_size_adaptive */
+my_bool	srv_purge_batch_size_adaptive;
 
 /** innodb_stats_method decides how InnoDB treats
 NULL value when collecting statistics. By default, it is set to
@@ -284,6 +296,9 @@ my_bool		srv_stats_persistent;
 my_bool		srv_stats_include_delete_marked;
 /** innodb_stats_persistent_sample_pages */
 uint32_t	srv_stats_persistent_sample_pages;
+/** innodb_stats_persistent_threads: number of indexes of a table
+that can be analyzed concurrently */
+uint		srv_stats_persistent_threads;
 /** innodb_stats_auto_recalc */
 my_bool		srv_stats_auto_recalc;
 
@@ -469,6 +484,8 @@ char*	srv_buf_dump_filename;
 and/or load it during startup. */
 char	srv_buffer_pool_dump_at_shutdown = TRUE;
 char	srv_buffer_pool_load_at_startup = TRUE;
+/** innodb_buffer_pool_dump_interval */
+ulong	srv_buf_dump_interval;
 
 #ifdef HAVE_PSI_STAGE_INTERFACE
 /** Performance schema stage event for monitoring ALTER TABLE progress
@@ -958,6 +975,8 @@ srv_export_innodb_status(void)
 	log_sys.latch.wr_unlock();
 	export_vars.innodb_os_log_written = export_vars.innodb_lsn_current
 		- recv_sys.lsn;
+	export_vars.innodb_lsn_archived = log_archive_lsn();
+	export_vars.innodb_log_archive_status = log_archive_status();
 
 	export_vars.innodb_checkpoint_age = static_cast<ulint>(
 		export_vars.innodb_lsn_current
@@ -1298,6 +1317,8 @@ void srv_master_callback(void*)
   else
     srv_master_do_idle_tasks(counter_time);
 
+  buf_dump_periodic();
+
   srv_main_thread_op_info= "sleeping";
 }
 
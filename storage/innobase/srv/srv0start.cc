@@ -53,6 +53,7 @@ Created 2/16/1996 Heikki Tuuri
 #include "fsp0fsp.h"
 #include "rem0rec.h"
 #include "mtr0mtr.h"
+#include "log0arch.h"
 #include "log0crypt.h"
 #include "log0recv.h"
 #include "page0page.h"
@@ -237,6 +238,10 @@ static dberr_t create_log_file(bool create_new_db, lsn_t lsn)
 	ut_d(recv_no_log_write = false);
 	log_sys.create(lsn);
 
+	if (log_archive_init(lsn, true) != DB_SUCCESS) {
+		goto err_exit;
+	}
+
 	ut_ad(srv_startup_is_before_trx_rollback_phase);
 	if (create_new_db) {
 		srv_startup_is_before_trx_rollback_phase = false;
@@ -1188,6 +1193,9 @@ ATTRIBUTE_COLD static dberr_t srv_log_rebuild()
   this assumption does not hold. */
   ut_d(os_aio_wait_until_no_pending_writes(false));
 
+  /* Archive the old log before replacing it */
+  log_archive_sync();
+
   /* Close the redo log file, so that we can replace it */
   log_sys.close_file();
 
@@ -1595,6 +1603,8 @@ dberr_t srv_start(bool create_new_db)
 		if (log_sys.resize_rename()) {
 			return(srv_init_abort(DB_ERROR));
 		}
+
+		log_archive_start();
 	} else {
 		/* Suppress warnings in fil_space_t::create() for files
 		that are being read before dict_boot() has recovered
@@ -1708,12 +1718,19 @@ dberr_t srv_start(bool create_new_db)
 		generating any dirty pages, so that the old redo log
 		file will not be written to. */
 
-		err = srv_log_rebuild_if_needed();
+		err = log_archive_init(log_sys.last_checkpoint_lsn, false);
+
+		if (err == DB_SUCCESS) {
+			err = srv_log_rebuild_if_needed();
+		}
 
 		if (err != DB_SUCCESS) {
 			return srv_init_abort(err);
 		}
 
+		log_archive_restored();
+		log_archive_start();
+
 		recv_sys.debug_free();
 
 		if (!srv_read_only_mode) {
@@ -2146,6 +2163,7 @@ void innodb_shutdown()
 		btr_search.disable();
 	}
 #endif /* BTR_CUR_HASH_ADAPT */
+	log_archive_close();
 	log_sys.close();
 	purge_sys.close();
 	trx_sys.close();
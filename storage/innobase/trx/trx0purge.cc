@@ -1204,19 +1204,102 @@ dict_table_t *purge_sys_t::close_and_reopen(table_id_t id, THD *thd,
   return table;
 }
 
+/** Determine if the undo log records of a table may be processed by
+multiple purge tasks, distributed by the first PRIMARY KEY column.
+@param table  table that was opened for purge, or nullptr
+@return whether the records may be partitioned */
+static bool trx_purge_can_partition(const dict_table_t *table) noexcept
+{
+  if (!table || table->fts)
+    return false;
+  /* The records of a row must be processed in order by a single task.
+  Only if equal values of the column are also equal byte by byte, all
+  records of a row will be assigned to the same task. */
+  switch (dict_table_get_first_index(table)->fields[0].col->mtype) {
+  case DATA_INT:
+  case DATA_SYS:
+  case DATA_FIXBINARY:
+  case DATA_BINARY:
+    return true;
+  }
+  return false;
+}
+
+/** Determine the partition of an undo log record.
+@param undo_rec      undo log record
+@param n_partitions  number of partitions
+@return partition number, between 0 and n_partitions - 1 */
+static ulint trx_purge_rec_partition(const trx_undo_rec_t *undo_rec,
+                                     ulint n_partitions) noexcept
+{
+  byte type, cmpl_info;
+  bool updated_extern;
+  undo_no_t undo_no;
+  table_id_t table_id;
+  const byte *ptr= trx_undo_rec_get_pars(undo_rec, &type, &cmpl_info,
+                                         &updated_extern, &undo_no,
+                                         &table_id);
+  switch (type) {
+  case TRX_UNDO_INSERT_REC:
+    break;
+  case TRX_UNDO_UPD_EXIST_REC:
+  case TRX_UNDO_UPD_DEL_REC:
+  case TRX_UNDO_DEL_MARK_REC:
+    trx_id_t trx_id;
+    roll_ptr_t roll_ptr;
+    byte info_bits;
+    ptr= trx_undo_update_rec_get_sys_cols(ptr, &trx_id, &roll_ptr,
+                                          &info_bits);
+    if (info_bits & REC_INFO_MIN_REC_FLAG)
+      return 0;
+    break;
+  default:
+    /* TRX_UNDO_EMPTY, TRX_UNDO_INSERT_METADATA, TRX_UNDO_RENAME_TABLE
+    are not associated with any row. */
+    return 0;
+  }
+
+  const byte *field;
+  uint32_t len, orig_len;
+  trx_undo_rec_get_col_val(ptr, &field, &len, &orig_len);
+  if (len == UNIV_SQL_NULL || len >= UNIV_EXTERN_STORAGE_FIELD)
+    return 0;
+  return my_crc32c(0, field, len) % n_partitions;
+}
+
 /** Run a purge batch.
-@param n_work_items     number of work items (currently tables) to process
+@param trx              dummy transaction of the purge coordinator
+@param n_tasks          number of purge tasks
+@param batch_size       maximum number of undo log pages to process
+@param n_work_items     number of work items (table partitions) to process
 @return new purge_sys.head */
 static purge_sys_t::iterator
-trx_purge_attach_undo_recs(trx_t *trx, ulint *n_work_items) noexcept
+trx_purge_attach_undo_recs(trx_t *trx, ulint n_tasks, ulint batch_size,
+                           ulint *n_work_items) noexcept
 {
   que_thr_t *thr= nullptr;
   purge_sys_t::iterator head= purge_sys.tail;
 
   /* Fetch and parse the UNDO records. The UNDO records are added
-  to a per purge node vector. */
+  to a per purge node vector. The records of a table whose first
+  PRIMARY KEY column allows it will be distributed to up to
+  n_partitions nodes, so that a frequently modified table can be
+  purged by multiple tasks. Any task that runs out of work will
+  pick the next node from the queue. */
+
+  const ulint n_partitions= n_tasks > 1
+    ? std::min<ulint>(2 * n_tasks, innodb_purge_threads_MAX) : 1;
 
-  std::unordered_map<table_id_t, purge_node_t *>
+  /** The purge nodes of a table */
+  struct table_nodes
+  {
+    /** whether the records of the table are partitioned */
+    bool partitioned;
+    /** the nodes of each partition */
+    purge_node_t *nodes[innodb_purge_threads_MAX];
+  };
+
+  std::unordered_map<table_id_t, table_nodes>
     table_id_map(TRX_PURGE_TABLE_BUCKETS);
   purge_sys.m_active= true;
 
@@ -1242,36 +1325,57 @@ trx_purge_attach_undo_recs(trx_t *trx, ulint *n_work_items) noexcept
 
     table_id_t table_id= trx_undo_rec_get_table_id(purge_rec.undo_rec);
 
-    purge_node_t *&table_node= table_id_map[table_id];
-    if (table_node)
-      ut_ad(!table_node->in_progress);
-    if (!table_node)
+    const auto t= table_id_map.try_emplace(table_id);
+    table_nodes &tn= t.first->second;
+    purge_node_t **table_node= &tn.nodes[0];
+    if (tn.partitioned)
+      table_node+= trx_purge_rec_partition(purge_rec.undo_rec, n_partitions);
+    if (*table_node)
+      ut_ad(!(*table_node)->in_progress);
+    else
     {
-      std::pair<dict_table_t *, MDL_ticket *> p;
-      p.first= trx_purge_table_open(table_id, &thd->mdl_context, &p.second);
-      if (p.first == reinterpret_cast<dict_table_t *>(-1))
-        p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
-
       if (!thr || !(thr= UT_LIST_GET_NEXT(thrs, thr)))
         thr= UT_LIST_GET_FIRST(purge_sys.query->thrs);
-      ++*n_work_items;
-      table_node= static_cast<purge_node_t *>(thr->child);
-
-      ut_a(que_node_get_type(table_node) == QUE_NODE_PURGE);
-      ut_d(auto pair=) table_node->tables.emplace(table_id, p);
-      ut_ad(pair.second);
-      if (p.first)
-        goto enqueue;
+      *table_node= static_cast<purge_node_t *>(thr->child);
+      ut_a(que_node_get_type(*table_node) == QUE_NODE_PURGE);
+
+      /* If the nodes wrapped around, another partition of the table
+      may already have been assigned to this node. */
+      if (!(*table_node)->tables.count(table_id))
+      {
+        std::pair<dict_table_t *, MDL_ticket *> p;
+        p.first= trx_purge_table_open(table_id, &thd->mdl_context,
+                                      &p.second);
+        if (p.first == reinterpret_cast<dict_table_t *>(-1))
+          p.first= purge_sys.close_and_reopen(table_id, thd, &p.second);
+
+        ++*n_work_items;
+        (*table_node)->tables.emplace(table_id, p);
+
+        if (t.second && n_partitions > 1 &&
+            trx_purge_can_partition(p.first))
+        {
+          tn.partitioned= true;
+          ulint part= trx_purge_rec_partition(purge_rec.undo_rec,
+                                              n_partitions);
+          if (part)
+          {
+            tn.nodes[part]= tn.nodes[0];
+            tn.nodes[0]= nullptr;
+            table_node= &tn.nodes[part];
+          }
+        }
+      }
     }
-    else if (table_node->tables[table_id].first)
+
+    if ((*table_node)->tables[table_id].first)
     {
-    enqueue:
-      table_node->undo_recs.push(purge_rec);
-      ut_ad(!table_node->in_progress);
+      (*table_node)->undo_recs.push(purge_rec);
+      ut_ad(!(*table_node)->in_progress);
     }
 
     const size_t size{purge_sys.n_pages_handled()};
-    if (size >= size_t{srv_purge_batch_size} ||
+    if (size >= batch_size ||
         size >= buf_pool.usable_size() * 3 / 4)
       break;
   }
@@ -1361,7 +1465,15 @@ ulint trx_purge(trx_t *trx, ulint n_tasks, ulint history_size) noexcept
   /* Fetch the UNDO recs that need to be purged. */
   ulint n_work= 0;
   THD *const thd{trx->mysql_thd};
-  const purge_sys_t::iterator head= trx_purge_attach_undo_recs(trx, &n_work);
+  /* With innodb_purge_batch_size_adaptive, process larger batches
+  while the history is long, so that the purge tasks can catch up. */
+  const ulint batch_size= srv_purge_batch_size_adaptive
+    ? std::min<ulint>(std::max<ulint>(history_size / 32,
+                                      srv_purge_batch_size),
+                      innodb_purge_batch_size_MAX)
+    : srv_purge_batch_size;
+  const purge_sys_t::iterator head=
+    trx_purge_attach_undo_recs(trx, n_tasks, batch_size, &n_work);
   const size_t n_pages= purge_sys.n_pages_handled();
 
   {
@@ -168,6 +168,9 @@ void trx_sys_t::create()
   m_initialised= true;
   trx_list.create();
   rw_trx_hash.init();
+  m_rw_trx_hash_epoch.store(0, std::memory_order_relaxed);
+  m_snapshot.store(nullptr, std::memory_order_relaxed);
+  m_snapshots.store(nullptr, std::memory_order_relaxed);
   for (auto &rseg : temp_rsegs)
     rseg.init(nullptr, FIL_NULL);
   for (auto &rseg : rseg_array)
@@ -362,6 +365,13 @@ trx_sys_t::close()
 
 	rw_trx_hash.destroy();
 
+	m_snapshot.store(nullptr, std::memory_order_relaxed);
+	for (ReadViewSnapshot* s = m_snapshots.exchange(nullptr); s; ) {
+		ReadViewSnapshot* next = s->next;
+		UT_DELETE(s);
+		s = next;
+	}
+
 	/* There can't be any active transactions. */
 	for (auto& rseg : temp_rsegs) rseg.destroy();
 	for (auto& rseg : rseg_array) rseg.destroy();
@@ -394,6 +394,8 @@ void trx_t::free()
 
   dict_operation= false;
   trx_sys.deregister_trx(this);
+  /* The purge coordinator can no longer access read_view. */
+  read_view.release_snapshot();
   check_unique_secondary= true;
   check_foreigns= true;
   assert_freed();
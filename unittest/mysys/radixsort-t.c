@@ -0,0 +1,150 @@
+/* Copyright (c) 2026, MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1335  USA */
+
+/*
+  Checks the radix sorts for string pointers against my_qsort2() and
+  prints how long each of them takes, as filesort would call them.
+  Run with any argument to sort bigger arrays.
+*/
+
+#include <my_global.h>
+#include <my_sys.h>
+#include <my_rnd.h>
+#include <myisampack.h>
+#include "tap.h"
+
+#define rnd(R) ((uint)(my_rnd(R) * INT_MAX32))
+
+enum key_kind { KEY_INT, KEY_FEW_INTS, KEY_DATETIME, KEY_STRING, KEY_KINDS };
+
+static const char *kind_names[]=
+{ "int", "int, 100 values", "datetime", "varchar(16)" };
+
+static const size_t kind_lengths[]= { 4, 4, 8, 16 };
+
+struct my_rnd_struct rand_st;
+
+static void fill_key(enum key_kind kind, uchar *key)
+{
+  uint i;
+  switch (kind) {
+  case KEY_INT:
+    mi_int4store(key, rnd(&rand_st));
+    break;
+  case KEY_FEW_INTS:
+    mi_int4store(key, rnd(&rand_st) % 100);
+    break;
+  case KEY_DATETIME:
+    /* A year of seconds from 2026 */
+    mi_int8store(key, 20260000000000ULL + rnd(&rand_st) % 31536000);
+    break;
+  case KEY_STRING:
+    /* Common prefix and padding, like weights of short strings */
+    memcpy(key, "user_", 5);
+    for (i= 5; i < 11; i++)
+      key[i]= 'a' + rnd(&rand_st) % 26;
+    memset(key + 11, ' ', 5);
+    break;
+  default:
+    DBUG_ASSERT(0);
+  }
+}
+
+
+static ulonglong time_sort(uchar **keys, uchar **sorted, uint n,
+                           size_t length, uchar **buffer, int algorithm)
+{
+  ulonglong start;
+  memcpy(sorted, keys, n * sizeof(uchar*));
+  start= my_interval_timer();
+  switch (algorithm) {
+  case 0:
+    my_qsort2(sorted, n, sizeof(uchar*), get_ptr_compare(length), &length);
+    break;
+  case 1:
+    radixsort_for_str_ptr(sorted, n, length, buffer);
+    break;
+  case 2:
+    msd_radixsort_for_str_ptr(sorted, n, length, buffer);
+    break;
+  }
+  return (my_interval_timer() - start) / 1000;
+}
+
+
+static my_bool same_order(uchar **a, uchar **b, uint n, size_t length)
+{
+  uint i;
+  for (i= 0; i < n; i++)
+    if (memcmp(a[i], b[i], length))
+      return 0;
+  return 1;
+}
+
+
+int main(int argc, char **argv)
+{
+  static const uint small_sizes[]= { 1000, 20000, 200000 };
+  static const uint big_sizes[]= { 1000, 50000, 1000000, 5000000 };
+  const uint *sizes= argc > 1 ? big_sizes : small_sizes;
+  uint n_sizes= argc > 1 ? array_elements(big_sizes) :
+                           array_elements(small_sizes);
+  uint max_n= sizes[n_sizes - 1];
+  uchar *data, **keys, **expected, **sorted, **buffer;
+  enum key_kind kind;
+  uint i, s;
+
+  MY_INIT(argv[0]);
+  plan(KEY_KINDS * n_sizes * 2);
+  my_rnd_init(&rand_st, 17, 42);
+
+  data= (uchar*) my_malloc(PSI_NOT_INSTRUMENTED, (size_t) max_n * 16,
+                           MYF(MY_FAE));
+  keys= (uchar**) my_malloc(PSI_NOT_INSTRUMENTED,
+                            (size_t) max_n * sizeof(uchar*) * 4, MYF(MY_FAE));
+  expected= keys + max_n;
+  sorted= expected + max_n;
+  buffer= sorted + max_n;
+
+  for (kind= 0; kind < KEY_KINDS; kind++)
+  {
+    size_t length= kind_lengths[kind];
+    for (s= 0; s < n_sizes; s++)
+    {
+      uint n= sizes[s];
+      ulonglong qsort_us, lsd_us, msd_us;
+      for (i= 0; i < n; i++)
+      {
+        keys[i]= data + (size_t) i * length;
+        fill_key(kind, keys[i]);
+      }
+
+      qsort_us= time_sort(keys, expected, n, length, buffer, 0);
+      lsd_us= time_sort(keys, sorted, n, length, buffer, 1);
+      ok(same_order(expected, sorted, n, length),
+         "LSD radixsort of %u %s keys", n, kind_names[kind]);
+      msd_us= time_sort(keys, sorted, n, length, buffer, 2);
+      ok(same_order(expected, sorted, n, length),
+         "MSD radixsort of %u %s keys", n, kind_names[kind]);
+      diag("%7u %-16s my_qsort2 %7llu us  LSD %7llu us  MSD %7llu us",
+           n, kind_names[kind], qsort_us, lsd_us, msd_us);
+    }
+  }
+
+  my_free(keys);
+  my_free(data);
+  my_end(0);
+  return exit_status();
+}